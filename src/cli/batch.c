@@ -0,0 +1,329 @@
+/*
+ *   ----------------------------
+ *  |  batch.c
+ *   ----------------------------
+ *   This file is part of BiosReader.
+ *
+ *   BiosReader is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   BiosReader is distributed in the hope and belief that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with BiosReader.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * BiosReaderBatch, decodes the SMBIOS dumps collected from a fleet of machines
+ *
+ *   BiosReaderBatch [-j threads] <dump | directory | @list> ...
+ *
+ * Directories are taken file by file (not recursively, in name order), lists hold a path per line.
+ * A line per dump goes to stdout, in the order the dumps were given, and the throughput to stderr.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(BR_WINDOWS_PLATFORM)
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
+#include "dmibatch.h"
+
+struct path_list
+{
+	char** paths;
+	size_t count;
+	size_t capacity;
+};
+
+static int add_path(struct path_list* list, const char* path)
+{
+	if (list->count == list->capacity)
+	{
+		size_t capacity = list->capacity ? list->capacity * 2 : 256;
+		char** paths = realloc(list->paths, capacity * sizeof(char*));
+
+		if (paths == NULL)
+		{
+			return -1;
+		}
+
+		list->paths = paths;
+		list->capacity = capacity;
+	}
+
+	list->paths[list->count] = malloc(strlen(path) + 1);
+	if (list->paths[list->count] == NULL)
+	{
+		return -1;
+	}
+
+	strcpy(list->paths[list->count], path);
+	list->count++;
+
+	return 0;
+}
+
+static int compare_paths(const void* a, const void* b)
+{
+	return strcmp(*(char* const*)a, *(char* const*)b);
+}
+
+/*
+ * Every regular file in the directory, sorted so that the output doesn't depend on the file system
+ */
+static int add_directory(struct path_list* list, const char* directory)
+{
+	size_t first = list->count;
+	char path[4096];
+
+#if defined(BR_WINDOWS_PLATFORM)
+	WIN32_FIND_DATAA entry;
+	HANDLE search;
+
+	snprintf(path, sizeof(path), "%s\\*", directory);
+	search = FindFirstFileA(path, &entry);
+	if (search == INVALID_HANDLE_VALUE)
+	{
+		return -1;
+	}
+
+	do
+	{
+		if (!(entry.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+		{
+			snprintf(path, sizeof(path), "%s\\%s", directory, entry.cFileName);
+			if (add_path(list, path) != 0)
+			{
+				FindClose(search);
+				return -1;
+			}
+		}
+	} while (FindNextFileA(search, &entry));
+
+	FindClose(search);
+#else
+	DIR* stream = opendir(directory);
+	struct dirent* entry;
+	struct stat statistics;
+
+	if (stream == NULL)
+	{
+		return -1;
+	}
+
+	while ((entry = readdir(stream)) != NULL)
+	{
+		snprintf(path, sizeof(path), "%s/%s", directory, entry->d_name);
+
+		if (stat(path, &statistics) == 0 && S_ISREG(statistics.st_mode))
+		{
+			if (add_path(list, path) != 0)
+			{
+				closedir(stream);
+				return -1;
+			}
+		}
+	}
+
+	closedir(stream);
+#endif
+
+	qsort(list->paths + first, list->count - first, sizeof(char*), compare_paths);
+
+	return 0;
+}
+
+static int add_list_file(struct path_list* list, const char* listFile)
+{
+	char line[4096];
+	FILE* stream = fopen(listFile, "r");
+
+	if (stream == NULL)
+	{
+		return -1;
+	}
+
+	while (fgets(line, sizeof(line), stream) != NULL)
+	{
+		line[strcspn(line, "\r\n")] = '\0';
+
+		if (line[0] != '\0' && add_path(list, line) != 0)
+		{
+			fclose(stream);
+			return -1;
+		}
+	}
+
+	fclose(stream);
+
+	return 0;
+}
+
+static int is_directory(const char* path)
+{
+#if defined(BR_WINDOWS_PLATFORM)
+	DWORD attributes = GetFileAttributesA(path);
+
+	return attributes != INVALID_FILE_ATTRIBUTES && (attributes & FILE_ATTRIBUTE_DIRECTORY);
+#else
+	struct stat statistics;
+
+	return stat(path, &statistics) == 0 && S_ISDIR(statistics.st_mode);
+#endif
+}
+
+static void print_result(const struct br_batch_result* result, void* userdata)
+{
+	FILE* stream = userdata;
+
+	if (!result->bDecoded)
+	{
+		fprintf(stream, "%s: no SMBIOS table\n", result->path);
+		return;
+	}
+
+	fprintf(stream, "%s: SMBIOS %u.%u, %u structures, %u bytes | %s %s %s | %s | %u memory devices, %s\n",
+		result->path,
+		result->smbiosversion >> 8, result->smbiosversion & 0xFF,
+		result->structurecount, result->tablelength,
+		result->biosvendor, result->biosversion, result->biosreleasedate,
+		result->processor[0] ? result->processor : "Unknown processor",
+		result->memorydevices, result->systemmemory[0] ? result->systemmemory : "Unknown");
+}
+
+static void usage(FILE* stream, const char* program)
+{
+	fprintf(stream, "Usage: %s [-j threads] [--] <dump | directory | @list> ...\n", program);
+}
+
+/*
+ * The options, all of them looked at before any path is queued. -1 if they are fine, the exit status otherwise
+ */
+static int parse_options(int argc, char** argv, unsigned int* threads)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--") == 0)
+		{
+			break;
+		}
+
+		if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0)
+		{
+			usage(stdout, argv[0]);
+			return 0;
+		}
+
+		if (strcmp(argv[i], "-j") == 0)
+		{
+			if (i + 1 == argc)
+			{
+				fprintf(stderr, "%s: -j wants a number of threads\n", argv[0]);
+				usage(stderr, argv[0]);
+				return 2;
+			}
+
+			*threads = (unsigned int)strtoul(argv[++i], NULL, 10);
+			continue;
+		}
+
+		// "-" alone is a path as good as any
+		if (argv[i][0] == '-' && argv[i][1] != '\0')
+		{
+			fprintf(stderr, "%s: unknown option %s\n", argv[0], argv[i]);
+			usage(stderr, argv[0]);
+			return 2;
+		}
+	}
+
+	return -1;
+}
+
+int main(int argc, char** argv)
+{
+	struct path_list list = { NULL, 0, 0 };
+	struct br_batch_statistics statistics;
+	unsigned int threads = 0;
+	int status = parse_options(argc, argv, &threads);
+	int bOptionsOver = 0;
+
+	if (status != -1)
+	{
+		return status;
+	}
+
+	status = 0;
+
+	for (int i = 1; i < argc; i++)
+	{
+		int bFailed;
+
+		if (!bOptionsOver && strcmp(argv[i], "--") == 0)
+		{
+			bOptionsOver = 1;
+			continue;
+		}
+
+		// Taken care of by parse_options()
+		if (!bOptionsOver && strcmp(argv[i], "-j") == 0)
+		{
+			i++;
+			continue;
+		}
+
+		if (argv[i][0] == '@')
+		{
+			bFailed = add_list_file(&list, argv[i] + 1);
+		}
+		else if (is_directory(argv[i]))
+		{
+			bFailed = add_directory(&list, argv[i]);
+		}
+		else
+		{
+			bFailed = add_path(&list, argv[i]);
+		}
+
+		if (bFailed)
+		{
+			fprintf(stderr, "%s: can't be listed\n", argv[i]);
+			status = 1;
+		}
+	}
+
+	if (list.count == 0)
+	{
+		usage(stderr, argv[0]);
+		return status ? status : 2;
+	}
+
+	if (br_batch_decode((const char* const*)list.paths, list.count, threads, print_result, stdout, &statistics) != 0)
+	{
+		fprintf(stderr, "Out of memory\n");
+		return 1;
+	}
+
+	fprintf(stderr, "%zu dumps (%zu decoded) in %.3f s on %u threads, %.0f dumps/s, %zu stolen\n",
+		statistics.dumps, statistics.decoded, statistics.seconds, statistics.threads,
+		statistics.dumpspersecond, statistics.steals);
+
+	for (size_t i = 0; i < list.count; i++)
+	{
+		free(list.paths[i]);
+	}
+	free(list.paths);
+
+	return status != 0 || statistics.decoded != statistics.dumps;
+}
@@ -0,0 +1,75 @@
+/*
+ *   ----------------------------
+ *  |  gpugl.c
+ *   ----------------------------
+ *   This file is part of BiosReader.
+ *
+ *   BiosReader is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   BiosReader is distributed in the hope and belief that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with BiosReader.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * The optional GL module. Built as a loadable module (BiosReaderGL) and opened by
+ * BiosReader only when a graphics card query can't be answered otherwise, so that
+ * processes after SMBIOS data alone never map libGL.
+ */
+
+#include <stdio.h>
+
+#define GL_GLEXT_PROTOTYPES
+#include "gladtheloader.h"
+
+#include "gpumodule.h"
+
+#if defined(_WIN32)
+#define BR_GPU_MODULE_EXPORT __declspec(dllexport)
+#else
+#define BR_GPU_MODULE_EXPORT __attribute__((visibility("default")))
+#endif
+
+BR_GPU_MODULE_EXPORT int br_gpu_module_probe(struct gpu_module_device* device)
+{
+	// With the hope of SMBIOS reading GPU specs one day, sayeth the turtle, I shall
+	// be gald to add yet another clause in the switch. Till then let glad(ness) (the library)
+	// be the vessel for gpu identification, alongwith glfw.
+
+	int resultA = imgl3wInit();// with compliments from Dear ImGui
+	if (resultA != 0)
+	{
+		printf("Failed to initialize GLAD");
+		return -1;
+	}
+
+	// This method works for OpenGL renderer not for Vulkan.
+	// Shall work on some day based on mood!!
+#define GL_GPU_MEM_INFO_TOTAL_AVAILABLE_MEM_NVX 0x9048
+	//#define GL_GPU_MEM_INFO_CURRENT_AVAILABLE_MEM_NVX 0x9049
+
+	// No current context, no strings
+	const char* glVendor = (const char*)glGetString(GL_VENDOR);
+	const char* glRenderer = (const char*)glGetString(GL_RENDERER);
+
+	if (glVendor == NULL || glRenderer == NULL)
+	{
+		return -1;
+	}
+
+	GLint total_mem_kb = 0;
+	glGetIntegerv(GL_GPU_MEM_INFO_TOTAL_AVAILABLE_MEM_NVX, &total_mem_kb);
+
+	snprintf(device->vendor, sizeof(device->vendor), "%s", glVendor);
+	snprintf(device->renderer, sizeof(device->renderer), "%s", glRenderer);
+	device->videomemorymb = total_mem_kb / 1000;
+
+	return 0;
+}
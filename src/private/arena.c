@@ -0,0 +1,154 @@
+/*
+ *   ----------------------------
+ *  |  arena.c
+ *   ----------------------------
+ *   This file is part of BiosReader.
+ *
+ *   BiosReader is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   BiosReader is distributed in the hope and belief that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with BiosReader.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "arena.h"
+
+// Good enough for a whole decode of a regular desktop in one go
+#define BR_ARENA_FIRST_BLOCK_SIZE 4096
+
+// Everything is handed out aligned for any of the structs we keep
+#define BR_ARENA_ALIGNMENT 16
+
+static size_t br_arena_align(size_t size)
+{
+	return (size + BR_ARENA_ALIGNMENT - 1) & ~(size_t)(BR_ARENA_ALIGNMENT - 1);
+}
+
+static unsigned char* br_arena_block_data(struct br_arena_block* block)
+{
+	return (unsigned char*)block + br_arena_align(sizeof(struct br_arena_block));
+}
+
+/*
+ *************************************************************************************************
+ *
+ * Hand out size bytes from the arena, adding a block (twice as big as the last one, or just
+ * big enough) when none of the remaining ones has room
+ *
+ * @param arena         The arena to allocate from. Zero initialize before first use
+ * @param size          Bytes needed
+ * @return void*        The memory, NULL if the heap says no
+ *
+ *************************************************************************************************
+ */
+
+void* br_arena_alloc(struct br_arena* arena, size_t size)
+{
+	struct br_arena_block* block = arena->current;
+	struct br_arena_block* last = NULL;
+	size_t blockSize;
+	void* memory;
+
+	size = br_arena_align(size ? size : 1);
+
+	// Blocks left over from before the last reset come first
+	while (block != NULL && block->size - block->used < size)
+	{
+		last = block;
+		block = block->next;
+	}
+
+	if (block == NULL)
+	{
+		blockSize = last ? last->size * 2 : BR_ARENA_FIRST_BLOCK_SIZE;
+		if (blockSize < size)
+		{
+			blockSize = size;
+		}
+
+		block = malloc(br_arena_align(sizeof(struct br_arena_block)) + blockSize);
+		if (block == NULL)
+		{
+			perror("malloc");
+			return NULL;
+		}
+
+		block->next = NULL;
+		block->size = blockSize;
+		block->used = 0;
+
+		if (last != NULL)
+		{
+			last->next = block;
+		}
+		else
+		{
+			arena->head = block;
+		}
+	}
+
+	arena->current = block;
+
+	memory = br_arena_block_data(block) + block->used;
+	block->used += size;
+
+	return memory;
+}
+
+char* br_arena_strdup(struct br_arena* arena, const char* source)
+{
+	size_t sourceSize = strlen(source) + 1;
+	char* destination = br_arena_alloc(arena, sourceSize);
+
+	if (destination != NULL)
+	{
+		memcpy(destination, source, sourceSize);
+	}
+
+	return destination;
+}
+
+/*
+ * Everything handed out so far is gone in one go. Blocks are kept for reuse.
+ */
+void br_arena_reset(struct br_arena* arena)
+{
+	struct br_arena_block* block;
+
+	for (block = arena->head; block != NULL; block = block->next)
+	{
+		block->used = 0;
+	}
+
+	arena->current = arena->head;
+}
+
+/*
+ * Same as above, only the blocks go back to the heap as well
+ */
+void br_arena_release(struct br_arena* arena)
+{
+	struct br_arena_block* block = arena->head;
+
+	while (block != NULL)
+	{
+		struct br_arena_block* next = block->next;
+
+		free(block);
+		block = next;
+	}
+
+	arena->head = NULL;
+	arena->current = NULL;
+}
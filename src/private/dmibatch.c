@@ -0,0 +1,464 @@
+/*
+ *   ----------------------------
+ *  |  dmibatch.c
+ *   ----------------------------
+ *   This file is part of BiosReader.
+ *
+ *   BiosReader is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   BiosReader is distributed in the hope and belief that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with BiosReader.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(BR_WINDOWS_PLATFORM)
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#include "dmibatch.h"
+#include "brcontext.h"
+
+/*
+ * Just enough of threads for the pool, the Windows way or the POSIX way
+ */
+#if defined(BR_WINDOWS_PLATFORM)
+typedef CRITICAL_SECTION batch_mutex;
+typedef HANDLE batch_thread;
+
+static void batch_mutex_init(batch_mutex* mutex) { InitializeCriticalSection(mutex); }
+static void batch_mutex_destroy(batch_mutex* mutex) { DeleteCriticalSection(mutex); }
+static void batch_mutex_lock(batch_mutex* mutex) { EnterCriticalSection(mutex); }
+static void batch_mutex_unlock(batch_mutex* mutex) { LeaveCriticalSection(mutex); }
+#else
+typedef pthread_mutex_t batch_mutex;
+typedef pthread_t batch_thread;
+
+static void batch_mutex_init(batch_mutex* mutex) { pthread_mutex_init(mutex, NULL); }
+static void batch_mutex_destroy(batch_mutex* mutex) { pthread_mutex_destroy(mutex); }
+static void batch_mutex_lock(batch_mutex* mutex) { pthread_mutex_lock(mutex); }
+static void batch_mutex_unlock(batch_mutex* mutex) { pthread_mutex_unlock(mutex); }
+#endif
+
+/*
+ * The dumps dealt to a thread are paths[id + k * threads] for k in [next, end). The owner
+ * takes them from the front, in order, thieves take them from the back. Nothing is ever
+ * added, so once every share is empty the run is over.
+ */
+struct batch_share
+{
+	batch_mutex lock;
+	size_t next;
+	size_t end;
+};
+
+struct batch_run;
+
+struct batch_worker
+{
+	struct batch_run* run;
+	unsigned int id;
+	struct br_context* context;
+	size_t steals;
+
+	batch_thread thread;
+	int bStarted;
+};
+
+struct batch_run
+{
+	const char* const* paths;
+	size_t count;
+	unsigned int threads;
+
+	struct batch_share* shares;
+	struct batch_worker* workers;
+	struct br_batch_result* results;
+
+	// Emission, in the order the dumps were handed in
+	batch_mutex emitLock;
+	unsigned char* bFinished;
+	size_t nextToEmit;
+	int bEmitting;
+	br_batch_emit_function emit;
+	void* userdata;
+};
+
+static double batch_seconds()
+{
+#if defined(BR_WINDOWS_PLATFORM)
+	LARGE_INTEGER frequency, counter;
+
+	QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&counter);
+
+	return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+#endif
+}
+
+unsigned int br_batch_default_threads()
+{
+#if defined(BR_WINDOWS_PLATFORM)
+	SYSTEM_INFO systemInfo;
+
+	GetSystemInfo(&systemInfo);
+
+	return systemInfo.dwNumberOfProcessors > 0 ? (unsigned int)systemInfo.dwNumberOfProcessors : 1;
+#else
+	long processors = sysconf(_SC_NPROCESSORS_ONLN);
+
+	return processors > 0 ? (unsigned int)processors : 1;
+#endif
+}
+
+static void copy_field(char* destination, size_t capacity, const char* source)
+{
+	size_t length = source != NULL ? strlen(source) : 0;
+
+	if (length >= capacity)
+	{
+		length = capacity - 1;
+	}
+
+	if (length > 0)
+	{
+		memcpy(destination, source, length);
+	}
+
+	destination[length] = '\0';
+}
+
+/*
+ * One dump, start to finish. The context is the worker's own, reused dump after dump
+ * (the index and the arena keep their memory)
+ */
+static void decode_one(struct br_context* context, const char* path, struct br_batch_result* result)
+{
+	struct bios_information* bios;
+	struct central_processing_unit* processor;
+	struct turing_machine_system_memory* systemMemory;
+
+	memset(result, 0, sizeof(*result));
+	result->path = path;
+
+	br_context_set_dump_file(context, path);
+
+	bios = br_decode(context, ss_bios);
+
+	if (context->loadedTable.buf == NULL)
+	{
+		return;
+	}
+
+	processor = br_decode(context, ps_processor);
+	systemMemory = br_decode(context, pi_systemmemory);
+
+	result->bDecoded = 1;
+	result->smbiosversion = context->loadedTable.ver;
+	result->structurecount = context->tableIndex.count;
+	result->tablelength = context->loadedTable.len;
+
+	copy_field(result->biosvendor, sizeof(result->biosvendor), bios->vendor);
+	copy_field(result->biosversion, sizeof(result->biosversion), bios->version);
+	copy_field(result->biosreleasedate, sizeof(result->biosreleasedate), bios->biosreleasedate);
+	copy_field(result->processor, sizeof(result->processor), processor->version);
+
+	result->memorydevices = systemMemory->number_of_ram_or_system_memory_devices;
+	copy_field(result->systemmemory, sizeof(result->systemmemory), systemMemory->total_grand_capacity);
+}
+
+static int take_own(struct batch_share* share, size_t* k)
+{
+	int bTaken = 0;
+
+	batch_mutex_lock(&share->lock);
+	if (share->next < share->end)
+	{
+		*k = share->next++;
+		bTaken = 1;
+	}
+	batch_mutex_unlock(&share->lock);
+
+	return bTaken;
+}
+
+static int steal(struct batch_share* share, size_t* k)
+{
+	int bTaken = 0;
+
+	batch_mutex_lock(&share->lock);
+	if (share->next < share->end)
+	{
+		*k = --share->end;
+		bTaken = 1;
+	}
+	batch_mutex_unlock(&share->lock);
+
+	return bTaken;
+}
+
+/*
+ * Next dump for the worker, its own first, then anybody's. 0 when there is none left
+ */
+static int take_dump(struct batch_worker* worker, size_t* dump)
+{
+	struct batch_run* run = worker->run;
+	size_t k;
+
+	if (take_own(&run->shares[worker->id], &k))
+	{
+		*dump = worker->id + k * run->threads;
+		return 1;
+	}
+
+	for (unsigned int v = 1; v < run->threads; v++)
+	{
+		unsigned int victim = (worker->id + v) % run->threads;
+
+		if (steal(&run->shares[victim], &k))
+		{
+			worker->steals++;
+			*dump = victim + k * run->threads;
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+/*
+ * Mark the dump done, and hand out whatever is next in line. Only one thread emits at a time,
+ * the others just leave their dump to it
+ */
+static void finish_dump(struct batch_run* run, size_t dump)
+{
+	batch_mutex_lock(&run->emitLock);
+
+	run->bFinished[dump] = 1;
+
+	if (!run->bEmitting)
+	{
+		run->bEmitting = 1;
+
+		while (run->nextToEmit < run->count && run->bFinished[run->nextToEmit])
+		{
+			size_t emitting = run->nextToEmit++;
+
+			if (run->emit != NULL)
+			{
+				batch_mutex_unlock(&run->emitLock);
+				run->emit(&run->results[emitting], run->userdata);
+				batch_mutex_lock(&run->emitLock);
+			}
+		}
+
+		run->bEmitting = 0;
+	}
+
+	batch_mutex_unlock(&run->emitLock);
+}
+
+static void work(struct batch_worker* worker)
+{
+	size_t dump;
+
+	while (take_dump(worker, &dump))
+	{
+		decode_one(worker->context, worker->run->paths[dump], &worker->run->results[dump]);
+		finish_dump(worker->run, dump);
+	}
+}
+
+#if defined(BR_WINDOWS_PLATFORM)
+static DWORD WINAPI worker_thread(LPVOID argument)
+{
+	work(argument);
+	return 0;
+}
+
+static int start_worker(struct batch_worker* worker)
+{
+	worker->thread = CreateThread(NULL, 0, worker_thread, worker, 0, NULL);
+	return worker->thread != NULL ? 0 : -1;
+}
+
+static void join_worker(struct batch_worker* worker)
+{
+	WaitForSingleObject(worker->thread, INFINITE);
+	CloseHandle(worker->thread);
+}
+#else
+static void* worker_thread(void* argument)
+{
+	work(argument);
+	return NULL;
+}
+
+static int start_worker(struct batch_worker* worker)
+{
+	return pthread_create(&worker->thread, NULL, worker_thread, worker) == 0 ? 0 : -1;
+}
+
+static void join_worker(struct batch_worker* worker)
+{
+	pthread_join(worker->thread, NULL);
+}
+#endif
+
+static void release_run(struct batch_run* run)
+{
+	if (run->workers != NULL)
+	{
+		for (unsigned int w = 0; w < run->threads; w++)
+		{
+			br_context_destroy(run->workers[w].context);
+		}
+	}
+
+	if (run->shares != NULL)
+	{
+		for (unsigned int w = 0; w < run->threads; w++)
+		{
+			batch_mutex_destroy(&run->shares[w].lock);
+		}
+	}
+
+	batch_mutex_destroy(&run->emitLock);
+
+	free(run->workers);
+	free(run->shares);
+	free(run->results);
+	free(run->bFinished);
+}
+
+int br_batch_decode(const char* const* paths, size_t count, unsigned int threads,
+	br_batch_emit_function emit, void* userdata, struct br_batch_statistics* statistics)
+{
+	struct batch_run run;
+	double start;
+	size_t steals = 0;
+	size_t decoded = 0;
+
+	if (threads == 0)
+	{
+		threads = br_batch_default_threads();
+	}
+
+	// Idle threads are of no use to anybody
+	if (count > 0 && threads > count)
+	{
+		threads = (unsigned int)count;
+	}
+
+	if (threads == 0)
+	{
+		threads = 1;
+	}
+
+	memset(&run, 0, sizeof(run));
+	run.paths = paths;
+	run.count = count;
+	run.threads = threads;
+	run.emit = emit;
+	run.userdata = userdata;
+	batch_mutex_init(&run.emitLock);
+
+	run.shares = calloc(threads, sizeof(struct batch_share));
+	run.workers = calloc(threads, sizeof(struct batch_worker));
+	run.results = calloc(count > 0 ? count : 1, sizeof(struct br_batch_result));
+	run.bFinished = calloc(count > 0 ? count : 1, 1);
+
+	if (run.shares == NULL || run.workers == NULL || run.results == NULL || run.bFinished == NULL)
+	{
+		free(run.shares);
+		run.shares = NULL;
+		release_run(&run);
+		return -1;
+	}
+
+	// Dealt round-robin, so that results come out steadily instead of in one go at the end
+	for (unsigned int w = 0; w < threads; w++)
+	{
+		batch_mutex_init(&run.shares[w].lock);
+		run.shares[w].next = 0;
+		run.shares[w].end = w < count ? (count - w + threads - 1) / threads : 0;
+	}
+
+	for (unsigned int w = 0; w < threads; w++)
+	{
+		run.workers[w].run = &run;
+		run.workers[w].id = w;
+		run.workers[w].context = br_context_create();
+
+		if (run.workers[w].context == NULL)
+		{
+			release_run(&run);
+			return -1;
+		}
+
+		// Nobody wants thousands of "SMBIOS x.y present."
+		run.workers[w].context->opt.flags |= FLAG_QUIET;
+	}
+
+	start = batch_seconds();
+
+	// The calling thread is worker 0. Should a thread fail to start, its share gets stolen
+	for (unsigned int w = 1; w < threads; w++)
+	{
+		run.workers[w].bStarted = start_worker(&run.workers[w]) == 0;
+	}
+
+	work(&run.workers[0]);
+
+	for (unsigned int w = 1; w < threads; w++)
+	{
+		if (run.workers[w].bStarted)
+		{
+			join_worker(&run.workers[w]);
+		}
+	}
+
+	if (statistics != NULL)
+	{
+		for (unsigned int w = 0; w < threads; w++)
+		{
+			steals += run.workers[w].steals;
+		}
+
+		for (size_t d = 0; d < count; d++)
+		{
+			decoded += run.results[d].bDecoded != 0;
+		}
+
+		statistics->dumps = count;
+		statistics->decoded = decoded;
+		statistics->steals = steals;
+		statistics->threads = threads;
+		statistics->seconds = batch_seconds() - start;
+		statistics->dumpspersecond = statistics->seconds > 0 ? (double)count / statistics->seconds : 0;
+	}
+
+	release_run(&run);
+
+	return 0;
+}
@@ -0,0 +1,767 @@
+/*
+ *   ----------------------------
+ *  |  dmicache.c
+ *   ----------------------------
+ *   This file is part of BiosReader.
+ *
+ *   BiosReader is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   BiosReader is distributed in the hope and belief that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with BiosReader.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined (BR_LINUX_PLATFORM) || defined (BR_MAC_PLATFORM)
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#endif
+
+#include "dmicache.h"
+#include "brcontext.h"
+
+#define DMI_CACHE_MAGIC "BRCACHE"
+#define DMI_CACHE_FILE "inventory.bin"
+
+/*
+ * The image: this header, the structs one after the other (bios, languages, system memory,
+ * processor, then the records of the memory devices, processor caches, processors, memory
+ * arrays and those of enum dmi_record_kind, kind by kind) and the strings, each distinct one once. In the structs the strings are
+ * offsets into the pool plus one, 0 being NULL, which is what makes the image relocatable.
+ * Nothing is ever read in place (everything is copied out) so nothing needs be aligned.
+ */
+struct dmi_cache_header
+{
+	char magic[8];
+	u32 layout; // DMI_CACHE_LAYOUT
+	u32 imagelength; // bytes, header included
+	unsigned long long fingerprint;
+
+	// Shapes of what follows, as seen by the build which wrote them
+	u32 structsizes[6 + DMI_RECORD_KINDS];
+
+	u32 categories; // decodedCategories bits the image stands for
+	u32 memorydevices;
+	u32 processorcaches;
+	u32 processors;
+	u32 memoryarrays;
+	u32 records[DMI_RECORD_KINDS];
+	u32 pooloffset;
+	u32 poollength;
+};
+
+/*
+ * Where the strings are, struct by struct
+ */
+static const size_t biosStrings[] = {
+	offsetof(struct bios_information, vendor),
+	offsetof(struct bios_information, version),
+	offsetof(struct bios_information, biosreleasedate),
+	offsetof(struct bios_information, bioscharacteristics),
+	offsetof(struct bios_information, biosromsize),
+};
+
+static const size_t languageStrings[] = {
+	offsetof(struct mb_language_modules, currentactivemodule),
+	offsetof(struct mb_language_modules, supportedlanguagemodules),
+};
+
+static const size_t systemMemoryStrings[] = {
+	offsetof(struct turing_machine_system_memory, total_grand_capacity),
+	offsetof(struct turing_machine_system_memory, mounting_location),
+	offsetof(struct turing_machine_system_memory, use),
+};
+
+static const size_t processorStrings[] = {
+	offsetof(struct central_processing_unit, designation),
+	offsetof(struct central_processing_unit, cputype),
+	offsetof(struct central_processing_unit, processingfamily),
+	offsetof(struct central_processing_unit, manufacturer),
+	offsetof(struct central_processing_unit, cpuflags),
+	offsetof(struct central_processing_unit, version),
+	offsetof(struct central_processing_unit, operatingvoltage),
+	offsetof(struct central_processing_unit, externalclock),
+	offsetof(struct central_processing_unit, maximumspeed),
+	offsetof(struct central_processing_unit, currentspeed),
+	offsetof(struct central_processing_unit, serialnumber),
+	offsetof(struct central_processing_unit, partnumber),
+	offsetof(struct central_processing_unit, assettag),
+	offsetof(struct central_processing_unit, corescount),
+	offsetof(struct central_processing_unit, enabledcorescount),
+	offsetof(struct central_processing_unit, threadcount),
+	offsetof(struct central_processing_unit, characterstics),
+	offsetof(struct central_processing_unit, cpuid),
+	offsetof(struct central_processing_unit, signature),
+};
+
+static const size_t memoryDeviceStrings[] = {
+	offsetof(struct random_access_memory, formfactor),
+	offsetof(struct random_access_memory, ramsize),
+	offsetof(struct random_access_memory, locator),
+	offsetof(struct random_access_memory, ramtype),
+	offsetof(struct random_access_memory, banklocator),
+	offsetof(struct random_access_memory, manufacturer),
+	offsetof(struct random_access_memory, serialnumber),
+	offsetof(struct random_access_memory, partnumber),
+	offsetof(struct random_access_memory, assettag),
+	offsetof(struct random_access_memory, memoryspeed),
+	offsetof(struct random_access_memory, configuredmemoryspeed),
+	offsetof(struct random_access_memory, operatingvoltage),
+	offsetof(struct random_access_memory, rank),
+};
+
+static const size_t processorCacheStrings[] = {
+	offsetof(struct cpu_cache, designation),
+	offsetof(struct cpu_cache, status),
+	offsetof(struct cpu_cache, operationmode),
+	offsetof(struct cpu_cache, location),
+	offsetof(struct cpu_cache, sramtype),
+	offsetof(struct cpu_cache, speed),
+	offsetof(struct cpu_cache, errorcorrection),
+	offsetof(struct cpu_cache, systemtype),
+	offsetof(struct cpu_cache, associativity),
+	offsetof(struct cpu_cache, installedsize),
+	offsetof(struct cpu_cache, maximumsize),
+};
+
+static void structure_sizes(u32* sizes)
+{
+	sizes[0] = sizeof(struct bios_information);
+	sizes[1] = sizeof(struct mb_language_modules);
+	sizes[2] = sizeof(struct turing_machine_system_memory);
+	sizes[3] = sizeof(struct central_processing_unit);
+	sizes[4] = sizeof(struct random_access_memory);
+	sizes[5] = sizeof(struct cpu_cache);
+
+	for (size_t k = 0; k < DMI_RECORD_KINDS; k++)
+	{
+		sizes[6 + k] = (u32)dmi_record_layout_of(k)->size;
+	}
+}
+
+unsigned long long dmi_cache_fingerprint(const u8* entryPoint, size_t entryPointLength, u32 tableLength)
+{
+	unsigned long long hash = 14695981039346656037ULL;
+
+	for (size_t i = 0; i < entryPointLength; i++)
+	{
+		hash = (hash ^ entryPoint[i]) * 1099511628211ULL;
+	}
+
+	for (int i = 0; i < 4; i++)
+	{
+		hash = (hash ^ ((tableLength >> (8 * i)) & 0xFF)) * 1099511628211ULL;
+	}
+
+	return hash;
+}
+
+#if defined (BR_LINUX_PLATFORM) || defined (BR_MAC_PLATFORM)
+
+// Images hold serial numbers and the like, the directories are the user's own (as XDG wants them)
+static int make_directory(const char* path)
+{
+	return mkdir(path, 0700) == 0 || errno == EEXIST ? 0 : -1;
+}
+
+/*
+ * The image, opened for mapping, if it is one the process may trust: a regular file of the effective
+ * user (BiosReader usually runs as root, with the HOME of whoever invoked it), writable by nobody else.
+ * -1 otherwise
+ */
+static int open_trusted_image(const char* path)
+{
+	struct stat statistics;
+	int fd = open(path, O_RDONLY | O_NOFOLLOW);
+
+	if (fd == -1)
+	{
+		return -1;
+	}
+
+	if (fstat(fd, &statistics) == -1 || !S_ISREG(statistics.st_mode)
+		|| statistics.st_uid != geteuid() || (statistics.st_mode & (S_IWGRP | S_IWOTH)))
+	{
+		close(fd);
+		return -1;
+	}
+
+	return fd;
+}
+
+int dmi_cache_path(char* path, size_t size)
+{
+	const char* base = getenv("XDG_CACHE_HOME");
+	int length;
+	int fileLength;
+
+	if (base != NULL && base[0] != '\0')
+	{
+		if (make_directory(base) != 0)
+		{
+			return -1;
+		}
+
+		length = snprintf(path, size, "%s/biosreader", base);
+	}
+	else if ((base = getenv("HOME")) != NULL && base[0] != '\0')
+	{
+		length = snprintf(path, size, "%s/.cache", base);
+		if (length < 0 || (size_t)length >= size || make_directory(path) != 0)
+		{
+			return -1;
+		}
+
+		length = snprintf(path, size, "%s/.cache/biosreader", base);
+	}
+	else
+	{
+		length = snprintf(path, size, "/run/biosreader");
+	}
+
+	if (length < 0 || (size_t)length >= size || make_directory(path) != 0)
+	{
+		return -1;
+	}
+
+	fileLength = snprintf(path + length, size - length, "/" DMI_CACHE_FILE);
+
+	return fileLength < 0 || (size_t)fileLength >= size - length ? -1 : 0;
+}
+
+/*
+ * The image being put together, see dmi_cache_store()
+ */
+struct cache_buffer
+{
+	u8* data;
+	size_t length;
+	size_t capacity;
+};
+
+static int buffer_append(struct cache_buffer* buffer, const void* data, size_t length)
+{
+	if (buffer->length + length > buffer->capacity)
+	{
+		size_t capacity = buffer->capacity ? buffer->capacity : 4096;
+		u8* grown;
+
+		while (capacity < buffer->length + length)
+		{
+			capacity *= 2;
+		}
+
+		grown = realloc(buffer->data, capacity);
+		if (grown == NULL)
+		{
+			return -1;
+		}
+
+		buffer->data = grown;
+		buffer->capacity = capacity;
+	}
+
+	memcpy(buffer->data + buffer->length, data, length);
+	buffer->length += length;
+
+	return 0;
+}
+
+/*
+ * The strings of the image. Interned ones (all of them, in practice) go in once
+ */
+struct cache_pool
+{
+	struct cache_buffer buffer;
+	const struct br_intern_pool* interned;
+	u32* offsets; // by id, where the string went plus one, 0 for not yet
+};
+
+static int pool_append(struct cache_pool* pool, const char* string, uintptr_t* slot)
+{
+	u32 id = br_intern_id(pool->interned, string);
+
+	if (id != 0 && pool->offsets[id] != 0)
+	{
+		*slot = pool->offsets[id];
+		return 0;
+	}
+
+	*slot = (uintptr_t)pool->buffer.length + 1;
+	if (buffer_append(&pool->buffer, string, strlen(string) + 1) != 0)
+	{
+		return -1;
+	}
+
+	if (id != 0)
+	{
+		pool->offsets[id] = (u32)*slot;
+	}
+
+	return 0;
+}
+
+/*
+ * Append a struct, its strings moved into the pool and replaced by their offsets
+ */
+static int append_structure(struct cache_buffer* image, struct cache_pool* pool,
+	const void* structure, size_t size, const size_t* strings, size_t stringCount)
+{
+	union
+	{
+		struct bios_information bios;
+		struct mb_language_modules languages;
+		struct turing_machine_system_memory systemMemory;
+		struct central_processing_unit processor;
+		struct random_access_memory memory;
+		struct cpu_cache processorCache;
+		struct system_information system;
+		struct base_board baseBoard;
+		struct chassis_information chassis;
+		struct port_connector portConnector;
+		struct system_slot systemSlot;
+		struct management_probe probe;
+		struct power_supply powerSupply;
+	} scratch;
+	u8* copy = (u8*)&scratch;
+
+	if (size > sizeof(scratch))
+	{
+		return -1;
+	}
+
+	memcpy(copy, structure, size);
+
+	for (size_t s = 0; s < stringCount; s++)
+	{
+		const char* string;
+		uintptr_t slot = 0;
+
+		memcpy(&string, copy + strings[s], sizeof(string));
+
+		if (string != NULL && pool_append(pool, string, &slot) != 0)
+		{
+			return -1;
+		}
+
+		memcpy(copy + strings[s], &slot, sizeof(slot));
+	}
+
+	return buffer_append(image, copy, size);
+}
+
+static int append_records(struct cache_buffer* image, struct cache_pool* pool,
+	const void* records, unsigned int count, size_t size, const size_t* strings, size_t stringCount)
+{
+	for (unsigned int r = 0; r < count; r++)
+	{
+		if (append_structure(image, pool, (const u8*)records + r * size, size, strings, stringCount) != 0)
+		{
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+int dmi_cache_store(const struct br_context* context, unsigned long long fingerprint, const char* path)
+{
+	struct dmi_cache_header header;
+	struct cache_buffer image = { NULL, 0, 0 };
+	struct cache_pool pool = { { NULL, 0, 0 }, &context->stringPool, NULL };
+	unsigned int memoryDevices = context->turingmachinesystemmemory.number_of_ram_or_system_memory_devices;
+	char temporaryPath[4096];
+	int status = -1;
+	int fd;
+	FILE* stream;
+
+	if ((context->decodedCategories & DMI_CACHE_CATEGORIES) != DMI_CACHE_CATEGORIES
+		|| (memoryDevices > 0 && context->randomaccessmemory == NULL))
+	{
+		return -1;
+	}
+
+	pool.offsets = calloc((size_t)context->stringPool.count + 1, sizeof(u32));
+	if (pool.offsets == NULL)
+	{
+		return -1;
+	}
+
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, DMI_CACHE_MAGIC, sizeof(DMI_CACHE_MAGIC));
+	header.layout = DMI_CACHE_LAYOUT;
+	header.fingerprint = fingerprint;
+	structure_sizes(header.structsizes);
+	header.categories = DMI_CACHE_CATEGORIES;
+	header.memorydevices = memoryDevices;
+	header.processorcaches = context->cacheCount;
+	header.processors = context->processorCount;
+	header.memoryarrays = context->arrayCount;
+	for (size_t k = 0; k < DMI_RECORD_KINDS; k++)
+	{
+		header.records[k] = context->records[k].count;
+	}
+
+	if (buffer_append(&image, &header, sizeof(header)) != 0
+		|| append_structure(&image, &pool, &context->biosinformation, sizeof(struct bios_information),
+			biosStrings, ARRAY_SIZE(biosStrings)) != 0
+		|| append_structure(&image, &pool, &context->mblanguagemodules, sizeof(struct mb_language_modules),
+			languageStrings, ARRAY_SIZE(languageStrings)) != 0
+		|| append_structure(&image, &pool, &context->turingmachinesystemmemory, sizeof(struct turing_machine_system_memory),
+			systemMemoryStrings, ARRAY_SIZE(systemMemoryStrings)) != 0
+		|| append_structure(&image, &pool, &context->centralprocessinguint, sizeof(struct central_processing_unit),
+			processorStrings, ARRAY_SIZE(processorStrings)) != 0
+		|| append_records(&image, &pool, context->randomaccessmemory, memoryDevices, sizeof(struct random_access_memory),
+			memoryDeviceStrings, ARRAY_SIZE(memoryDeviceStrings)) != 0
+		|| append_records(&image, &pool, context->processorcaches, context->cacheCount, sizeof(struct cpu_cache),
+			processorCacheStrings, ARRAY_SIZE(processorCacheStrings)) != 0
+		|| append_records(&image, &pool, context->processors, context->processorCount, sizeof(struct central_processing_unit),
+			processorStrings, ARRAY_SIZE(processorStrings)) != 0
+		|| append_records(&image, &pool, context->memoryarrays, context->arrayCount, sizeof(struct turing_machine_system_memory),
+			systemMemoryStrings, ARRAY_SIZE(systemMemoryStrings)) != 0)
+	{
+		goto out;
+	}
+
+	for (size_t k = 0; k < DMI_RECORD_KINDS; k++)
+	{
+		const struct dmi_record_layout* layout = dmi_record_layout_of(k);
+
+		if (append_records(&image, &pool, context->records[k].records, context->records[k].count, layout->size,
+			layout->strings, layout->stringCount) != 0)
+		{
+			goto out;
+		}
+	}
+
+	// Never an empty pool, its last byte is what guarantees every string ends
+	if (pool.buffer.length == 0 && buffer_append(&pool.buffer, "", 1) != 0)
+	{
+		goto out;
+	}
+
+	header.pooloffset = (u32)image.length;
+	header.poollength = (u32)pool.buffer.length;
+
+	if (buffer_append(&image, pool.buffer.data, pool.buffer.length) != 0)
+	{
+		goto out;
+	}
+
+	header.imagelength = (u32)image.length;
+	memcpy(image.data, &header, sizeof(header));
+
+	// Aside first, then over the old one in one go
+	if (snprintf(temporaryPath, sizeof(temporaryPath), "%s.XXXXXX", path) >= (int)sizeof(temporaryPath)
+		|| (fd = mkstemp(temporaryPath)) == -1)
+	{
+		goto out;
+	}
+
+	stream = fdopen(fd, "wb");
+	if (stream == NULL)
+	{
+		close(fd);
+		unlink(temporaryPath);
+		goto out;
+	}
+
+	if (fwrite(image.data, 1, image.length, stream) != image.length)
+	{
+		fclose(stream);
+		unlink(temporaryPath);
+		goto out;
+	}
+
+	if (fclose(stream) != 0 || rename(temporaryPath, path) != 0)
+	{
+		unlink(temporaryPath);
+		goto out;
+	}
+
+	status = 0;
+
+out:
+	free(image.data);
+	free(pool.buffer.data);
+	free(pool.offsets);
+
+	return status;
+}
+
+/*
+ * Turn the offsets of a struct copied out of the image back into pointers into the pool, the
+ * strings interned in place as they go. -1 if one of them points nowhere.
+ */
+static int relocate_structure(struct br_context* context, void* structure, const size_t* strings, size_t stringCount,
+	char* pool, u32 poolLength)
+{
+	u8* bytes = structure;
+
+	for (size_t s = 0; s < stringCount; s++)
+	{
+		uintptr_t slot;
+		char* string = NULL;
+
+		memcpy(&slot, bytes + strings[s], sizeof(slot));
+
+		if (slot != 0)
+		{
+			if (slot - 1 >= poolLength)
+			{
+				return -1;
+			}
+
+			string = (char*)br_intern(&context->stringPool, NULL, pool + (slot - 1));
+			if (string == NULL)
+			{
+				return -1;
+			}
+		}
+
+		memcpy(bytes + strings[s], &string, sizeof(string));
+	}
+
+	return 0;
+}
+
+/*
+ * Copy count records out of the image (at the cursor, which moves past them) into the arena, and
+ * relocate their strings. NULL records for a count of 0.
+ */
+static int load_records(struct br_context* context, const u8** cursor, u32 count, size_t size,
+	const size_t* strings, size_t stringCount, char* pool, u32 poolLength, void** records)
+{
+	u8* copy;
+
+	*records = NULL;
+
+	if (count == 0)
+	{
+		return 0;
+	}
+
+	copy = br_arena_alloc(&context->decodeArena, count * size);
+	if (copy == NULL)
+	{
+		return -1;
+	}
+
+	memcpy(copy, *cursor, count * size);
+	*cursor += count * size;
+
+	for (u32 r = 0; r < count; r++)
+	{
+		if (relocate_structure(context, copy + r * size, strings, stringCount, pool, poolLength) != 0)
+		{
+			return -1;
+		}
+	}
+
+	*records = copy;
+
+	return 0;
+}
+
+int dmi_cache_load(struct br_context* context, unsigned long long fingerprint, const char* path)
+{
+	struct file_mapping mapping;
+	struct dmi_cache_header header;
+	struct bios_information bios;
+	struct mb_language_modules languages;
+	struct turing_machine_system_memory systemMemory;
+	struct central_processing_unit processor;
+	void* memoryDevices;
+	void* processorCaches;
+	void* processors;
+	void* memoryArrays;
+	void* records[DMI_RECORD_KINDS];
+	u32 sizes[6 + DMI_RECORD_KINDS];
+	size_t length = (size_t)-1;
+	size_t structuresLength;
+	const u8* image;
+	const u8* cursor;
+	char* pool;
+	int bHit = 0;
+	int fd = open_trusted_image(path);
+
+	if (fd == -1)
+	{
+		return 0;
+	}
+
+	// Mapped out of the very file looked into, whatever gets renamed over it meanwhile
+	image = map_descriptor(fd, 0, &length, &mapping);
+	close(fd);
+	if (image == NULL)
+	{
+		return 0;
+	}
+
+	structure_sizes(sizes);
+
+	if (length < sizeof(header))
+	{
+		goto out;
+	}
+
+	memcpy(&header, image, sizeof(header));
+
+	// No machine has that many, and the arithmetic below stays well clear of overflowing
+	if (header.memorydevices > 0xFFFF || header.processorcaches > 0xFFFF
+		|| header.processors > 0xFFFF || header.memoryarrays > 0xFFFF)
+	{
+		goto out;
+	}
+
+	for (size_t k = 0; k < DMI_RECORD_KINDS; k++)
+	{
+		if (header.records[k] > 0xFFFF)
+		{
+			goto out;
+		}
+	}
+
+	structuresLength = sizeof(struct bios_information) + sizeof(struct mb_language_modules)
+		+ sizeof(struct turing_machine_system_memory) + sizeof(struct central_processing_unit)
+		+ (size_t)header.memorydevices * sizeof(struct random_access_memory)
+		+ (size_t)header.processorcaches * sizeof(struct cpu_cache)
+		+ (size_t)header.processors * sizeof(struct central_processing_unit)
+		+ (size_t)header.memoryarrays * sizeof(struct turing_machine_system_memory);
+
+	for (size_t k = 0; k < DMI_RECORD_KINDS; k++)
+	{
+		structuresLength += (size_t)header.records[k] * dmi_record_layout_of(k)->size;
+	}
+
+	// Anything off, and it's as good as not there
+	if (memcmp(header.magic, DMI_CACHE_MAGIC, sizeof(DMI_CACHE_MAGIC)) != 0
+		|| header.layout != DMI_CACHE_LAYOUT
+		|| header.fingerprint != fingerprint
+		|| memcmp(header.structsizes, sizes, sizeof(sizes)) != 0
+		|| header.imagelength != length
+		|| header.pooloffset != sizeof(header) + structuresLength
+		|| header.poollength == 0
+		|| (size_t)header.pooloffset + header.poollength != length
+		|| image[length - 1] != '\0')
+	{
+		goto out;
+	}
+
+	cursor = image + sizeof(header);
+
+	memcpy(&bios, cursor, sizeof(bios));
+	cursor += sizeof(bios);
+	memcpy(&languages, cursor, sizeof(languages));
+	cursor += sizeof(languages);
+	memcpy(&systemMemory, cursor, sizeof(systemMemory));
+	cursor += sizeof(systemMemory);
+	memcpy(&processor, cursor, sizeof(processor));
+	cursor += sizeof(processor);
+
+	if (systemMemory.number_of_ram_or_system_memory_devices != header.memorydevices)
+	{
+		goto out;
+	}
+
+	// Out of the mapping, into the arena, so that it can go right away
+	pool = br_arena_alloc(&context->decodeArena, header.poollength);
+	if (pool == NULL)
+	{
+		goto out;
+	}
+
+	memcpy(pool, image + header.pooloffset, header.poollength);
+
+	if (relocate_structure(context, &bios, biosStrings, ARRAY_SIZE(biosStrings), pool, header.poollength) != 0
+		|| relocate_structure(context, &languages, languageStrings, ARRAY_SIZE(languageStrings), pool, header.poollength) != 0
+		|| relocate_structure(context, &systemMemory, systemMemoryStrings, ARRAY_SIZE(systemMemoryStrings), pool, header.poollength) != 0
+		|| relocate_structure(context, &processor, processorStrings, ARRAY_SIZE(processorStrings), pool, header.poollength) != 0
+		|| load_records(context, &cursor, header.memorydevices, sizeof(struct random_access_memory),
+			memoryDeviceStrings, ARRAY_SIZE(memoryDeviceStrings), pool, header.poollength, &memoryDevices) != 0
+		|| load_records(context, &cursor, header.processorcaches, sizeof(struct cpu_cache),
+			processorCacheStrings, ARRAY_SIZE(processorCacheStrings), pool, header.poollength, &processorCaches) != 0
+		|| load_records(context, &cursor, header.processors, sizeof(struct central_processing_unit),
+			processorStrings, ARRAY_SIZE(processorStrings), pool, header.poollength, &processors) != 0
+		|| load_records(context, &cursor, header.memoryarrays, sizeof(struct turing_machine_system_memory),
+			systemMemoryStrings, ARRAY_SIZE(systemMemoryStrings), pool, header.poollength, &memoryArrays) != 0)
+	{
+		goto out;
+	}
+
+	for (size_t k = 0; k < DMI_RECORD_KINDS; k++)
+	{
+		const struct dmi_record_layout* layout = dmi_record_layout_of(k);
+
+		if (load_records(context, &cursor, header.records[k], layout->size,
+			layout->strings, layout->stringCount, pool, header.poollength, &records[k]) != 0)
+		{
+			goto out;
+		}
+	}
+
+	context->biosinformation = bios;
+	context->mblanguagemodules = languages;
+	context->turingmachinesystemmemory = systemMemory;
+	context->centralprocessinguint = processor;
+	context->randomaccessmemory = memoryDevices;
+	context->ramCounter = header.memorydevices;
+	context->processorcaches = processorCaches;
+	context->cacheCount = header.processorcaches;
+	context->cacheCounter = header.processorcaches;
+	context->processors = processors;
+	context->processorCount = header.processors;
+	context->processorCounter = header.processors;
+	context->memoryarrays = memoryArrays;
+	context->arrayCount = header.memoryarrays;
+	context->arrayCounter = header.memoryarrays;
+	for (size_t k = 0; k < DMI_RECORD_KINDS; k++)
+	{
+		context->records[k].records = records[k];
+		context->records[k].count = header.records[k];
+		context->records[k].counter = header.records[k];
+	}
+	context->decodedCategories |= header.categories & DMI_CACHE_CATEGORIES;
+
+	bHit = 1;
+
+out:
+	unmap_file(&mapping);
+
+	return bHit;
+}
+
+#else
+
+// No cache (yet) where the table doesn't come out of a file
+
+int dmi_cache_path(char* path, size_t size)
+{
+	return -1;
+}
+
+int dmi_cache_store(const struct br_context* context, unsigned long long fingerprint, const char* path)
+{
+	return -1;
+}
+
+int dmi_cache_load(struct br_context* context, unsigned long long fingerprint, const char* path)
+{
+	return 0;
+}
+
+#endif
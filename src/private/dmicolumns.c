@@ -0,0 +1,256 @@
+/*
+ *   ----------------------------
+ *  |  dmicolumns.c
+ *   ----------------------------
+ *   This file is part of BiosReader.
+ *
+ *   BiosReader is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   BiosReader is distributed in the hope and belief that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with BiosReader.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stddef.h>
+
+#include "dmicolumns.h"
+#include "brcontext.h"
+
+/*
+ * A column of count elements in the decode arena, never NULL for an empty one
+ */
+static void* column(struct br_context* context, size_t elementSize, unsigned int count)
+{
+	return br_arena_alloc(&context->decodeArena, elementSize * (count ? count : 1));
+}
+
+static int build_processor_columns(struct br_context* context)
+{
+	struct br_processor_columns* columns = &context->processorColumns;
+	unsigned int count = context->processorCount;
+	unsigned int* handles = column(context, sizeof(unsigned int), count);
+	unsigned int* cores = column(context, sizeof(unsigned int), count);
+	unsigned int* enabledcores = column(context, sizeof(unsigned int), count);
+	unsigned int* threads = column(context, sizeof(unsigned int), count);
+	unsigned int* maximumspeedmhz = column(context, sizeof(unsigned int), count);
+	unsigned int* currentspeedmhz = column(context, sizeof(unsigned int), count);
+	unsigned int* externalclockmhz = column(context, sizeof(unsigned int), count);
+	unsigned int* voltagemv = column(context, sizeof(unsigned int), count);
+	const char** versions = column(context, sizeof(const char*), count);
+
+	if (handles == NULL || cores == NULL || enabledcores == NULL || threads == NULL || maximumspeedmhz == NULL
+		|| currentspeedmhz == NULL || externalclockmhz == NULL || voltagemv == NULL || versions == NULL)
+	{
+		return -1;
+	}
+
+	for (unsigned int p = 0; p < count; p++)
+	{
+		const struct central_processing_unit* processor = &context->processors[p];
+
+		handles[p] = processor->handle;
+		cores[p] = processor->cores;
+		enabledcores[p] = processor->enabledcores;
+		threads[p] = processor->threads;
+		maximumspeedmhz[p] = processor->maximumspeedmhz;
+		currentspeedmhz[p] = processor->currentspeedmhz;
+		externalclockmhz[p] = processor->externalclockmhz;
+		voltagemv[p] = processor->operatingvoltagemv;
+		versions[p] = processor->version;
+	}
+
+	columns->count = count;
+	columns->handles = handles;
+	columns->cores = cores;
+	columns->enabledcores = enabledcores;
+	columns->threads = threads;
+	columns->maximumspeedmhz = maximumspeedmhz;
+	columns->currentspeedmhz = currentspeedmhz;
+	columns->externalclockmhz = externalclockmhz;
+	columns->voltagemv = voltagemv;
+	columns->versions = versions;
+
+	return 0;
+}
+
+static int build_memory_array_columns(struct br_context* context)
+{
+	struct br_memory_array_columns* columns = &context->memoryArrayColumns;
+	unsigned int count = context->arrayCount;
+	unsigned int* handles = column(context, sizeof(unsigned int), count);
+	unsigned long long* capacitybytes = column(context, sizeof(unsigned long long), count);
+	unsigned int* devicecounts = column(context, sizeof(unsigned int), count);
+	const char** uses = column(context, sizeof(const char*), count);
+
+	if (handles == NULL || capacitybytes == NULL || devicecounts == NULL || uses == NULL)
+	{
+		return -1;
+	}
+
+	for (unsigned int a = 0; a < count; a++)
+	{
+		const struct turing_machine_system_memory* array = &context->memoryarrays[a];
+
+		handles[a] = array->handle;
+		capacitybytes[a] = array->total_grand_capacity_bytes;
+		devicecounts[a] = array->number_of_ram_or_system_memory_devices;
+		uses[a] = array->use;
+	}
+
+	columns->count = count;
+	columns->handles = handles;
+	columns->capacitybytes = capacitybytes;
+	columns->devicecounts = devicecounts;
+	columns->uses = uses;
+
+	return 0;
+}
+
+static int build_memory_device_columns(struct br_context* context)
+{
+	struct br_memory_device_columns* columns = &context->memoryDeviceColumns;
+	unsigned int count = context->randomaccessmemory != NULL ? context->turingmachinesystemmemory.number_of_ram_or_system_memory_devices : 0;
+	unsigned int* handles = column(context, sizeof(unsigned int), count);
+	unsigned int* arrayhandles = column(context, sizeof(unsigned int), count);
+	unsigned long long* sizebytes = column(context, sizeof(unsigned long long), count);
+	unsigned int* speedmts = column(context, sizeof(unsigned int), count);
+	unsigned int* configuredspeedmts = column(context, sizeof(unsigned int), count);
+	unsigned int* voltagemv = column(context, sizeof(unsigned int), count);
+	unsigned int* ranks = column(context, sizeof(unsigned int), count);
+	const char** locators = column(context, sizeof(const char*), count);
+	unsigned int* manufacturerids = column(context, sizeof(unsigned int), count);
+	unsigned int* partnumberids = column(context, sizeof(unsigned int), count);
+
+	if (handles == NULL || arrayhandles == NULL || sizebytes == NULL || speedmts == NULL
+		|| configuredspeedmts == NULL || voltagemv == NULL || ranks == NULL || locators == NULL
+		|| manufacturerids == NULL || partnumberids == NULL)
+	{
+		return -1;
+	}
+
+	for (unsigned int d = 0; d < count; d++)
+	{
+		const struct random_access_memory* device = &context->randomaccessmemory[d];
+
+		handles[d] = device->handle;
+		arrayhandles[d] = device->arrayhandle;
+		sizebytes[d] = device->ramsizebytes;
+		speedmts[d] = device->memoryspeedmts;
+		configuredspeedmts[d] = device->configuredmemoryspeedmts;
+		voltagemv[d] = device->operatingvoltagemv;
+		ranks[d] = device->ranks;
+		locators[d] = device->locator;
+		manufacturerids[d] = br_intern_id(&context->stringPool, device->manufacturer);
+		partnumberids[d] = br_intern_id(&context->stringPool, device->partnumber);
+	}
+
+	columns->count = count;
+	columns->handles = handles;
+	columns->arrayhandles = arrayhandles;
+	columns->sizebytes = sizebytes;
+	columns->speedmts = speedmts;
+	columns->configuredspeedmts = configuredspeedmts;
+	columns->voltagemv = voltagemv;
+	columns->ranks = ranks;
+	columns->locators = locators;
+	columns->manufacturerids = manufacturerids;
+	columns->partnumberids = partnumberids;
+
+	return 0;
+}
+
+/*
+ * All of the columns, in one go, out of the records (decoded first if need be)
+ */
+static int build_columns(struct br_context* context)
+{
+	if (context->bColumnsBuilt)
+	{
+		return 0;
+	}
+
+	if (context->bAlreadyRun == 0 || !(context->decodedCategories & (1u << ps_processor)))
+	{
+		br_decode(context, ps_processor);
+	}
+
+	if (!(context->decodedCategories & (1u << ps_systemmemory)))
+	{
+		br_decode(context, ps_systemmemory);
+	}
+
+	if (build_processor_columns(context) != 0
+		|| build_memory_array_columns(context) != 0
+		|| build_memory_device_columns(context) != 0)
+	{
+		return -1;
+	}
+
+	context->bColumnsBuilt = 1;
+
+	return 0;
+}
+
+const struct br_processor_columns* br_processor_columns(struct br_context* context)
+{
+	return build_columns(context) == 0 ? &context->processorColumns : NULL;
+}
+
+const struct br_memory_array_columns* br_memory_array_columns(struct br_context* context)
+{
+	return build_columns(context) == 0 ? &context->memoryArrayColumns : NULL;
+}
+
+const struct br_memory_device_columns* br_memory_device_columns(struct br_context* context)
+{
+	return build_columns(context) == 0 ? &context->memoryDeviceColumns : NULL;
+}
+
+unsigned long long br_installed_memory_bytes(struct br_context* context)
+{
+	const struct br_memory_device_columns* columns = br_memory_device_columns(context);
+	unsigned long long total = 0;
+
+	if (columns == NULL)
+	{
+		return 0;
+	}
+
+	for (unsigned int d = 0; d < columns->count; d++)
+	{
+		total += columns->sizebytes[d];
+	}
+
+	return total;
+}
+
+int br_slowest_memory_device(struct br_context* context)
+{
+	const struct br_memory_device_columns* columns = br_memory_device_columns(context);
+	unsigned int slowest = ~0u;
+	int found = -1;
+
+	if (columns == NULL)
+	{
+		return -1;
+	}
+
+	// Empty slots have no size, and unknown speeds are 0
+	for (unsigned int d = 0; d < columns->count; d++)
+	{
+		if (columns->sizebytes[d] != 0 && columns->configuredspeedmts[d] != 0 && columns->configuredspeedmts[d] < slowest)
+		{
+			slowest = columns->configuredspeedmts[d];
+			found = (int)d;
+		}
+	}
+
+	return found;
+}
@@ -83,6 +83,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <stddef.h>
 #include <sys/stat.h>
 
 #ifdef BR_WINDOWS_PLATFORM
@@ -113,6 +114,14 @@
 #include "dmiopt.h"
 #include "dmioem.h"
 #include "dmioutput.h"
+#include "dmiindex.h"
+#include "dmifields.h"
+#include "dmiscan.h"
+#include "arena.h"
+#include "gpuprovider.h"
+#include "gpumodule.h"
+#include "dmicache.h"
+#include "brcontext.h"
 
 // Unknown utility. Hopefully I may understand as I study
 #ifdef __FreeBSD__
@@ -123,15 +132,13 @@
 #define out_of_spec "<OUT OF SPEC>"
 static const char* bad_index = "<BAD INDEX>";
 
-enum cpuid_type cpuid_type = cpuid_none;
-
-struct opt opt;
 
 #define SUPPORTED_SMBIOS_VER 0x030500
 
 #define FLAG_NO_FILE_OFFSET     (1 << 0)
 #define FLAG_STOP_AT_EOT        (1 << 1)
 #define FLAG_FROM_API           (1 << 2)
+#define FLAG_INDEX_ONLY         (1 << 3) // read and walk the table, decode nothing (see br_context_table_at_hand())
 
 #define SYS_FIRMWARE_DIR "/sys/firmware/dmi/tables"
 #define SYS_ENTRY_FILE SYS_FIRMWARE_DIR "/smbios_entry_point"
@@ -153,6 +160,42 @@ enum OperatingSystem SubjectOS = Linux;
 enum OperatingSystem SubjectOS = MacOS;
 #endif
 
+// Forward declarations, of what is BiosReader's own business
+
+static int smbios3_decode(struct br_context* context, u8* buf, const char* devmem, u32 flags);
+static void dmi_table_decode(struct br_context* context, u8* buf, u32 len, u16 num, u16 ver, u32 flags);
+static void ashwamegha_run(struct br_context* context);
+
+#ifdef BR_MAC_PLATFORM
+// Type to mean any instance of a property list type;
+// CFString, CFData, CFNumber, CFBoolean, CFDate, CFArray, and CFDictionary.
+// And if that is not enough, we may have to deal with NSString and whatnot
+enum MacPropertyDataTypes
+{
+	NumberType = 0,
+	StringType,
+	BooleanType,
+	DataType,
+	ArrayType,
+	NSStringType
+};
+
+static void mac_device_service_gauger(struct br_context* context);
+#endif
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+// Helpers!
+/////////////////////////////////////////////////////////////////////////////////////////////
+static void copy_to_structure_char(struct br_context* context, char** destinationPointer, const char* sourcePointer);
+static void generate_multiline_buffer(char* const bufferHandle, char* const lineTextToEmbed, const char junctionCondition);
+static void render_bios_characteristics(struct br_context* context);
+static void render_cpu_flags(struct br_context* context);
+
+// Metric system for electronicssss
+static const char* memoUnit[8] = {
+		"bytes", "kB", "MB", "GB", "TB", "PB", "EB", "ZB"
+};
+
 /*
  * Type-independant Stuff
  */
@@ -195,6 +238,25 @@ static char* _dmi_string(const struct dmi_header* dm, u8 s, int filter)
 {
 	char* bp = (char*)dm->data;
 
+	// Straight from the string offsets gathered while walking the table
+	if (dm->strings != NULL)
+	{
+		if (s == 0)
+		{
+			s = 1;
+		}
+
+		if (s > dm->stringcount)
+			return NULL;
+
+		bp += dm->strings[s - 1];
+
+		if (filter)
+			ascii_filter(bp, dm->strings[s] - dm->strings[s - 1] - 1);
+
+		return bp;
+	}
+
 	bp += dm->length;
 	while (s > 1 && *bp)
 	{
@@ -442,7 +504,7 @@ static void dmi_bios_runtime_size(u32 code)
 	pr_attr("Runtime Size", format, code);
 }
 
-static void dmi_bios_rom_size(u8 code1, u16 code2, char* const writeBuffer)
+static void dmi_bios_rom_size(struct br_context* context, u8 code1, u16 code2, char* const writeBuffer)
 {
 	static const char* unit[4] = {
 		"MB", "GB", out_of_spec, out_of_spec
@@ -469,45 +531,70 @@ static void dmi_bios_rom_size(u8 code1, u16 code2, char* const writeBuffer)
 		br_safe_sprintf(sizeInformation, 8, "%u %s", code2 & 0x3FFF, unit[code2 >> 14]);
 	}
 
-	copy_to_structure_char((char**)writeBuffer, sizeInformation);
+	copy_to_structure_char(context, (char**)writeBuffer, sizeInformation);
 }
 
-static void dmi_bios_characteristics(u64 code, char* const writebuffer)
-{
-	char characteristicsPie[9999] = "";
+/*
+ * Names of the BIOS characteristics, see br_bios_has(). 7.1.1 starts at bit 3,
+ * the extension bytes (7.1.2.1 and 7.1.2.2) at bits 32 and 40.
+ */
+static const char* biosCharacteristics[] = {
+	"BIOS characteristics not supported", /* 3 */
+	"ISA is supported",
+	"MCA is supported",
+	"EISA is supported",
+	"PCI is supported",
+	"PC Card (PCMCIA) is supported",
+	"PNP is supported",
+	"APM is supported",
+	"BIOS is upgradeable",
+	"BIOS shadowing is allowed",
+	"VLB is supported",
+	"ESCD support is available",
+	"Boot from CD is supported",
+	"Selectable boot is supported",
+	"BIOS ROM is socketed",
+	"Boot from PC Card (PCMCIA) is supported",
+	"EDD is supported",
+	"Japanese floppy for NEC 9800 1.2 MB is supported",
+	"Japanese floppy for Toshiba 1.2 MB is supported",
+	"5.25\"/360 kB floppy services are supported",
+	"5.25\"/1.2 MB floppy services are supported",
+	"3.5\"/720 kB floppy services are supported",
+	"3.5\"/2.88 MB floppy services are supported",
+	"Print screen service is supported",
+	"8042 keyboard services are supported",
+	"Serial services are supported",
+	"Printer services are supported",
+	"CGA/mono video services are supported",
+	"NEC PC-98" /* 31 */
+};
 
-	/* 7.1.1 */
-	static const char* characteristics[] = {
-		"BIOS characteristics not supported", /* 3 */
-		"ISA is supported",
-		"MCA is supported",
-		"EISA is supported",
-		"PCI is supported",
-		"PC Card (PCMCIA) is supported",
-		"PNP is supported",
-		"APM is supported",
-		"BIOS is upgradeable",
-		"BIOS shadowing is allowed",
-		"VLB is supported",
-		"ESCD support is available",
-		"Boot from CD is supported",
-		"Selectable boot is supported",
-		"BIOS ROM is socketed",
-		"Boot from PC Card (PCMCIA) is supported",
-		"EDD is supported",
-		"Japanese floppy for NEC 9800 1.2 MB is supported",
-		"Japanese floppy for Toshiba 1.2 MB is supported",
-		"5.25\"/360 kB floppy services are supported",
-		"5.25\"/1.2 MB floppy services are supported",
-		"3.5\"/720 kB floppy services are supported",
-		"3.5\"/2.88 MB floppy services are supported",
-		"Print screen service is supported",
-		"8042 keyboard services are supported",
-		"Serial services are supported",
-		"Printer services are supported",
-		"CGA/mono video services are supported",
-		"NEC PC-98" /* 31 */
-	};
+/* 7.1.2.1 */
+static const char* biosCharacteristicsX1[] = {
+	"ACPI is supported", /* 0 */
+	"USB legacy is supported",
+	"AGP is supported",
+	"I2O boot is supported",
+	"LS-120 boot is supported",
+	"ATAPI Zip drive boot is supported",
+	"IEEE 1394 boot is supported",
+	"Smart battery is supported" /* 7 */
+};
+
+/* 7.1.2.2 */
+static const char* biosCharacteristicsX2[] = {
+	"BIOS boot specification is supported", /* 0 */
+	"Function key-initiated network boot is supported",
+	"Targeted content distribution is supported",
+	"UEFI is supported",
+	"System is a virtual machine",
+	"Manufacturing mode is supported",
+	"Manufacturing mode is enabled" /* 6 */
+};
+
+static void dmi_bios_characteristics(u64 code)
+{
 	int i;
 
 	/*
@@ -516,41 +603,19 @@ static void dmi_bios_characteristics(u64 code, char* const writebuffer)
 	 * See the table, mentioned in the standard which is mentioned in the link below
 	 * https://github.com/ravimohan1991/BiosReader/wiki/Demystifying-the-RAW-BIOS-information
 	 */
-	if (code.l & (1 << 3))
+	if (code.l & (1u << 3))
 	{
-		if (bDisplayOutput)
-		{
-			pr_list_item("%s", characteristics[0]);
-		}
-		// May need tweaking
-		br_safe_sprintf(characteristicsPie, 100, "%s", characteristics[0]);
-		copy_to_already_initialized_structure_char((char**)writebuffer, characteristicsPie);
+		pr_list_item("%s", biosCharacteristics[0]);
 		return;
 	}
 
-	int firstCounter = 0;
-
 	for (i = 4; i <= 31; i++)
 	{
-		if (code.l & (1 << i))
+		if (code.l & (1u << i))
 		{
-			if (bDisplayOutput)
-			{
-				pr_list_item("%s", characteristics[i - 3]);
-			}
-
-			if (firstCounter == 0)
-			{
-				br_safe_sprintf(characteristicsPie, 100, "%s", (char* const)characteristics[i - 3]);
-				firstCounter = 1;
-			}
-			else
-			{
-				generate_multiline_buffer(characteristicsPie, (char* const)characteristics[i - 3], '\n');
-			}
+			pr_list_item("%s", biosCharacteristics[i - 3]);
 		}
 	}
-	copy_to_already_initialized_structure_char((char**)writebuffer, characteristicsPie);
 }
 
 /*
@@ -591,97 +656,40 @@ static void generate_multiline_buffer(char* const bufferHandle, char* const line
 	memcpy(destination, &nullChar, 1);
 }
 
-static void dmi_bios_characteristics_x1(u8 code, char* const writebuffer)
+static void dmi_bios_characteristics_x1(u8 code)
 {
-	char characteristicsPie[9999] = "";
-
-	/* 7.1.2.1 */
-	static const char* characteristics[] = {
-		"ACPI is supported", /* 0 */
-		"USB legacy is supported",
-		"AGP is supported",
-		"I2O boot is supported",
-		"LS-120 boot is supported",
-		"ATAPI Zip drive boot is supported",
-		"IEEE 1394 boot is supported",
-		"Smart battery is supported" /* 7 */
-	};
 	int i;
 
-	int firstCounter = 0;
-
 	for (i = 0; i <= 7; i++)
 	{
 		if (code & (1 << i))
 		{
-			if (bDisplayOutput)
-			{
-				pr_list_item("%s", characteristics[i]);
-			}
-
-			if (firstCounter == 0)
-			{
-				br_safe_sprintf(characteristicsPie, 100, "%s", characteristics[i]);
-				firstCounter = 1;
-			}
-			else
-			{
-				generate_multiline_buffer(characteristicsPie, (char* const)characteristics[i], '\n');
-			}
+			pr_list_item("%s", biosCharacteristicsX1[i]);
 		}
 	}
-
-	append_to_structure_char((char**)writebuffer, characteristicsPie, '\n');
 }
 
-static void dmi_bios_characteristics_x2(u8 code, char* const writebuffer)
+static void dmi_bios_characteristics_x2(u8 code)
 {
-	char characteristicsPie[9999] = "";
-
-	/* 37.1.2.2 */
-	static const char* characteristics[] = {
-		"BIOS boot specification is supported", /* 0 */
-		"Function key-initiated network boot is supported",
-		"Targeted content distribution is supported",
-		"UEFI is supported",
-		"System is a virtual machine",
-		"Manufacturing mode is supported",
-		"Manufacturing mode is enabled" /* 6 */
-	};
 	int i;
 
-	int firstCounter = 0;
-
 	for (i = 0; i <= 6; i++)
 	{
 		if (code & (1 << i))
 		{
-			if (bDisplayOutput)
-			{
-				pr_list_item("%s", characteristics[i]);
-			}
-
-			if (firstCounter == 0)
-			{
-				br_safe_sprintf(characteristicsPie, 100, "%s", characteristics[i]);
-				firstCounter = 1;
-			}
-			else
-			{
-				generate_multiline_buffer(characteristicsPie, (char* const)characteristics[i], '\n');
-			}
+			pr_list_item("%s", biosCharacteristicsX2[i]);
 		}
 	}
-
-	append_to_structure_char((char**)writebuffer, characteristicsPie, '\n');
 }
 
 /*
  * 7.2 System Information (Type 1)
  */
 
-static void dmi_system_uuid(void (*print_cb)(const char* name, const char* format, ...),
-	const char* attr, const u8* p, u16 ver)
+/*
+ * The UUID as text, into buffer (37 bytes will do)
+ */
+static const char* dmi_system_uuid_text(const u8* p, u16 ver, char* buffer, size_t size)
 {
 	int only0xFF = 1, only0x00 = 1;
 	int i;
@@ -694,19 +702,11 @@ static void dmi_system_uuid(void (*print_cb)(const char* name, const char* forma
 
 	if (only0xFF)
 	{
-		if (print_cb)
-			print_cb(attr, "Not Present");
-		else
-			printf("Not Present\n");
-		return;
+		return "Not Present";
 	}
 	if (only0x00)
 	{
-		if (print_cb)
-			print_cb(attr, "Not Settable");
-		else
-			printf("Not Settable\n");
-		return;
+		return "Not Settable";
 	}
 
 	/*
@@ -719,28 +719,31 @@ static void dmi_system_uuid(void (*print_cb)(const char* name, const char* forma
 	 */
 	if (ver >= 0x0206)
 	{
-		if (print_cb)
-			print_cb(attr,
-				"%02x%02x%02x%02x-%02x%02x-%02x%02x-%02x%02x-%02x%02x%02x%02x%02x%02x",
-				p[3], p[2], p[1], p[0], p[5], p[4], p[7], p[6],
-				p[8], p[9], p[10], p[11], p[12], p[13], p[14], p[15]);
-		else
-			printf("%02x%02x%02x%02x-%02x%02x-%02x%02x-%02x%02x-%02x%02x%02x%02x%02x%02x\n",
-				p[3], p[2], p[1], p[0], p[5], p[4], p[7], p[6],
-				p[8], p[9], p[10], p[11], p[12], p[13], p[14], p[15]);
+		br_safe_sprintf(buffer, size,
+			"%02x%02x%02x%02x-%02x%02x-%02x%02x-%02x%02x-%02x%02x%02x%02x%02x%02x",
+			p[3], p[2], p[1], p[0], p[5], p[4], p[7], p[6],
+			p[8], p[9], p[10], p[11], p[12], p[13], p[14], p[15]);
 	}
 	else
 	{
-		if (print_cb)
-			print_cb(attr,
-				"%02x%02x%02x%02x-%02x%02x-%02x%02x-%02x%02x-%02x%02x%02x%02x%02x%02x",
-				p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7],
-				p[8], p[9], p[10], p[11], p[12], p[13], p[14], p[15]);
-		else
-			printf("%02x%02x%02x%02x-%02x%02x-%02x%02x-%02x%02x-%02x%02x%02x%02x%02x%02x\n",
-				p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7],
-				p[8], p[9], p[10], p[11], p[12], p[13], p[14], p[15]);
+		br_safe_sprintf(buffer, size,
+			"%02x%02x%02x%02x-%02x%02x-%02x%02x-%02x%02x-%02x%02x%02x%02x%02x%02x",
+			p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7],
+			p[8], p[9], p[10], p[11], p[12], p[13], p[14], p[15]);
 	}
+
+	return buffer;
+}
+
+static void dmi_system_uuid(void (*print_cb)(const char* name, const char* format, ...),
+	const char* attr, const u8* p, u16 ver)
+{
+	char uuid[40];
+
+	if (print_cb)
+		print_cb(attr, "%s", dmi_system_uuid_text(p, ver, uuid, sizeof(uuid)));
+	else
+		printf("%s\n", dmi_system_uuid_text(p, ver, uuid, sizeof(uuid)));
 }
 
 static const char* dmi_system_wake_up_type(u8 code)
@@ -872,7 +875,7 @@ static const char* dmi_chassis_type(u8 code)
 		"Stick PC" /* 0x24 */
 	};
 
-	code &= 0x7F; /* bits 6:0 are chassis type, 7th bit is the lock bit */
+	code &= DMI_CHASSIS_TYPE_MASK; /* bits 6:0 are chassis type, 7th bit is the lock bit */
 
 	if (code >= 0x01 && code <= 0x24)
 		return type[code - 0x01];
@@ -1377,7 +1380,7 @@ static enum cpuid_type dmi_get_cpuid_type(const struct dmi_header* h)
  */
 
  // Lable is "Signature" if called from dmi_processor_id
-void dmi_print_cpuid(void (*print_cb)(const char* name, const char* format, ...),
+void dmi_print_cpuid(struct br_context* context, void (*print_cb)(const char* name, const char* format, ...),
 	const char* label, enum cpuid_type sig, const u8* p)
 {
 	char signaturePie[120];
@@ -1402,8 +1405,7 @@ void dmi_print_cpuid(void (*print_cb)(const char* name, const char* format, ...)
 
 		br_safe_sprintf(signaturePie, 120, "Type %u, Family %u, Major Stepping %u, Minor Stepping %u", dx >> 12, (dx >> 8) & 0xF,
 			(dx >> 4) & 0xF, dx & 0xF);
-		copy_to_structure_char(&centralprocessinguint.signature, signaturePie);
-		return;
+		break;
 
 	case cpuid_80486:
 		dx = WORD(p);
@@ -1417,8 +1419,7 @@ void dmi_print_cpuid(void (*print_cb)(const char* name, const char* format, ...)
 		}
 		br_safe_sprintf(signaturePie, 120, "Type %u, Family %u, Model %u, Stepping %u", (dx >> 12) & 0x3, (dx >> 8) & 0xF,
 			(dx >> 4) & 0xF, dx & 0xF);
-		copy_to_structure_char(&centralprocessinguint.signature, signaturePie);
-		return;
+		break;
 
 	case cpuid_arm_legacy: /* ARM before SOC ID */
 		midr = DWORD(p);
@@ -1439,8 +1440,7 @@ void dmi_print_cpuid(void (*print_cb)(const char* name, const char* format, ...)
 		}
 		br_safe_sprintf(signaturePie, 120, "Implementor 0x%02x, Variant 0x%x, Architecture %u, Part 0x%03x, Revision %u", midr >> 24, (midr >> 20) & 0xF,
 			(midr >> 16) & 0xF, (midr >> 4) & 0xFFF, midr & 0xF);
-		copy_to_structure_char(&centralprocessinguint.signature, signaturePie);
-		return;
+		break;
 
 	case cpuid_arm_soc_id: /* ARM with SOC ID */
 		/*
@@ -1472,9 +1472,7 @@ void dmi_print_cpuid(void (*print_cb)(const char* name, const char* format, ...)
 		}
 		br_safe_sprintf(signaturePie, 120, "JEP-106 Bank 0x%02x Manufacturer 0x%02x, SoC ID 0x%04x, SoC Revision 0x%08x",
 			(jep106 >> 24) & 0x7F, (jep106 >> 16) & 0x7F, jep106 & 0xFFFF, soc_revision);
-		copy_to_structure_char(&centralprocessinguint.signature, signaturePie);
-
-		return;
+		break;
 
 	case cpuid_x86_intel: /* Intel */
 		eax = DWORD(p);
@@ -1497,7 +1495,6 @@ void dmi_print_cpuid(void (*print_cb)(const char* name, const char* format, ...)
 			((eax >> 20) & 0xFF) + ((eax >> 8) & 0x0F),
 			((eax >> 12) & 0xF0) + ((eax >> 4) & 0x0F),
 			eax & 0xF);
-		copy_to_structure_char(&centralprocessinguint.signature, signaturePie);
 		break;
 
 	case cpuid_x86_amd: /* AMD, publication #25481 revision 2.28 */
@@ -1513,53 +1510,61 @@ void dmi_print_cpuid(void (*print_cb)(const char* name, const char* format, ...)
 			((eax >> 8) & 0xF) + (((eax >> 8) & 0xF) == 0xF ? (eax >> 20) & 0xFF : 0),
 			((eax >> 4) & 0xF) | (((eax >> 8) & 0xF) == 0xF ? (eax >> 12) & 0xF0 : 0),
 			eax & 0xF);
-		copy_to_structure_char(&centralprocessinguint.signature, signaturePie);
 		break;
 	default:
 		return;
 	}
+
+	// OEM records (no context) only get theirs printed, the processor's own is kept
+	if (context != NULL)
+	{
+		copy_to_structure_char(context, &context->centralprocessinguint.signature, signaturePie);
+	}
 }
 
-static void dmi_processor_id(const struct dmi_header* h)
+/*
+ * Names of the processor flags (CPUID EDX), see br_cpu_has().
+ * Intel AP-485 revision 36, table 2-4
+ */
+static const char* processorFlags[32] = {
+	"FPU (Floating-point unit on-chip)", /* 0 */
+	"VME (Virtual mode extension)",
+	"DE (Debugging extension)",
+	"PSE (Page size extension)",
+	"TSC (Time stamp counter)",
+	"MSR (Model specific registers)",
+	"PAE (Physical address extension)",
+	"MCE (Machine check exception)",
+	"CX8 (CMPXCHG8 instruction supported)",
+	"APIC (On-chip APIC hardware supported)",
+	NULL, /* 10 */
+	"SEP (Fast system call)",
+	"MTRR (Memory type range registers)",
+	"PGE (Page global enable)",
+	"MCA (Machine check architecture)",
+	"CMOV (Conditional move instruction supported)",
+	"PAT (Page attribute table)",
+	"PSE-36 (36-bit page size extension)",
+	"PSN (Processor serial number present and enabled)",
+	"CLFSH (CLFLUSH instruction supported)",
+	NULL, /* 20 */
+	"DS (Debug store)",
+	"ACPI (ACPI supported)",
+	"MMX (MMX technology supported)",
+	"FXSR (FXSAVE and FXSTOR instructions supported)",
+	"SSE (Streaming SIMD extensions)",
+	"SSE2 (Streaming SIMD extensions 2)",
+	"SS (Self-snoop)",
+	"HTT (Multi-threading)",
+	"TM (Thermal monitor supported)",
+	NULL, /* 30 */
+	"PBE (Pending break enabled)" /* 31 */
+};
+
+static void dmi_processor_id(struct br_context* context, const struct dmi_header* h)
 {
-	char flagsPie[9999] = "";
 	char processorIDPie[999] = "";
 
-	/* Intel AP-485 revision 36, table 2-4 */
-	static const char* flags[32] = {
-			"FPU (Floating-point unit on-chip)", /* 0 */
-			"VME (Virtual mode extension)",
-			"DE (Debugging extension)",
-			"PSE (Page size extension)",
-			"TSC (Time stamp counter)",
-			"MSR (Model specific registers)",
-			"PAE (Physical address extension)",
-			"MCE (Machine check exception)",
-			"CX8 (CMPXCHG8 instruction supported)",
-			"APIC (On-chip APIC hardware supported)",
-			NULL, /* 10 */
-			"SEP (Fast system call)",
-			"MTRR (Memory type range registers)",
-			"PGE (Page global enable)",
-			"MCA (Machine check architecture)",
-			"CMOV (Conditional move instruction supported)",
-			"PAT (Page attribute table)",
-			"PSE-36 (36-bit page size extension)",
-			"PSN (Processor serial number present and enabled)",
-			"CLFSH (CLFLUSH instruction supported)",
-			NULL, /* 20 */
-			"DS (Debug store)",
-			"ACPI (ACPI supported)",
-			"MMX (MMX technology supported)",
-			"FXSR (FXSAVE and FXSTOR instructions supported)",
-			"SSE (Streaming SIMD extensions)",
-			"SSE2 (Streaming SIMD extensions 2)",
-			"SS (Self-snoop)",
-			"HTT (Multi-threading)",
-			"TM (Thermal monitor supported)",
-			NULL, /* 30 */
-			"PBE (Pending break enabled)" /* 31 */
-	};
 	const u8* data = h->data;
 	const u8* p = data + 0x08;
 	enum cpuid_type sig = dmi_get_cpuid_type(h);
@@ -1578,25 +1583,27 @@ static void dmi_processor_id(const struct dmi_header* h)
 	}
 
 	br_safe_sprintf(processorIDPie, 999, "%02X %02X %02X %02X %02X %02X %02X %02X", p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7]);
-	copy_to_structure_char(&centralprocessinguint.cpuid, processorIDPie);
+	copy_to_structure_char(context, &context->centralprocessinguint.cpuid, processorIDPie);
 
-	dmi_print_cpuid(pr_attr, "Signature", sig, p);
+	dmi_print_cpuid(context, pr_attr, "Signature", sig, p);
 
 	if (sig != cpuid_x86_intel && sig != cpuid_x86_amd)
 	{
-		br_safe_sprintf(flagsPie, 9999, "UNKNOWN");
-		copy_to_structure_char(&centralprocessinguint.cpuflags, flagsPie);
+		copy_to_structure_char(context, &context->centralprocessinguint.cpuflags, "UNKNOWN");
 		return;
 	}
 
-	edx = DWORD(p + 4);
-	if ((edx & 0xBFEFFBFF) == 0)
+	// Bits 10, 20 and 30 are reserved
+	edx = DWORD(p + 4) & 0xBFEFFBFF;
+	context->centralprocessinguint.cpuflagsmask = edx;
+
+	if (edx == 0)
 	{
 		if (bDisplayOutput)
 		{
 			pr_list_start("Flags", "None");
 		}
-		br_safe_sprintf(flagsPie, 9999, "None");
+		copy_to_structure_char(context, &context->centralprocessinguint.cpuflags, "None");
 	}
 	else
 	{
@@ -1605,36 +1612,23 @@ static void dmi_processor_id(const struct dmi_header* h)
 		if (bDisplayOutput)
 		{
 			pr_list_start("Flags", NULL);
-		}
 
-		for (i = 0; i <= 31; i++)
-		{
-			if (flags[i] != NULL && edx & (1 << i))
+			for (i = 0; i <= 31; i++)
 			{
-				if (bDisplayOutput)
-				{
-					pr_list_item("%s", flags[i]);
-				}
-				char temponFlag[100];
-				br_safe_sprintf(temponFlag, 100, "%s", flags[i]);
-
-				if (i == 0)
-				{
-					br_safe_sprintf(flagsPie, 100, "%s", flags[i]);
-					//generate_multiline_buffer(flagsPie, (char* const)temponFlag, '\n');
-				}
-				else
+				if (edx & (1u << i))
 				{
-					generate_multiline_buffer(flagsPie, (char* const)temponFlag, '\n');
+					pr_list_item("%s", processorFlags[i]);
 				}
 			}
 		}
+
+		// The lines are rendered out of the mask once asked for, see render_cpu_flags()
+		context->centralprocessinguint.cpuflags = NULL;
 	}
 	pr_list_end();
-	copy_to_structure_char(&centralprocessinguint.cpuflags, flagsPie);
 }
 
-static void dmi_processor_voltage(const char* attr, u8 code)
+static void dmi_processor_voltage(struct br_context* context, const char* attr, u8 code)
 {
 	char voltagePie[100];
 
@@ -1653,6 +1647,7 @@ static void dmi_processor_voltage(const char* attr, u8 code)
 			pr_attr(attr, "%.1f V", (float)(code & 0x7f) / 10);
 		}
 		br_safe_sprintf(voltagePie, 100, "%.1f V", (float)(code & 0x7f) / 10);
+		context->centralprocessinguint.operatingvoltagemv = (code & 0x7f) * 100;
 	}
 	else if ((code & 0x07) == 0x00)
 	{
@@ -1684,10 +1679,10 @@ static void dmi_processor_voltage(const char* attr, u8 code)
 			br_safe_sprintf(voltagePie, 100, "%s", voltage_str);
 		}
 	}
-	copy_to_structure_char(&centralprocessinguint.operatingvoltage, voltagePie);
+	copy_to_structure_char(context, &context->centralprocessinguint.operatingvoltage, voltagePie);
 }
 
-static void dmi_processor_frequency(const char* attr, const u8* p, char* const writebuffer)
+static void dmi_processor_frequency(struct br_context* context, const char* attr, const u8* p, char* const writebuffer)
 {
 	char frequencyPie[14];
 	u16 code = WORD(p);
@@ -1728,7 +1723,7 @@ static void dmi_processor_frequency(const char* attr, const u8* p, char* const w
 			}
 		}
 	}
-	copy_to_structure_char((char**)writebuffer, frequencyPie);
+	copy_to_structure_char(context, (char**)writebuffer, frequencyPie);
 }
 
 /* code is assumed to be a 3-bit value */
@@ -1836,7 +1831,7 @@ static void dmi_processor_cache(const char* attr, u16 code, const char* level,
 		pr_attr(attr, "0x%04X", code);
 }
 
-static void dmi_processor_characteristics(const char* attr, u16 code)
+static void dmi_processor_characteristics(struct br_context* context, const char* attr, u16 code)
 {
 	char processorCharactersticsPie[1000] = "";
 
@@ -1895,7 +1890,7 @@ static void dmi_processor_characteristics(const char* attr, u16 code)
 			pr_list_end();
 		}
 	}
-	copy_to_structure_char(&centralprocessinguint.characterstics, processorCharactersticsPie);
+	copy_to_structure_char(context, &context->centralprocessinguint.characterstics, processorCharactersticsPie);
 }
 
 /*
@@ -2164,38 +2159,67 @@ static void dmi_cache_size_2(const char* attr, u32 code)
 	dmi_print_memory_size(attr, size, 1);
 }
 
+static void dmi_cache_size(const char* attr, u16 code)
+{
+	dmi_cache_size_2(attr,
+		(((u32)code & 0x8000LU) << 16) | (code & 0x7FFFLU));
+}
+
+// Same as above, in bytes
+static unsigned long long dmi_cache_size_bytes(u32 code)
+{
+	if (code & 0x80000000)
+	{
+		return (unsigned long long)(code & 0x7FFFFFFFLU) << 16;
+	}
+
+	return (unsigned long long)code << 10;
+}
+
+/* 7.8.2 */
+static const char* cacheTypes[] = {
+	"Other", /* 0 */
+	"Unknown",
+	"Non-burst",
+	"Burst",
+	"Pipeline Burst",
+	"Synchronous",
+	"Asynchronous" /* 6 */
+};
+
+// The types, space separated, into typeString (70 bytes hold all of them)
+static const char* dmi_cache_types_flat(u16 code, char* typeString)
+{
+	int i, off = 0;
+
+	if ((code & 0x007F) == 0)
+		return "None";
+
+	for (i = 0; i <= 6; i++)
+	{
+		if (code & (1 << i))
+		{
+			/* Insert space if not the first value */
+			off += br_safe_sprintf(typeString + off, 70 - off,
+				off ? " %s" : "%s",
+				cacheTypes[i]);
+		}
+	}
+
+	return typeString;
+}
+
 static void dmi_cache_types(const char* attr, u16 code, int flat)
 {
-	/* 7.8.2 */
-	static const char* types[] = {
-		"Other", /* 0 */
-		"Unknown",
-		"Non-burst",
-		"Burst",
-		"Pipeline Burst",
-		"Synchronous",
-		"Asynchronous" /* 6 */
-	};
+	const char** types = cacheTypes;
 
 	if ((code & 0x007F) == 0)
 		pr_attr(attr, "None");
 	else if (flat)
 	{
 		char type_str[70];
-		int i, off = 0;
 
-		for (i = 0; i <= 6; i++)
-		{
-			if (code & (1 << i))
-			{
-				/* Insert space if not the first value */
-				off += br_safe_sprintf(type_str + off, 70,
-					off ? " %s" : "%s",
-					types[i]);
-			}
-		}
-		if (off)
-			pr_attr(attr, type_str);
+		pr_attr(attr, "%s", dmi_cache_types_flat(code, type_str));
 	}
 	else
 	{
@@ -2858,7 +2882,7 @@ static void dmi_system_configuration_options(const struct dmi_header* h)
  * 7.14 BIOS Language Information (Type 13)
  */
 
-static void dmi_bios_languages(const struct dmi_header* h)
+static void dmi_bios_languages(struct br_context* context, const struct dmi_header* h)
 {
 	char languagePie[11911] = "";
 
@@ -2882,7 +2906,7 @@ static void dmi_bios_languages(const struct dmi_header* h)
 		}
 	}
 
-	copy_to_structure_char(&mblanguagemodules.supportedlanguagemodules, languagePie);
+	copy_to_structure_char(context, &context->mblanguagemodules.supportedlanguagemodules, languagePie);
 }
 
 static const char* dmi_bios_language_format(u8 code)
@@ -3155,7 +3179,7 @@ static void dmi_memory_device_width(const char* attr, u16 code)
 		pr_attr(attr, "%u bits", code);
 }
 
-static void dmi_memory_device_size(u16 code, char* const writebuffer)
+static void dmi_memory_device_size(struct br_context* context, u16 code, char* const writebuffer)
 {
 	char characteristicSizePie[14];
 
@@ -3189,10 +3213,10 @@ static void dmi_memory_device_size(u16 code, char* const writebuffer)
 		br_safe_sprintf(characteristicSizePie, 14, "%lu %s", dmi_compute_memory_size_numerical_part(s), dmi_compute_memory_size_units_or_dimensions_part(s, 1));
 	}
 
-	copy_to_structure_char((char**)writebuffer, characteristicSizePie);
+	copy_to_structure_char(context, (char**)writebuffer, characteristicSizePie);
 }
 
-static void dmi_memory_device_extended_size(u32 code, char* const writebuffer)
+static void dmi_memory_device_extended_size(struct br_context* context, u32 code, char* const writebuffer)
 {
 	code &= 0x7FFFFFFFUL;
 
@@ -3217,7 +3241,7 @@ static void dmi_memory_device_extended_size(u32 code, char* const writebuffer)
 		{
 			pr_attr("Size", "%lu GB", (unsigned long)code >> 10);
 		}
-		br_safe_sprintf(characteristicSizePie, 14, "%lu MB", (unsigned long)code >> 10);
+		br_safe_sprintf(characteristicSizePie, 14, "%lu GB", (unsigned long)code >> 10);
 	}
 	else
 	{
@@ -3225,13 +3249,13 @@ static void dmi_memory_device_extended_size(u32 code, char* const writebuffer)
 		{
 			pr_attr("Size", "%lu TB", (unsigned long)code >> 20);
 		}
-		br_safe_sprintf(characteristicSizePie, 14, "%lu MB", (unsigned long)code >> 20);
+		br_safe_sprintf(characteristicSizePie, 14, "%lu TB", (unsigned long)code >> 20);
 	}
 
-	copy_to_structure_char((char**)writebuffer, characteristicSizePie);
+	copy_to_structure_char(context, (char**)writebuffer, characteristicSizePie);
 }
 
-static void dmi_memory_voltage_value(const char* attr, u16 code, char* const writebuffer)
+static void dmi_memory_voltage_value(struct br_context* context, const char* attr, u16 code, char* const writebuffer)
 {
 	// Lemme recreate Y2K scenario, khe khe
 	char characteristicVoltage[6];
@@ -3255,7 +3279,7 @@ static void dmi_memory_voltage_value(const char* attr, u16 code, char* const wri
 
 	if (writebuffer != NULL)
 	{
-		copy_to_structure_char((char**)writebuffer, characteristicVoltage);
+		copy_to_structure_char(context, (char**)writebuffer, characteristicVoltage);
 	}
 }
 
@@ -3407,7 +3431,13 @@ static void dmi_memory_device_type_detail(u16 code)
 	}
 }
 
-static void dmi_memory_device_speed(const char* attr, u16 code1, u32 code2, char* const writebuffer)
+/* The speed, in MT/s, of dmi_memory_device_speed() below. 0 if unknown */
+static unsigned int dmi_memory_device_speed_value(u16 code1, u32 code2)
+{
+	return code1 == 0xFFFF ? code2 : code1;
+}
+
+static void dmi_memory_device_speed(struct br_context* context, const char* attr, u16 code1, u32 code2, char* const writebuffer)
 {
 	char characteristicSpeed[14];
 
@@ -3450,7 +3480,7 @@ static void dmi_memory_device_speed(const char* attr, u16 code1, u32 code2, char
 		}
 	}
 
-	copy_to_structure_char((char**)writebuffer, characteristicSpeed);
+	copy_to_structure_char(context, (char**)writebuffer, characteristicSpeed);
 }
 
 static void dmi_memory_technology(u8 code)
@@ -4107,6 +4137,9 @@ static void dmi_fixup_type_34(struct dmi_header* h, int display)
 			fprintf(stderr, "Invalid entry length (%u). Fixed up to %u.\n", 0x10, 0x0B);
 		}
 		h->length = 0x0B;
+
+		// String offsets were gathered for the declared length
+		h->strings = NULL;
 	}
 }
 
@@ -4855,323 +4888,546 @@ struct graphics_processing_unit graphicsprocessingunit;
 static mach_port_t macPort = MACH_PORT_NULL;
 #endif
 
-static int bAlreadyRun = 0;
-static unsigned int ramCounter;
+// What electronics_spit() and friends decode into, mirrored into the globals above
+static struct br_context defaultContext;
 
-/***********************************************************************************************************
- *
- * BiosReader's Global Initialization routine
- *
- **********************************************************************************************************
- */
+static void decode_category(struct br_context* context, enum bios_reader_information_classification informationCategory);
+static void release_loaded_table(struct br_context* context);
+static int dump_decode(struct br_context* context);
+static int cached_smbios3_decode(struct br_context* context, u8* buf, size_t length);
+static void index_table_of_cached_inventory(struct br_context* context);
 
-static void global_initialization_of_structs()
-{
-	biosinformation.bIsFilled = 0;
-	biosinformation.vendor = NULL;
-	biosinformation.biosreleasedate = NULL;
-	biosinformation.biosromsize = NULL;
-	biosinformation.version = NULL;
-	br_safe_sprintf(biosinformation.bioscharacteristics, 9999, "");
-
-	turingmachinesystemmemory.bIsFilled = 0;
-	turingmachinesystemmemory.mounting_location = NULL;
-	turingmachinesystemmemory.number_of_ram_or_system_memory_devices = 0;
-	turingmachinesystemmemory.total_grand_capacity = NULL;
-
-	// See allocate_and_initialize_memory_structure() for initialization random_access_memory structs
-
-	randomaccessmemory = NULL;
-	ramCounter = 0;
-
-	centralprocessinguint.bIsFilled = 0;
-	centralprocessinguint.assettag = NULL;
-	centralprocessinguint.corescount = NULL;
-	centralprocessinguint.cpuflags = NULL;
-	centralprocessinguint.cpuid = NULL;
-	centralprocessinguint.cputype = NULL;
-	centralprocessinguint.currentspeed = NULL;
-	centralprocessinguint.designation = NULL;
-	centralprocessinguint.enabledcorescount = NULL;
-	centralprocessinguint.externalclock = NULL;
-	centralprocessinguint.manufacturer = NULL;
-	centralprocessinguint.maximumspeed = NULL;
-	centralprocessinguint.operatingvoltage = NULL;
-	centralprocessinguint.partnumber = NULL;
-	centralprocessinguint.processingfamily = NULL;
-	centralprocessinguint.characterstics = NULL;
-	centralprocessinguint.serialnumber = NULL;
-	centralprocessinguint.signature = NULL;
-	centralprocessinguint.threadcount = NULL;
-	centralprocessinguint.version = NULL;
-
-	graphicsprocessingunit.bIsFilled = 0;
-	graphicsprocessingunit.vendor = NULL;
-	graphicsprocessingunit.gpuModel = NULL;
-	graphicsprocessingunit.grandtotalvideomemory = NULL;
-
-	mblanguagemodules.bIsFilled = 0;
-	mblanguagemodules.currentactivemodule = NULL;
-	mblanguagemodules.supportedlanguagemodules = NULL;
+/*
+ * Nothing known about the processor, no caches
+ */
+static void initialize_processor(struct central_processing_unit* processor)
+{
+	processor->bIsFilled = 0;
+	processor->assettag = NULL;
+	processor->corescount = NULL;
+	processor->cpuflags = NULL;
+	processor->cpuflagsmask = 0;
+	processor->cpuid = NULL;
+	processor->cputype = NULL;
+	processor->currentspeed = NULL;
+	processor->designation = NULL;
+	processor->enabledcorescount = NULL;
+	processor->externalclock = NULL;
+	processor->manufacturer = NULL;
+	processor->maximumspeed = NULL;
+	processor->operatingvoltage = NULL;
+	processor->partnumber = NULL;
+	processor->processingfamily = NULL;
+	processor->characterstics = NULL;
+	processor->serialnumber = NULL;
+	processor->signature = NULL;
+	processor->threadcount = NULL;
+	processor->version = NULL;
+	processor->operatingvoltagemv = 0;
+	processor->externalclockmhz = 0;
+	processor->maximumspeedmhz = 0;
+	processor->currentspeedmhz = 0;
+	processor->cores = 0;
+	processor->enabledcores = 0;
+	processor->threads = 0;
+	processor->handle = 0xFFFF;
+	processor->l1cachehandle = 0xFFFF;
+	processor->l2cachehandle = 0xFFFF;
+	processor->l3cachehandle = 0xFFFF;
 }
 
 /***********************************************************************************************************
  *
- * BiosReader's Global Reset routine
+ * BiosReader's Global Initialization routine
  *
  **********************************************************************************************************
  */
 
-void reset_electronics_structures()
+static void global_initialization_of_structs(struct br_context* context)
 {
-	bAlreadyRun = 0;
+	context->biosinformation.bIsFilled = 0;
+	context->biosinformation.vendor = NULL;
+	context->biosinformation.biosreleasedate = NULL;
+	context->biosinformation.biosromsize = NULL;
+	context->biosinformation.version = NULL;
+	context->biosinformation.bioscharacteristics = NULL;
+	context->biosinformation.characteristics = 0;
 
-	// Bios information clearence
-	biosinformation.bIsFilled = 0;
-	free(biosinformation.vendor);
-	free(biosinformation.version);
-	free(biosinformation.biosreleasedate);
-	free(biosinformation.biosromsize);
+	context->turingmachinesystemmemory.bIsFilled = 0;
+	context->turingmachinesystemmemory.mounting_location = NULL;
+	context->turingmachinesystemmemory.number_of_ram_or_system_memory_devices = 0;
+	context->turingmachinesystemmemory.total_grand_capacity = NULL;
+	context->turingmachinesystemmemory.total_grand_capacity_bytes = 0;
+	context->turingmachinesystemmemory.use = NULL;
+	context->turingmachinesystemmemory.handle = 0xFFFF;
+	context->turingmachinesystemmemory.errorhandle = 0xFFFF;
 
-	// Ram clearance
-	for (unsigned int i = 0; i < turingmachinesystemmemory.number_of_ram_or_system_memory_devices; i++)
-	{
-		randomaccessmemory[i].bIsFilled = 0;
+	// See allocate_and_initialize_memory_structure(context) for initialization random_access_memory structs
 
-		if (randomaccessmemory[i].ramsize != NULL)
-		{
-			free(randomaccessmemory[i].ramsize);
-		}
+	context->randomaccessmemory = NULL;
+	context->ramCounter = 0;
 
-		if (randomaccessmemory[i].formfactor != NULL)
-		{
-			free(randomaccessmemory[i].formfactor);
-		}
+	context->processorcaches = NULL;
+	context->cacheCount = 0;
+	context->cacheCounter = 0;
 
-		if (randomaccessmemory[i].locator != NULL)
-		{
-			free(randomaccessmemory[i].locator);
-		}
+	initialize_processor(&context->centralprocessinguint);
+	context->processors = NULL;
+	context->processorCount = 0;
+	context->processorCounter = 0;
 
-		if (randomaccessmemory[i].banklocator != NULL)
-		{
-			free(randomaccessmemory[i].banklocator);
-		}
+	context->memoryarrays = NULL;
+	context->arrayCount = 0;
+	context->arrayCounter = 0;
 
-		if (randomaccessmemory[i].memoryspeed != NULL)
-		{
-			free(randomaccessmemory[i].memoryspeed);
-		}
+	memset(context->records, 0, sizeof(context->records));
 
-		if (randomaccessmemory[i].rank != NULL)
-		{
-			free(randomaccessmemory[i].rank);
-		}
+	memset(&context->processorColumns, 0, sizeof(context->processorColumns));
+	memset(&context->memoryArrayColumns, 0, sizeof(context->memoryArrayColumns));
+	memset(&context->memoryDeviceColumns, 0, sizeof(context->memoryDeviceColumns));
+	context->bColumnsBuilt = 0;
 
-		if (randomaccessmemory[i].assettag != NULL)
-		{
-			free(randomaccessmemory[i].assettag);
-		}
+	context->graphicsprocessingunit.bIsFilled = 0;
+	context->graphicsprocessingunit.vendor = NULL;
+	context->graphicsprocessingunit.gpuModel = NULL;
+	context->graphicsprocessingunit.grandtotalvideomemory = NULL;
+	context->graphicsprocessingunits = NULL;
+	context->gpuCounter = 0;
 
-		if (randomaccessmemory[i].configuredmemoryspeed != NULL)
-		{
-			free(randomaccessmemory[i].configuredmemoryspeed);
-		}
+	context->mblanguagemodules.bIsFilled = 0;
+	context->mblanguagemodules.currentactivemodule = NULL;
+	context->mblanguagemodules.supportedlanguagemodules = NULL;
 
-		if (randomaccessmemory[i].manufacturer != NULL)
-		{
-			free(randomaccessmemory[i].manufacturer);
-		}
+	// Vendor and CPUID type are what the table about to be read says
+	memset(&context->oem, 0, sizeof(context->oem));
+}
 
-		if (randomaccessmemory[i].operatingvoltage != NULL)
-		{
-			free(randomaccessmemory[i].operatingvoltage);
-		}
+/***********************************************************************************************************
+ *
+ * BiosReader's Global Reset routine
+ *
+ **********************************************************************************************************
+ */
 
-		if (randomaccessmemory[i].partnumber != NULL)
-		{
-			free(randomaccessmemory[i].partnumber);
-		}
+void br_context_reset(struct br_context* context)
+{
+	context->bAlreadyRun = 0;
 
-		if (randomaccessmemory[i].ramtype != NULL)
-		{
-			free(randomaccessmemory[i].ramtype);
-		}
+	// Every string, and the array of memory devices, lives in the arena. Gone in one go
+	br_arena_reset(&context->decodeArena);
+	br_intern_clear(&context->stringPool);
 
-		if (randomaccessmemory[i].serialnumber != NULL)
-		{
-			free(randomaccessmemory[i].serialnumber);
-		}
-	}
+	// Categories are decoded afresh, out of a freshly read table
+	context->decodedCategories = 0;
+	release_loaded_table(context);
+	dmi_index_clear(&context->tableIndex);
+	context->bTableLeftOnDisk = 0;
 
-	if (randomaccessmemory != NULL)
-	{
-		free(randomaccessmemory);
-	}
-	ramCounter = 0;
+	// Bios information, ram, system memory, processor, gpu and language clearance
+	global_initialization_of_structs(context);
+}
 
-	// System memory clearance
-	turingmachinesystemmemory.bIsFilled = 0;
-	turingmachinesystemmemory.number_of_ram_or_system_memory_devices = 0;
+/***********************************************************************************************************
+ *
+ * The globals are what the applications, written before contexts came along, look at. They are copies
+ * of the default context's view (the strings and arrays being shared, not duplicated), refreshed after
+ * every call made through the old API.
+ *
+ **********************************************************************************************************
+ */
 
-	if (turingmachinesystemmemory.mounting_location != NULL)
-	{
-		free(turingmachinesystemmemory.mounting_location);
-	}
+static void mirror_default_context()
+{
+	biosinformation = defaultContext.biosinformation;
+	mblanguagemodules = defaultContext.mblanguagemodules;
+	randomaccessmemory = defaultContext.randomaccessmemory;
+	turingmachinesystemmemory = defaultContext.turingmachinesystemmemory;
+	centralprocessinguint = defaultContext.centralprocessinguint;
+	graphicsprocessingunit = defaultContext.graphicsprocessingunit;
+}
 
-	if (turingmachinesystemmemory.total_grand_capacity != NULL)
-	{
-		free(turingmachinesystemmemory.total_grand_capacity);
-	}
+void reset_electronics_structures()
+{
+	br_context_reset(&defaultContext);
+	mirror_default_context();
+}
 
-	// Processor clearance
-	centralprocessinguint.bIsFilled = 0;
+/***************************************************************************************************************************
+ *
+ * Contexts are to be had from here only. One per table being decoded (or per thread decoding), and they
+ * are not to be shared between threads without the caller's own locking.
+ *
+ * @return  br_context*                  A fresh context, nothing read yet. NULL if out of memory
+ *
+ ***************************************************************************************************************************
+ */
 
-	if (centralprocessinguint.assettag != NULL)
-	{
-		free(centralprocessinguint.assettag);
-	}
+struct br_context* br_context_create()
+{
+	struct br_context* context = calloc(1, sizeof(struct br_context));
 
-	if (centralprocessinguint.corescount != NULL)
+	if (context == NULL)
 	{
-		free(centralprocessinguint.corescount);
+		return NULL;
 	}
 
-	if (centralprocessinguint.cpuflags != NULL)
-	{
-		free(centralprocessinguint.cpuflags);
-	}
+	global_initialization_of_structs(context);
 
-	if (centralprocessinguint.cpuid != NULL)
-	{
-		free(centralprocessinguint.cpuid);
-	}
+	return context;
+}
+
+/***************************************************************************************************************************
+ *
+ * Hands every bit of memory the context holds back (the table, its index and the decoded strings). Pointers
+ * obtained through the context are not to be touched afterwards.
+ *
+ * @param context                        The context to be done with, NULL is fine
+ *
+ ***************************************************************************************************************************
+ */
 
-	if (centralprocessinguint.cputype != NULL)
+void br_context_destroy(struct br_context* context)
+{
+	if (context == NULL)
 	{
-		free(centralprocessinguint.cputype);
+		return;
 	}
 
-	if (centralprocessinguint.currentspeed != NULL)
+	release_loaded_table(context);
+	dmi_index_release(&context->tableIndex);
+	br_intern_release(&context->stringPool);
+	br_arena_release(&context->decodeArena);
+
+	free(context);
+}
+
+/***************************************************************************************************************************
+ *
+ * A special array-of-structs returning routine!
+ *
+ * @param context                        The context to look into
+ * @param counter                        The counting number of array element (which is struct) which needs be returned
+ * @return  random_access_memory*        The pointer to the element if found, else NULL
+ *
+ ***************************************************************************************************************************
+ */
+
+struct random_access_memory* br_fetch_memory_device(struct br_context* context, unsigned int counter)
+{
+	if (context->bAlreadyRun == 0 || !(context->decodedCategories & (1u << ps_systemmemory)))
 	{
-		free(centralprocessinguint.currentspeed);
+		br_decode(context, ps_systemmemory);
 	}
 
-	if (centralprocessinguint.designation != NULL)
+	if (counter >= context->turingmachinesystemmemory.number_of_ram_or_system_memory_devices)
 	{
-		free(centralprocessinguint.designation);
+		return NULL;
 	}
 
-	if (centralprocessinguint.enabledcorescount != NULL)
+	return &context->randomaccessmemory[counter];
+}
+
+struct random_access_memory* fetch_access_memory_members(unsigned int counter)
+{
+	struct random_access_memory* memoryDevice = br_fetch_memory_device(&defaultContext, counter);
+
+	mirror_default_context();
+
+	return memoryDevice;
+}
+
+struct central_processing_unit* br_fetch_processor(struct br_context* context, unsigned int counter)
+{
+	if (context->bAlreadyRun == 0 || !(context->decodedCategories & (1u << ps_processor)))
 	{
-		free(centralprocessinguint.enabledcorescount);
+		br_decode(context, ps_processor);
 	}
 
-	if (centralprocessinguint.externalclock != NULL)
+	if (counter >= context->processorCount)
 	{
-		free(centralprocessinguint.externalclock);
+		return NULL;
 	}
 
-	if (centralprocessinguint.manufacturer != NULL)
+	render_cpu_flags(context);
+
+	return &context->processors[counter];
+}
+
+struct turing_machine_system_memory* br_fetch_memory_array(struct br_context* context, unsigned int counter)
+{
+	if (context->bAlreadyRun == 0 || !(context->decodedCategories & (1u << ps_systemmemory)))
 	{
-		free(centralprocessinguint.manufacturer);
+		br_decode(context, ps_systemmemory);
 	}
 
-	if (centralprocessinguint.maximumspeed != NULL)
+	if (counter >= context->arrayCount)
 	{
-		free(centralprocessinguint.maximumspeed);
+		return NULL;
 	}
 
-	if (centralprocessinguint.operatingvoltage != NULL)
+	return &context->memoryarrays[counter];
+}
+
+struct cpu_cache* br_fetch_processor_cache(struct br_context* context, unsigned int counter)
+{
+	if (context->bAlreadyRun == 0 || !(context->decodedCategories & (1u << ps_processor)))
 	{
-		free(centralprocessinguint.operatingvoltage);
+		br_decode(context, ps_processor);
 	}
 
-	if (centralprocessinguint.partnumber != NULL)
+	if (counter >= context->cacheCount)
 	{
-		free(centralprocessinguint.partnumber);
+		return NULL;
 	}
 
-	if (centralprocessinguint.processingfamily != NULL)
+	return &context->processorcaches[counter];
+}
+
+unsigned int br_string_id(struct br_context* context, const char* string)
+{
+	return br_intern_id(&context->stringPool, string);
+}
+
+const char* br_string_of_id(struct br_context* context, unsigned int id)
+{
+	return br_intern_string(&context->stringPool, id);
+}
+
+/***************************************************************************************************************************
+ *
+ * The cache with the given handle. Straight through the handle index when the table has been walked, else
+ * (the inventory came out of the on-disk cache, no table at hand) over the few caches there are.
+ *
+ * @return cpu_cache*                    NULL if there is no such cache (0xFFFF being the handle of none)
+ *
+ ***************************************************************************************************************************
+ */
+
+static struct cpu_cache* processor_cache_of_handle(struct br_context* context, unsigned int handle)
+{
+	const struct dmi_structure_entry* entry;
+
+	if (handle >= 0xFFFF)
 	{
-		free(centralprocessinguint.processingfamily);
+		return NULL;
 	}
 
-	if (centralprocessinguint.characterstics != NULL)
+	if (context->tableIndex.count != 0)
 	{
-		free(centralprocessinguint.characterstics);
+		entry = dmi_index_of_handle(&context->tableIndex, (u16)handle);
+
+		if (entry != NULL && entry->type == 7 && entry->ordinal < context->cacheCount
+			&& context->processorcaches[entry->ordinal].handle == handle)
+		{
+			return &context->processorcaches[entry->ordinal];
+		}
+
+		return NULL;
 	}
 
-	if (centralprocessinguint.serialnumber != NULL)
+	for (unsigned int c = 0; c < context->cacheCount; c++)
 	{
-		free(centralprocessinguint.serialnumber);
+		if (context->processorcaches[c].handle == handle)
+		{
+			return &context->processorcaches[c];
+		}
 	}
 
-	if (centralprocessinguint.signature != NULL)
+	return NULL;
+}
+
+unsigned int br_processor_caches(struct br_context* context, const struct central_processing_unit* processor,
+	const struct cpu_cache* caches[3])
+{
+	const unsigned int handles[3] = { processor->l1cachehandle, processor->l2cachehandle, processor->l3cachehandle };
+	unsigned int found = 0;
+
+	if (context->bAlreadyRun == 0 || !(context->decodedCategories & (1u << ps_processor)))
 	{
-		free(centralprocessinguint.signature);
+		br_decode(context, ps_processor);
 	}
 
-	if (centralprocessinguint.threadcount != NULL)
+	for (unsigned int level = 0; level < 3; level++)
 	{
-		free(centralprocessinguint.threadcount);
+		caches[level] = processor_cache_of_handle(context, handles[level]);
+
+		if (caches[level] != NULL)
+		{
+			found++;
+		}
 	}
 
-	if (centralprocessinguint.version != NULL)
+	return found;
+}
+
+unsigned int br_memory_devices_of_array(struct br_context* context, const struct turing_machine_system_memory* array,
+	const struct random_access_memory** devices, unsigned int capacity)
+{
+	unsigned int found = 0;
+
+	if (context->bAlreadyRun == 0 || !(context->decodedCategories & (1u << ps_systemmemory)))
 	{
-		free(centralprocessinguint.version);
+		br_decode(context, ps_systemmemory);
 	}
 
-	// gpu clearence
-	graphicsprocessingunit.bIsFilled = 0;
+	if (array->handle >= 0xFFFF)
+	{
+		return 0;
+	}
 
-	if (graphicsprocessingunit.gpuModel != NULL)
+	// One pass, the devices carry the handle of their array
+	for (unsigned int d = 0; d < context->turingmachinesystemmemory.number_of_ram_or_system_memory_devices; d++)
 	{
-		free(graphicsprocessingunit.gpuModel);
+		if (context->randomaccessmemory[d].arrayhandle == array->handle)
+		{
+			if (found < capacity)
+			{
+				devices[found] = &context->randomaccessmemory[d];
+			}
+			found++;
+		}
 	}
 
-	if (graphicsprocessingunit.vendor != NULL)
+	return found;
+}
+
+/***************************************************************************************************************************
+ *
+ * Same as above, for graphics processing units. Machines do come with more than one of them.
+ *
+ * @param context                        The context to look into
+ * @param counter                        The counting number of the graphics processing unit
+ * @return  graphics_processing_unit*    The pointer to the element if found, else NULL
+ *
+ ***************************************************************************************************************************
+ */
+
+struct graphics_processing_unit* br_fetch_graphics_processing_unit(struct br_context* context, unsigned int counter)
+{
+	if (context->bAlreadyRun == 0 || !(context->decodedCategories & (1u << ps_graphicscard)))
 	{
-		free(graphicsprocessingunit.vendor);
+		br_decode(context, ps_graphicscard);
 	}
 
-	if (graphicsprocessingunit.grandtotalvideomemory != NULL)
+	if (counter >= context->gpuCounter)
 	{
-		free(graphicsprocessingunit.grandtotalvideomemory);
+		return NULL;
 	}
 
-	// language clearence
-	mblanguagemodules.bIsFilled = 0;
+	return &context->graphicsprocessingunits[counter];
+}
+
+struct graphics_processing_unit* fetch_graphics_processing_unit_members(unsigned int counter)
+{
+	struct graphics_processing_unit* graphicsCard = br_fetch_graphics_processing_unit(&defaultContext, counter);
+
+	mirror_default_context();
+
+	return graphicsCard;
+}
+
+/***************************************************************************************************************************
+ *
+ * Pin a buffer for the DMI table to be read into on every (re)run. Tables which can be mapped (dump files and the
+ * like) are decoded in place regardless; tables which can't (sysfs, Windows firmware table API) are then read into
+ * this buffer instead of a freshly allocated one, so refreshing the electronics costs no heap traffic for the table.
+ *
+ * @param context                        The context the buffer is pinned for. Contexts can't share a buffer
+ * @param buffer                         Caller owned storage, must outlive the queries. NULL to unpin
+ * @param size                           Capacity of buffer in bytes. Tables larger than this are read the usual way
+ *
+ ***************************************************************************************************************************
+ */
+
+void br_context_pin_table_buffer(struct br_context* context, void* buffer, size_t size)
+{
+	context->pinnedTableBuffer = buffer;
+	context->pinnedTableBufferSize = buffer != NULL ? size : 0;
+}
+
+void br_pin_table_buffer(void* buffer, size_t size)
+{
+	br_context_pin_table_buffer(&defaultContext, buffer, size);
+}
+
+/***************************************************************************************************************************
+ *
+ * Have the context decode a dump (see write_dump()) instead of the table of the machine it runs on. Anything
+ * decoded so far is let go of, the next query reads the dump.
+ *
+ * @param context                        The context to point elsewhere
+ * @param dumpfile                       Path of the dump, must outlive the queries. NULL for the running machine again
+ *
+ ***************************************************************************************************************************
+ */
+
+void br_context_set_dump_file(struct br_context* context, const char* dumpfile)
+{
+	context->opt.devmem = dumpfile;
 
-	if (mblanguagemodules.supportedlanguagemodules != NULL)
+	if (dumpfile != NULL)
 	{
-		free(mblanguagemodules.supportedlanguagemodules);
+		context->opt.flags |= FLAG_FROM_DUMP;
 	}
-
-	if (mblanguagemodules.currentactivemodule != NULL)
+	else
 	{
-		free(mblanguagemodules.currentactivemodule);
+		context->opt.flags &= ~FLAG_FROM_DUMP;
 	}
+
+	br_context_reset(context);
 }
 
 /***************************************************************************************************************************
  *
- * A special array-of-structs returning routine!
+ * The running machine's table is decoded once and for all, what was decoded is kept on disk (see dmicache.h) for the
+ * queries of the processes to come, as long as the firmware stays the same. On by default.
  *
- * @param counter                        The counting number of array element (which is struct) which needs be returned
- * @return  random_access_memory*        The pointer to the element if found, else NULL
+ * @param context                        The context
+ * @param bUseCache                      0 to decode afresh every time (and leave the disk alone), 1 otherwise
  *
  ***************************************************************************************************************************
  */
 
-struct random_access_memory* fetch_access_memory_members(unsigned int counter)
+void br_context_use_cache(struct br_context* context, int bUseCache)
+{
+	context->bNoCache = !bUseCache;
+}
+
+/***************************************************************************************************************************
+ *
+ * Where the context's decode is displayed (see dmioutput.h). The decoder doesn't format a thing for display
+ * without a sink, which is the default. Takes effect with the next run, after br_context_reset().
+ *
+ * @param context                        The context
+ * @param sink                           Outlives the context's queries, NULL for none
+ *
+ ***************************************************************************************************************************
+ */
+
+void br_context_set_output_sink(struct br_context* context, const struct br_output_sink* sink)
+{
+	context->outputSink = sink;
+}
+
+void br_set_output_sink(const struct br_output_sink* sink)
+{
+	br_context_set_output_sink(&defaultContext, sink);
+}
+
+char* br_format_memory_size(unsigned long long bytes, char* buffer, size_t size)
 {
-	if (counter >= turingmachinesystemmemory.number_of_ram_or_system_memory_devices)
+	static const char* units[] = { "bytes", "kB", "MB", "GB", "TB", "PB", "EB" };
+	size_t unit = 0;
+
+	while (bytes != 0 && (bytes & 0x3FF) == 0 && unit + 1 < ARRAY_SIZE(units))
 	{
-		return NULL;
+		bytes >>= 10;
+		unit++;
 	}
 
-	return &randomaccessmemory[counter];
+	snprintf(buffer, size, "%llu %s", bytes, units[unit]);
+
+	return buffer;
 }
 
 static const char* get_raw_electronics_information()
@@ -5179,36 +5435,121 @@ static const char* get_raw_electronics_information()
 	return "BLANK";
 }
 
+/****************************************************************************************************************
+ *
+ * Have the table of the context read and walked, decoding nothing out of it (see br_project()). An image of the
+ * on-disk cache holds no table, so a context yet to run keeps off the cache for this one run, and one whose
+ * inventory came out of the cache has the table read and walked now, the inventory being left as it is.
+ * @return int                                  1 if the table is at hand, 0 if there is none (Mac)
+ ****************************************************************************************************************
+ */
+
+int br_context_table_at_hand(struct br_context* context)
+{
+	if (context->bAlreadyRun == 0 || context->bTableLeftOnDisk)
+	{
+		const struct br_output_sink* previousSink = pr_bind_sink(context->outputSink);
+
+		if (context->bAlreadyRun == 0)
+		{
+			int bNoCache = context->bNoCache;
+
+			context->bNoCache = 1;
+			ashwamegha_run(context);
+			context->bNoCache = bNoCache;
+		}
+		else
+		{
+			index_table_of_cached_inventory(context);
+		}
+
+		pr_bind_sink(previousSink);
+	}
+
+	return context->loadedTable.buf != NULL;
+}
+
 /****************************************************************************************************************
  *
  * A querying function itself.
  * Iterates through entire list of electronics reported by BIOS and caches them. Multiple queries should be bit
  * faster and better this way. The routine ashwamegha_run() is run the first time this routine is called or after
- * reset_electronics_structures() is called by the application.
+ * br_context_reset() is called by the application.
+ * @param context                               The context to decode into
  * @param informationCategory                   The category of electronics related information
- * @return void*                                The pointer to the struct corresponding to the query made to
- *                                              Bios Reader (BR)
+ * @return void*                                The pointer to the struct (within context) corresponding to the
+ *                                              query made to Bios Reader (BR)
  ****************************************************************************************************************
  */
 
-void* electronics_spit(enum bios_reader_information_classification informationCategory)
+void* br_decode(struct br_context* context, enum bios_reader_information_classification informationCategory)
 {
-	if (bAlreadyRun == 0)
+	// The pr_* functions, and everything behind bDisplayOutput, go by the context's sink for now
+	const struct br_output_sink* previousSink = pr_bind_sink(context->outputSink);
+
+	if (context->bAlreadyRun == 0)
 	{
-		ashwamegha_run();
+		ashwamegha_run(context);
 	}
 
+	// Only what's asked for, and only once
+	if (!(context->decodedCategories & (1u << informationCategory)))
+	{
+		decode_category(context, informationCategory);
+	}
+
+	pr_bind_sink(previousSink);
+
 	// Experimental returning pointers
 	switch (informationCategory)
 	{
 	case ss_bios:
-		return &biosinformation;
+		render_bios_characteristics(context);
+		return &context->biosinformation;
 		break;
 
 	case pi_systemmemory:
-		return &turingmachinesystemmemory;
+		return &context->turingmachinesystemmemory;
 		break;
 
+	case ps_systemmemory:
+		return &context->randomaccessmemory;
+
+	case ps_processor:
+		render_cpu_flags(context);
+		return &context->centralprocessinguint;
+
+	case pi_bioslanguages:
+		return &context->mblanguagemodules;
+
+	case ps_graphicscard:
+		return &context->graphicsprocessingunit;
+	default:
+		return NULL;
+	}
+}
+
+/****************************************************************************************************************
+ *
+ * The querying function of old, working on the default context and handing out the globals.
+ * @param informationCategory                   The category of electronics related information
+ * @return void*                                The pointer to the global struct corresponding to the query
+ ****************************************************************************************************************
+ */
+
+void* electronics_spit(enum bios_reader_information_classification informationCategory)
+{
+	br_decode(&defaultContext, informationCategory);
+	mirror_default_context();
+
+	switch (informationCategory)
+	{
+	case ss_bios:
+		return &biosinformation;
+
+	case pi_systemmemory:
+		return &turingmachinesystemmemory;
+
 	case ps_systemmemory:
 		return &randomaccessmemory;
 
@@ -5227,65 +5568,77 @@ void* electronics_spit(enum bios_reader_information_classification informationCa
 
 /***********************************************************************************************************
  *
- * A free run to fill up all possible electronics structures to spit when the query is made!!
+ * A free run to get the electronics information at hand (the DMI table, read and indexed) for the queries
+ * to be made! Categories are then filled up on demand, see decode_category(context).
  *
  **********************************************************************************************************
  */
 
-static void ashwamegha_run()
+static void ashwamegha_run(struct br_context* context)
 {
 	// Global initialization
-	global_initialization_of_structs();
+	global_initialization_of_structs(context);
 
 	//int efi;
-	u8* buffer = NULL;
+	u8 entryPointBuffer[0x20];
 
 	// Some handle
-	opt.handle = ~0U;
+	context->opt.handle = ~0U;
 
-	// Nun standard C function
-	// Deserves a blog-post!
-#if defined (BR_LINUX_PLATFORM)
-	/*
-	 * We don't want stdout and stderr to be mixed up if both are
-	 * redirected to the same file.
-	 */
-	setlinebuf(stdout); // standard output stream
-	setlinebuf(stderr); // standard error output stream
+	// Whatever is displayed goes out at the end of the run (see dmioutput.h), in one piece
+	if (bDisplayOutput)
+	{
+		pr_document_start();
+	}
+
+	// A table saved by write_dump(), whichever machine it came from
+	if (context->opt.flags & FLAG_FROM_DUMP)
+	{
+		br_context_reset(context);
+		dump_decode(context);
+
+		if (bDisplayOutput)
+		{
+			pr_document_end();
+		}
+
+		context->bAlreadyRun = 1;
+		return;
+	}
 
+#if defined (BR_LINUX_PLATFORM)
 	/* Type of file sizes and offsets.  */
 	size_t fileSize; // Useful file size (the amount of data read)
 
 	/* Set default option values */
-	opt.handle = ~0U;
+	context->opt.handle = ~0U;
 
 	// Start from ground zero!
-	reset_electronics_structures();
+	br_context_reset(context);
 
 	fileSize = 0x20;
 	int found = 0;
 	int errorSpit = 0;
-	if ((buffer = read_file(0, &fileSize, SYS_ENTRY_FILE, &errorSpit)) != NULL)
+	// Entry point is tiny, no need to bother the heap
+	if (read_file_into(0, &fileSize, SYS_ENTRY_FILE, entryPointBuffer, &errorSpit) != NULL)
 	{
-		if (fileSize >= 24 && memcmp(buffer, "_SM3_", 5) == 0)
+		if (fileSize >= 24 && memcmp(entryPointBuffer, "_SM3_", 5) == 0)
 		{
-			if (smbios3_decode(buffer, SYS_TABLE_FILE, FLAG_NO_FILE_OFFSET))
+			if (cached_smbios3_decode(context, entryPointBuffer, fileSize))
 				found++;
 		}
 
-		if (found)
-		{
-			printf("Yeehaw, success!");
-		}
-		else
+		// Into the document when something is displayed (see dmioutput.h), nowhere otherwise: the
+		// queries tell by what they hand out, and a silent build has stdout left alone
+		if (bDisplayOutput)
 		{
-			printf("Sorry couldn't get the job done.");
+			pr_info("%s", found ? "Yeehaw, success!" : "Sorry couldn't get the job done.");
 		}
 	}
 	else if (errorSpit == 13 || errorSpit == 35 || errorSpit == 36 || errorSpit == 37 || errorSpit == 38 || errorSpit == 39) // see erno-base.h for linux and unix maybe
 	{
-		printf("Couldn't manipulate the short term privilege.\n");
-		printf("Kindly consult the friendly FOSSer.\n");
+		fprintf(stderr, "Couldn't manipulate the short term privilege.\n");
+		fprintf(stderr, "Kindly consult the friendly FOSSer.\n");
 
 		struct stat fileStatistics;
 		int result;
@@ -5294,23 +5647,25 @@ static void ashwamegha_run()
 
 		if (result == -1)
 		{
-			printf("There is something terribly wrong with the file %s, Goodbye!\n", SYS_ENTRY_FILE);
+			fprintf(stderr, "There is something terribly wrong with the file %s, Goodbye!\n", SYS_ENTRY_FILE);
+		}
+		else
+		{
+			fprintf(stderr, "The permissions of the file %s are like so %X\n", SYS_ENTRY_FILE, fileStatistics.st_mode);
 		}
-
-		printf("The permissions of the file %s are like so %X\n", SYS_ENTRY_FILE, fileStatistics.st_mode);
 	}
 	else
 	{
-		printf("There is something terribly wrong with the file %s, Goodbye!/n", SYS_ENTRY_FILE);
+		fprintf(stderr, "There is something terribly wrong with the file %s, Goodbye!\n", SYS_ENTRY_FILE);
 	}
 #endif // BR_LINUX_PLATFORM
 
 #ifdef BR_MAC_PLATFORM
-	mac_device_service_gauger();
+	mac_device_service_gauger(context);
 #endif // BR_MAC_PLATFORM
 
 #ifdef BR_WINDOWS_PLATFORM
-	PRawSMBIOSData rawInformation = get_raw_smbios_table();
+	PRawSMBIOSData rawInformation = get_raw_smbios_table(context);
 
 	// Now we shall attempt parsing of the information into Human readable data
 
@@ -5319,34 +5674,28 @@ static void ashwamegha_run()
 
 	u8* data = rawInformation->SMBIOSTableData;
 
-	dmi_table_decode(data, rawInformation->Length, structuresNumber, 8, 0);
-#endif // BR_WINDOWS_PLATFORM
+	dmi_table_decode(context, data, rawInformation->Length, structuresNumber, 8, 0);
 
-	bAlreadyRun = 1;
-}
+	// Kept till reset, the categories are decoded out of it
+	if ((u8*)rawInformation != context->pinnedTableBuffer)
+	{
+		context->loadedTable.allocation = rawInformation;
+	}
+#endif // BR_WINDOWS_PLATFORM
 
-/*************************************************************************************************
- *
- * Quite a safe way of copying, since the memory is bound to be allocated already (and auto
- * clearance later).
- *
- * @param destinationPointer      Pointer to the destination char* in appropriate struct category
- * @param sourcePointer           Pointer to the specific section of DMI data obtained
- *                                (or some relevant data), which needs be copied
- *
- *************************************************************************************************
- */
+	if (bDisplayOutput)
+	{
+		pr_document_end();
+	}
 
-static void copy_to_already_initialized_structure_char(char** destinationPointer, const char* sourcePointer)
-{
-	size_t sourceSize = sizeof(char) * strlen(sourcePointer) + 1;
-	br_safe_strcpy((char*)destinationPointer, sourceSize, sourcePointer);
+	context->bAlreadyRun = 1;
 }
 
 /*************************************************************************************************
  *
- * CAUTION: Char primitive allocation routine! In effect copying of a string. Make sure to free
- * later! For internal purpose only.
+ * CAUTION: Char primitive allocation routine! In effect copying of a string, interned: equal
+ * strings of a decode share one copy, which lives in the decode arena till the context is
+ * reset. So never write through the destination. For internal purpose only.
  *
  * @param destinationPointer      Pointer to the destination char* in appropriate struct category
  * @param sourcePointer           Pointer to the specific section of DMI data obtained
@@ -5355,149 +5704,1162 @@ static void copy_to_already_initialized_structure_char(char** destinationPointer
  *************************************************************************************************
  */
 
-static void copy_to_structure_char(char** destinationPointer, const char* sourcePointer)
+static void copy_to_structure_char(struct br_context* context, char** destinationPointer, const char* sourcePointer)
 {
-	size_t sourceSize = sizeof(char) * strlen(sourcePointer) + 1;
-	*destinationPointer = malloc(sourceSize);
-	br_safe_strcpy(*destinationPointer, sourceSize, sourcePointer);
+	*destinationPointer = (char*)br_intern(&context->stringPool, &context->decodeArena, sourcePointer);
 }
 
-/*********************************************************************************************************
- *
- * CAUTION: Char primitive allocation routine! In effect appending of a string with another.
- * Make sure to free later! For internal purpose only.
- *
- * @param destinationPointer      Pointer to the destination char* buffer in appropriate struct category
- * @param sourcePointer           Pointer to the specific section of DMI data obtained
- *                                (or some relevant data), which needs be copied
- * @param junctionCondition       '\n' for new line or ' ' for single space
- *
- *********************************************************************************************************
+/*
+ * Lines of text, written as far as they fit, counted all the way (see br_bios_characteristics_text())
  */
-
-static void append_to_structure_char(char** destinationPointer, const char* sourcePointer, const char junctionCondition)
+struct text_lines
 {
-	generate_multiline_buffer((char* const)destinationPointer, (char* const)sourcePointer, '\n');
-}
+	char* buffer;
+	size_t size;
+	size_t length;
+};
 
-static void allocate_and_initialize_memory_structure()
+static void add_line(struct text_lines* lines, const char* line)
 {
-	if (turingmachinesystemmemory.number_of_ram_or_system_memory_devices > 0)
+	size_t lineLength = strlen(line);
+
+	if (lines->length != 0)
 	{
-		if (randomaccessmemory == NULL)
+		if (lines->length + 1 < lines->size)
 		{
-			randomaccessmemory = malloc(sizeof(struct random_access_memory) * turingmachinesystemmemory.number_of_ram_or_system_memory_devices);
-		}
-		else
-		{
-			printf("BiosReader: trying to over allocate!");
+			lines->buffer[lines->length] = '\n';
+			lines->buffer[lines->length + 1] = '\0';
 		}
+		lines->length++;
 	}
 
-	// Initialize individual elements
-	for (unsigned int i = 0; i < turingmachinesystemmemory.number_of_ram_or_system_memory_devices; i++)
+	if (lines->length < lines->size)
 	{
-		randomaccessmemory[i].bIsFilled = 0;
+		size_t room = lines->size - lines->length - 1;
+		size_t copied = lineLength < room ? lineLength : room;
 
-		randomaccessmemory[i].assettag = NULL;
-		randomaccessmemory[i].banklocator = NULL;
-		randomaccessmemory[i].configuredmemoryspeed = NULL;
-		randomaccessmemory[i].formfactor = NULL;
-		randomaccessmemory[i].locator = NULL;
-		randomaccessmemory[i].manufacturer = NULL;
-		randomaccessmemory[i].memoryspeed = NULL;
-		randomaccessmemory[i].operatingvoltage = NULL;
-		randomaccessmemory[i].partnumber = NULL;
-		randomaccessmemory[i].ramsize = NULL;
-		randomaccessmemory[i].ramtype = NULL;
-		randomaccessmemory[i].rank = NULL;
-		randomaccessmemory[i].serialnumber = NULL;
+		memcpy(lines->buffer + lines->length, line, copied);
+		lines->buffer[lines->length + copied] = '\0';
+	}
+	lines->length += lineLength;
+}
+
+// Names of the bits set, from firstBit on
+static void add_lines_of_bits(struct text_lines* lines, unsigned long long bits, const char* const* names, size_t count, unsigned int firstBit)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		if (names[i] != NULL && (bits >> (firstBit + i)) & 1)
+		{
+			add_line(lines, names[i]);
+		}
+	}
+}
+
+size_t br_bios_characteristics_text(const struct bios_information* bios, char* buffer, size_t size)
+{
+	struct text_lines lines = { buffer, size, 0 };
+	unsigned long long bits = bios->characteristics;
+
+	if (size != 0)
+	{
+		buffer[0] = '\0';
+	}
+
+	// Characteristics not supported, and that's all there is to say (save the extension bytes)
+	if (bits & (1ull << BR_BIOS_CHARACTERISTICS_NOT_SUPPORTED))
+	{
+		add_line(&lines, biosCharacteristics[0]);
+	}
+	else
+	{
+		add_lines_of_bits(&lines, bits, biosCharacteristics + 1, ARRAY_SIZE(biosCharacteristics) - 1, 4);
+	}
+
+	add_lines_of_bits(&lines, bits, biosCharacteristicsX1, ARRAY_SIZE(biosCharacteristicsX1), 32);
+	add_lines_of_bits(&lines, bits, biosCharacteristicsX2, ARRAY_SIZE(biosCharacteristicsX2), 40);
+
+	return lines.length;
+}
+
+size_t br_cpu_flags_text(const struct central_processing_unit* processor, char* buffer, size_t size)
+{
+	struct text_lines lines = { buffer, size, 0 };
+
+	if (size != 0)
+	{
+		buffer[0] = '\0';
+	}
+
+	add_lines_of_bits(&lines, processor->cpuflagsmask, processorFlags, ARRAY_SIZE(processorFlags), 0);
+
+	return lines.length;
+}
+
+int br_bios_has(const struct bios_information* bios, enum br_bios_characteristic characteristic)
+{
+	return (bios->characteristics >> characteristic) & 1;
+}
+
+int br_cpu_has(const struct central_processing_unit* processor, enum br_cpu_flag flag)
+{
+	return (processor->cpuflagsmask >> flag) & 1;
+}
+
+/*************************************************************************************************
+ *
+ * The lines of bios_information::bioscharacteristics and central_processing_unit::cpuflags,
+ * rendered out of the bits the first time the records are handed out (see br_decode() and
+ * br_fetch_processor()) rather than on every decode, most callers going by br_bios_has() and
+ * br_cpu_has() if at all. Into the decode arena, exactly as long as it takes: measured first,
+ * written second. Then interned, as every other string of the decode.
+ *
+ * The decode leaves the text NULL for those to be rendered, and sets the short ones itself: "None"
+ * and "UNKNOWN" for the flags, an empty text for no characteristic at all.
+ *
+ *************************************************************************************************
+ */
+
+static void render_bios_characteristics(struct br_context* context)
+{
+	struct bios_information* bios = &context->biosinformation;
+	size_t length;
+	char* text;
+
+	if (bios->bioscharacteristics != NULL || bios->characteristics == 0)
+	{
+		return;
+	}
+
+	length = br_bios_characteristics_text(bios, NULL, 0);
+	text = br_arena_alloc(&context->decodeArena, length + 1);
+	if (text != NULL)
+	{
+		br_bios_characteristics_text(bios, text, length + 1);
+		bios->bioscharacteristics = (char*)br_intern(&context->stringPool, NULL, text);
+	}
+}
+
+static void render_cpu_flags_of(struct br_context* context, struct central_processing_unit* processor)
+{
+	size_t length;
+	char* text;
+
+	if (processor->cpuflags != NULL || processor->cpuflagsmask == 0)
+	{
+		return;
+	}
+
+	length = br_cpu_flags_text(processor, NULL, 0);
+	text = br_arena_alloc(&context->decodeArena, length + 1);
+	if (text != NULL)
+	{
+		br_cpu_flags_text(processor, text, length + 1);
+		processor->cpuflags = (char*)br_intern(&context->stringPool, NULL, text);
+	}
+}
+
+static void render_cpu_flags(struct br_context* context)
+{
+	for (unsigned int p = 0; p < context->processorCount; p++)
+	{
+		render_cpu_flags_of(context, &context->processors[p]);
+	}
+
+	render_cpu_flags_of(context, &context->centralprocessinguint);
+}
+
+static void allocate_and_initialize_memory_structure(struct br_context* context)
+{
+	if (context->turingmachinesystemmemory.number_of_ram_or_system_memory_devices > 0)
+	{
+		if (context->randomaccessmemory == NULL)
+		{
+			context->randomaccessmemory = br_arena_alloc(&context->decodeArena, sizeof(struct random_access_memory) * context->turingmachinesystemmemory.number_of_ram_or_system_memory_devices);
+		}
+		else
+		{
+			fprintf(stderr, "BiosReader: trying to over allocate!\n");
+		}
+	}
+
+	// Initialize individual elements (not filled, all strings NULL)
+	if (context->randomaccessmemory != NULL)
+	{
+		memset(context->randomaccessmemory, 0, sizeof(struct random_access_memory) * context->turingmachinesystemmemory.number_of_ram_or_system_memory_devices);
+	}
+
+	context->ramCounter = 0;
+}
+
+/*
+ * As many zeroed records as there are structures of the type in the table (NULL and a count of 0
+ * for none, or out of memory)
+ */
+static void* allocate_records(struct br_context* context, size_t size, u8 type, unsigned int* count)
+{
+	void* records = NULL;
+
+	*count = context->tableIndex.typecount[type];
+
+	if (*count > 0)
+	{
+		records = br_arena_alloc(&context->decodeArena, size * *count);
+
+		if (records == NULL)
+		{
+			*count = 0;
+		}
+		else
+		{
+			memset(records, 0, size * *count);
+		}
+	}
+
+	return records;
+}
+
+/*
+ * Give every memory array the number of memory devices which refer to it, once all of them are
+ * decoded. A device finds its array through the handle index.
+ */
+static void count_memory_devices_of_arrays(struct br_context* context)
+{
+	for (unsigned int a = 0; a < context->arrayCount; a++)
+	{
+		context->memoryarrays[a].number_of_ram_or_system_memory_devices = 0;
+	}
+
+	for (unsigned int d = 0; d < context->ramCounter; d++)
+	{
+		const struct dmi_structure_entry* entry;
+
+		if (context->randomaccessmemory[d].arrayhandle >= 0xFFFF)
+		{
+			continue;
+		}
+
+		entry = dmi_index_of_handle(&context->tableIndex, (u16)context->randomaccessmemory[d].arrayhandle);
+
+		if (entry != NULL && entry->type == 16 && entry->ordinal < context->arrayCount)
+		{
+			context->memoryarrays[entry->ordinal].number_of_ram_or_system_memory_devices++;
+		}
 	}
-
-	ramCounter = 0;
 }
 
 /*
  * Main output
  * The juicy stuff!!
  */
-#define GL_GLEXT_PROTOTYPES
-#include "gladtheloader.h"
 
- /************************************************************************************
-  *
-  * Decoding DMI structures for electronics components, handle by handle!
-  * @param h                 Pointer to the dmi_header sturcture under the microscope
-  * @param ver               SMBIOS version in octal system, right shifted by 8,
-  *                          converted to unsigned short (observe the u32 -> u16)
-  *
-  ************************************************************************************
-  */
-static void dmi_decode(const struct dmi_header* h, u16 ver)
+/************************************************************************************
+ *
+ * The graphics processing unit with the current GL context, as seen by the optional
+ * GL module (BiosReaderGL). The module, and libGL with it, is only loaded here.
+ *
+ ************************************************************************************
+ */
+static void fill_up_graphics_from_gl_module(struct br_context* context)
+{
+	struct gpu_module_device device;
+	char graphicsmemorysize[24];
+
+	if (gpu_provider_probe_module(&device) != 0)
+	{
+		return;
+	}
+
+	br_safe_sprintf(graphicsmemorysize, 24, "%lld MB", device.videomemorymb);
+	copy_to_structure_char(context, &context->graphicsprocessingunit.grandtotalvideomemory, graphicsmemorysize);
+	copy_to_structure_char(context, &context->graphicsprocessingunit.vendor, device.vendor);
+	copy_to_structure_char(context, &context->graphicsprocessingunit.gpuModel, device.renderer);
+
+	context->graphicsprocessingunit.bIsFilled = 1;
+
+	// The one GL knows about (the one with the current context)
+	context->graphicsprocessingunits = &context->graphicsprocessingunit;
+	context->gpuCounter = 1;
+}
+
+/************************************************************************************
+ *
+ * Graphics processing unit identification. Not a part of SMBIOS (yet) so done
+ * separately, and only when asked for.
+ *
+ ************************************************************************************
+ */
+/************************************************************************************
+ *
+ * Graphics processing units as listed by the kernel (DRM), see gpuprovider.c. The
+ * first one doubles as context->graphicsprocessingunit.
+ *
+ ************************************************************************************
+ */
+static void fill_up_graphics_from_drm(struct br_context* context)
+{
+	struct gpu_provider_device devices[BR_MAX_GPUS];
+	int found = gpu_provider_enumerate(devices, BR_MAX_GPUS);
+	char propertyPie[64];
+
+	if (found <= 0)
+	{
+		return;
+	}
+
+	context->graphicsprocessingunits = br_arena_alloc(&context->decodeArena, sizeof(struct graphics_processing_unit) * found);
+	if (context->graphicsprocessingunits == NULL)
+	{
+		return;
+	}
+
+	for (int i = 0; i < found; i++)
+	{
+		struct graphics_processing_unit* gpu = &context->graphicsprocessingunits[i];
+		const char* vendorName = gpu_provider_vendor_name(devices[i].vendorid);
+
+		if (vendorName != NULL)
+		{
+			copy_to_structure_char(context, &gpu->vendor, vendorName);
+		}
+		else
+		{
+			br_safe_sprintf(propertyPie, 64, "Unknown (0x%04X)", devices[i].vendorid);
+			copy_to_structure_char(context, &gpu->vendor, propertyPie);
+		}
+
+		// No marketing names in sysfs, the PCI IDs (and the driver) say it all
+		if (devices[i].driver[0] != '\0')
+		{
+			br_safe_sprintf(propertyPie, 64, "%04X:%04X (%s)", devices[i].vendorid, devices[i].deviceid, devices[i].driver);
+		}
+		else
+		{
+			br_safe_sprintf(propertyPie, 64, "%04X:%04X", devices[i].vendorid, devices[i].deviceid);
+		}
+		copy_to_structure_char(context, &gpu->gpuModel, propertyPie);
+
+		if (devices[i].vrambytes != 0)
+		{
+			br_safe_sprintf(propertyPie, 64, "%llu MB", devices[i].vrambytes >> 20);
+			copy_to_structure_char(context, &gpu->grandtotalvideomemory, propertyPie);
+		}
+		else
+		{
+			copy_to_structure_char(context, &gpu->grandtotalvideomemory, "Unknown");
+		}
+
+		gpu->bIsFilled = 1;
+	}
+
+	context->gpuCounter = (unsigned int)found;
+	context->graphicsprocessingunit = context->graphicsprocessingunits[0];
+}
+
+static void probe_graphics_processing_unit(struct br_context* context)
+{
+	// The kernel knows about every adapter (on Linux), no GL context needed
+	fill_up_graphics_from_drm(context);
+
+	// Else whatever the current GL context says, if the GL module is around
+	if (context->gpuCounter == 0)
+	{
+		fill_up_graphics_from_gl_module(context);
+	}
+}
+
+/*
+ * The plain fields of a structure, described rather than spelled out: where the field is, what it is,
+ * and from which structure length on it is there at all. dmi_decode_fields() then takes care of the
+ * length guard, the display and the copy into the record, field after field.
+ *
+ * It only covers the string fields, the bytes looked up into a name and the odd word shown as is.
+ * Sizes, speeds, voltages and the other numbers with a unit or a special value (those of types 4 and
+ * 17 in the first place) are decoded by hand in dmi_decode(), or by the DMI_FIELD_CUSTOM decoders,
+ * and the projection reads them raw (see dmifields.h). The SMBIOS version a field came with is told
+ * by the structure length, which is what the spec has the decoders go by.
+ */
+enum dmi_field_kind
+{
+	DMI_FIELD_STRING, // the byte at offset is the number of a string of the structure
+	DMI_FIELD_ENUM, // the byte at offset goes through lookup
+	DMI_FIELD_WORD, // a number, shown as such
+	DMI_FIELD_CUSTOM // decode does it all, for the odd ones in between
+};
+
+#define DMI_FIELD_NOWHERE ((size_t)-1)
+
+struct dmi_field
+{
+	const char* name; // as displayed, NULL for not displayed
+	u8 offset;
+	u8 kind; // enum dmi_field_kind
+	u8 minimumlength; // of the structure
+	const char* (*lookup)(u8 code); // DMI_FIELD_ENUM
+	void (*decode)(struct br_context* context, const struct dmi_header* h, u16 ver, void* record); // DMI_FIELD_CUSTOM
+	size_t text; // offsetof() the char* of the record the text goes into, DMI_FIELD_NOWHERE for none
+};
+
+/*
+ * A field decoded once, for the display and the record alike, so that the two never differ
+ */
+struct dmi_field_value
+{
+	unsigned int code; // the byte (or word) at offset, as is
+	const char* text; // the string, the name looked up or the number spelled out
+	char number[8]; // where the number gets spelled out
+};
+
+/*
+ * Decode the field out of the structure. 0 if the structure is too short for it.
+ */
+static int dmi_read_field(const struct dmi_header* h, const struct dmi_field* field, struct dmi_field_value* value)
+{
+	const u8* data = h->data + field->offset;
+
+	if (h->length < field->minimumlength)
+	{
+		return 0;
+	}
+
+	value->code = data[0];
+	value->text = NULL;
+
+	switch (field->kind)
+	{
+	case DMI_FIELD_STRING:
+		value->text = dmi_string(h, data[0]);
+		break;
+
+	case DMI_FIELD_ENUM:
+		value->text = field->lookup(data[0]);
+		break;
+
+	case DMI_FIELD_WORD:
+		value->code = WORD(data);
+		br_safe_sprintf(value->number, sizeof(value->number), "%u", value->code);
+		value->text = value->number;
+		break;
+
+	default:
+		break;
+	}
+
+	return 1;
+}
+
+/*
+ * Hand a decoded field to whoever wants it: the display (under name, NULL for none) and the
+ * record (into destination, NULL for none)
+ */
+static void dmi_emit_field(struct br_context* context, const char* name, const struct dmi_field_value* value, char** destination)
+{
+	if (bDisplayOutput && name != NULL)
+	{
+		pr_attr(name, "%s", value->text);
+	}
+
+	if (destination != NULL)
+	{
+		copy_to_structure_char(context, destination, value->text);
+	}
+}
+
+/*
+ ***************************************************************************************************
+ *
+ * Decode the fields, in order, into the record. The fields being laid out in the order of the
+ * spec, the first one the structure is too short for ends the decode.
+ *
+ * @param fields                  The description
+ * @param count                   How many fields there are
+ * @param record                  The struct the texts go into
+ * @return int                    1 if every field was there, 0 otherwise
+ *
+ ***************************************************************************************************
+ */
+
+static int dmi_decode_fields(struct br_context* context, const struct dmi_header* h, u16 ver,
+	const struct dmi_field* fields, size_t count, void* record)
+{
+	for (size_t f = 0; f < count; f++)
+	{
+		const struct dmi_field* field = &fields[f];
+		struct dmi_field_value value;
+
+		if (!dmi_read_field(h, field, &value))
+		{
+			return 0;
+		}
+
+		if (field->kind == DMI_FIELD_CUSTOM)
+		{
+			field->decode(context, h, ver, record);
+			continue;
+		}
+
+		dmi_emit_field(context, field->name, &value,
+			field->text != DMI_FIELD_NOWHERE ? (char**)((u8*)record + field->text) : NULL);
+	}
+
+	return 1;
+}
+
+static void dmi_decode_processor_family(struct br_context* context, const struct dmi_header* h, u16 ver, void* record)
+{
+	// Looked up (family2 is searched) just the once
+	struct dmi_field_value family = { h->data[DMI_PROCESSOR_FAMILY], dmi_processor_family(h, ver) };
+
+	dmi_emit_field(context, "Family", &family, &context->centralprocessinguint.processingfamily);
+}
+
+static void dmi_decode_processor_id(struct br_context* context, const struct dmi_header* h, u16 ver, void* record)
+{
+	// Flags
+	dmi_processor_id(context, h);
+}
+
+static void dmi_decode_memory_device_set(struct br_context* context, const struct dmi_header* h, u16 ver, void* record)
+{
+	// Won't be used in Karma. I don't know what this is utilitiwise.
+	dmi_memory_device_set(h->data[0x0F]);
+}
+
+// 7.1 BIOS Information
+static const struct dmi_field biosFields[] = {
+	{ "Vendor", DMI_BIOS_VENDOR, DMI_FIELD_STRING, 0x12, NULL, NULL, offsetof(struct bios_information, vendor) },
+	{ "Version", DMI_BIOS_VERSION, DMI_FIELD_STRING, 0x12, NULL, NULL, offsetof(struct bios_information, version) },
+	{ "Release Date", DMI_BIOS_RELEASE_DATE, DMI_FIELD_STRING, 0x12, NULL, NULL, offsetof(struct bios_information, biosreleasedate) },
+};
+
+// 7.5 Processor Information, up to the voltage and after the cache handles
+static const struct dmi_field processorFields[] = {
+	{ "Socket Designation", DMI_PROCESSOR_SOCKET_DESIGNATION, DMI_FIELD_STRING, 0x1A, NULL, NULL, offsetof(struct central_processing_unit, designation) },
+	{ "Type", 0x05, DMI_FIELD_ENUM, 0x1A, dmi_processor_type, NULL, offsetof(struct central_processing_unit, cputype) },
+	{ NULL, DMI_PROCESSOR_FAMILY, DMI_FIELD_CUSTOM, 0x1A, NULL, dmi_decode_processor_family, DMI_FIELD_NOWHERE },
+	{ "Manufacturer", DMI_PROCESSOR_MANUFACTURER, DMI_FIELD_STRING, 0x1A, NULL, NULL, offsetof(struct central_processing_unit, manufacturer) },
+	{ NULL, 0x08, DMI_FIELD_CUSTOM, 0x1A, NULL, dmi_decode_processor_id, DMI_FIELD_NOWHERE },
+	{ "Version", DMI_PROCESSOR_VERSION, DMI_FIELD_STRING, 0x1A, NULL, NULL, offsetof(struct central_processing_unit, version) },
+};
+
+static const struct dmi_field processorAssetFields[] = {
+	{ "Serial Number", DMI_PROCESSOR_SERIAL_NUMBER, DMI_FIELD_STRING, 0x23, NULL, NULL, offsetof(struct central_processing_unit, serialnumber) },
+	{ "Asset Tag", DMI_PROCESSOR_ASSET_TAG, DMI_FIELD_STRING, 0x23, NULL, NULL, offsetof(struct central_processing_unit, assettag) },
+	{ "Part Number", DMI_PROCESSOR_PART_NUMBER, DMI_FIELD_STRING, 0x23, NULL, NULL, offsetof(struct central_processing_unit, partnumber) },
+};
+
+// 7.8 Cache Information, after the speed
+static const struct dmi_field cacheFields[] = {
+	{ "Error Correction Type", 0x10, DMI_FIELD_ENUM, 0x13, dmi_cache_ec_type, NULL, offsetof(struct cpu_cache, errorcorrection) },
+	{ "System Type", 0x11, DMI_FIELD_ENUM, 0x13, dmi_cache_type, NULL, offsetof(struct cpu_cache, systemtype) },
+	{ "Associativity", 0x12, DMI_FIELD_ENUM, 0x13, dmi_cache_associativity, NULL, offsetof(struct cpu_cache, associativity) },
+};
+
+// 7.17 Physical Memory Array, before the capacity and after the error handle
+static const struct dmi_field memoryArrayFields[] = {
+	{ "Use", 0x05, DMI_FIELD_ENUM, 0x0F, dmi_memory_array_use, NULL, offsetof(struct turing_machine_system_memory, use) },
+	{ "Location", 0x04, DMI_FIELD_ENUM, 0x0F, dmi_memory_array_location, NULL, offsetof(struct turing_machine_system_memory, mounting_location) },
+	{ "Error Correction Type", 0x06, DMI_FIELD_ENUM, 0x0F, dmi_memory_array_ec_type, NULL, DMI_FIELD_NOWHERE },
+};
+
+static const struct dmi_field memoryArrayDeviceFields[] = {
+	{ "Number Of Devices", 0x0D, DMI_FIELD_WORD, 0x0F, NULL, NULL, DMI_FIELD_NOWHERE },
+};
+
+// 7.18 Memory Device, after the size and after the speed
+static const struct dmi_field memoryDeviceFields[] = {
+	{ "Form Factor", 0x0E, DMI_FIELD_ENUM, 0x15, dmi_memory_device_form_factor, NULL, offsetof(struct random_access_memory, formfactor) },
+	{ NULL, 0x0F, DMI_FIELD_CUSTOM, 0x15, NULL, dmi_decode_memory_device_set, DMI_FIELD_NOWHERE },
+	{ "Locator", DMI_MEMORY_DEVICE_LOCATOR, DMI_FIELD_STRING, 0x15, NULL, NULL, offsetof(struct random_access_memory, locator) },
+	{ "Bank Locator", DMI_MEMORY_DEVICE_BANK_LOCATOR, DMI_FIELD_STRING, 0x15, NULL, NULL, offsetof(struct random_access_memory, banklocator) },
+	{ "Type", 0x12, DMI_FIELD_ENUM, 0x15, dmi_memory_device_type, NULL, offsetof(struct random_access_memory, ramtype) },
+};
+
+static const struct dmi_field memoryDeviceAssetFields[] = {
+	{ "Manufacturer", DMI_MEMORY_DEVICE_MANUFACTURER, DMI_FIELD_STRING, 0x1B, NULL, NULL, offsetof(struct random_access_memory, manufacturer) },
+	{ "Serial Number", DMI_MEMORY_DEVICE_SERIAL_NUMBER, DMI_FIELD_STRING, 0x1B, NULL, NULL, offsetof(struct random_access_memory, serialnumber) },
+	{ "Asset Tag", DMI_MEMORY_DEVICE_ASSET_TAG, DMI_FIELD_STRING, 0x1B, NULL, NULL, offsetof(struct random_access_memory, assettag) },
+	{ "Part Number", DMI_MEMORY_DEVICE_PART_NUMBER, DMI_FIELD_STRING, 0x1B, NULL, NULL, offsetof(struct random_access_memory, partnumber) },
+};
+
+/*
+ * The structures with nothing but a record to them (see enum dmi_record_kind), displayed the
+ * way dmidecode does
+ */
+
+// The codes packed with others into a byte, and the lookups taking more than the code
+static const char* dmi_slot_bus_width_of(u8 code)
+{
+	return dmi_slot_bus_width(code, 0);
+}
+
+static const char* dmi_voltage_probe_location_of(u8 code)
+{
+	return dmi_voltage_probe_location(code & 0x1F);
+}
+
+static const char* dmi_temperature_probe_location_of(u8 code)
+{
+	return dmi_temperature_probe_location(code & 0x1F);
+}
+
+static const char* dmi_probe_status_of(u8 code)
+{
+	return dmi_probe_status(code >> 5);
+}
+
+static void dmi_decode_system_uuid(struct br_context* context, const struct dmi_header* h, u16 ver, void* record)
+{
+	struct system_information* system = record;
+	char uuid[40];
+	struct dmi_field_value value = { 0, dmi_system_uuid_text(h->data + 0x08, ver, uuid, sizeof(uuid)) };
+
+	dmi_emit_field(context, "UUID", &value, &system->uuid);
+}
+
+static void dmi_decode_base_board_feature_flags(struct br_context* context, const struct dmi_header* h, u16 ver, void* record)
+{
+	struct base_board* baseBoard = record;
+
+	baseBoard->features = h->data[0x09];
+
+	if (bDisplayOutput)
+	{
+		dmi_base_board_features(h->data[0x09]);
+	}
+}
+
+static void dmi_decode_base_board_chassis_handle(struct br_context* context, const struct dmi_header* h, u16 ver, void* record)
+{
+	struct base_board* baseBoard = record;
+
+	baseBoard->chassishandle = WORD(h->data + 0x0B);
+
+	if (bDisplayOutput)
+	{
+		pr_attr("Chassis Handle", "0x%04X", baseBoard->chassishandle);
+	}
+}
+
+static void dmi_decode_chassis_lock(struct br_context* context, const struct dmi_header* h, u16 ver, void* record)
+{
+	struct chassis_information* chassis = record;
+
+	// The top bit of the type
+	chassis->bLocked = h->data[DMI_CHASSIS_TYPE] >> 7;
+
+	if (bDisplayOutput)
+	{
+		pr_attr("Lock", "%s", dmi_chassis_lock((u8)chassis->bLocked));
+	}
+}
+
+static void dmi_decode_chassis_oem_information(struct br_context* context, const struct dmi_header* h, u16 ver, void* record)
+{
+	if (bDisplayOutput)
+	{
+		pr_attr("OEM Information", "0x%08X", DWORD(h->data + 0x0D));
+	}
+}
+
+static void dmi_decode_chassis_height(struct br_context* context, const struct dmi_header* h, u16 ver, void* record)
+{
+	struct chassis_information* chassis = record;
+
+	chassis->heightu = h->data[0x11];
+
+	if (bDisplayOutput)
+	{
+		dmi_chassis_height(h->data[0x11]);
+	}
+}
+
+static void dmi_decode_chassis_power_cords(struct br_context* context, const struct dmi_header* h, u16 ver, void* record)
+{
+	struct chassis_information* chassis = record;
+
+	chassis->powercords = h->data[0x12];
+
+	if (bDisplayOutput)
+	{
+		dmi_chassis_power_cords(h->data[0x12]);
+	}
+}
+
+static void dmi_decode_system_slot_type(struct br_context* context, const struct dmi_header* h, u16 ver, void* record)
+{
+	// Type and width as one, the record has them apart (see the fields below)
+	if (bDisplayOutput)
+	{
+		dmi_slot_type_with_width(h->data[0x05], h->data[0x06]);
+	}
+}
+
+static void dmi_decode_power_unit_group(struct br_context* context, const struct dmi_header* h, u16 ver, void* record)
+{
+	struct power_supply* powerSupply = record;
+
+	powerSupply->powerunitgroup = h->data[0x04];
+
+	if (bDisplayOutput && h->data[0x04] != 0x00)
+	{
+		pr_attr("Power Unit Group", "%u", h->data[0x04]);
+	}
+}
+
+// 7.2 System Information
+static const struct dmi_field systemFields[] = {
+	{ "Manufacturer", DMI_SYSTEM_MANUFACTURER, DMI_FIELD_STRING, 0x08, NULL, NULL, offsetof(struct system_information, manufacturer) },
+	{ "Product Name", DMI_SYSTEM_PRODUCT_NAME, DMI_FIELD_STRING, 0x08, NULL, NULL, offsetof(struct system_information, productname) },
+	{ "Version", DMI_SYSTEM_VERSION, DMI_FIELD_STRING, 0x08, NULL, NULL, offsetof(struct system_information, version) },
+	{ "Serial Number", DMI_SYSTEM_SERIAL_NUMBER, DMI_FIELD_STRING, 0x08, NULL, NULL, offsetof(struct system_information, serialnumber) },
+	{ NULL, 0x08, DMI_FIELD_CUSTOM, 0x19, NULL, dmi_decode_system_uuid, DMI_FIELD_NOWHERE },
+	{ "Wake-up Type", 0x18, DMI_FIELD_ENUM, 0x19, dmi_system_wake_up_type, NULL, offsetof(struct system_information, wakeuptype) },
+	{ "SKU Number", DMI_SYSTEM_SKU_NUMBER, DMI_FIELD_STRING, 0x1B, NULL, NULL, offsetof(struct system_information, skunumber) },
+	{ "Family", DMI_SYSTEM_FAMILY, DMI_FIELD_STRING, 0x1B, NULL, NULL, offsetof(struct system_information, family) },
+};
+
+// 7.3 Baseboard (or Module) Information
+static const struct dmi_field baseBoardFields[] = {
+	{ "Manufacturer", DMI_BASE_BOARD_MANUFACTURER, DMI_FIELD_STRING, 0x08, NULL, NULL, offsetof(struct base_board, manufacturer) },
+	{ "Product Name", DMI_BASE_BOARD_PRODUCT_NAME, DMI_FIELD_STRING, 0x08, NULL, NULL, offsetof(struct base_board, productname) },
+	{ "Version", DMI_BASE_BOARD_VERSION, DMI_FIELD_STRING, 0x08, NULL, NULL, offsetof(struct base_board, version) },
+	{ "Serial Number", DMI_BASE_BOARD_SERIAL_NUMBER, DMI_FIELD_STRING, 0x08, NULL, NULL, offsetof(struct base_board, serialnumber) },
+	{ "Asset Tag", DMI_BASE_BOARD_ASSET_TAG, DMI_FIELD_STRING, 0x09, NULL, NULL, offsetof(struct base_board, assettag) },
+	{ NULL, 0x09, DMI_FIELD_CUSTOM, 0x0A, NULL, dmi_decode_base_board_feature_flags, DMI_FIELD_NOWHERE },
+	{ "Location In Chassis", 0x0A, DMI_FIELD_STRING, 0x0E, NULL, NULL, offsetof(struct base_board, locationinchassis) },
+	{ NULL, 0x0B, DMI_FIELD_CUSTOM, 0x0E, NULL, dmi_decode_base_board_chassis_handle, DMI_FIELD_NOWHERE },
+	{ "Type", 0x0D, DMI_FIELD_ENUM, 0x0E, dmi_base_board_type, NULL, offsetof(struct base_board, boardtype) },
+};
+
+// 7.4 System Enclosure or Chassis
+static const struct dmi_field chassisFields[] = {
+	{ "Manufacturer", DMI_CHASSIS_MANUFACTURER, DMI_FIELD_STRING, 0x09, NULL, NULL, offsetof(struct chassis_information, manufacturer) },
+	{ "Type", DMI_CHASSIS_TYPE, DMI_FIELD_ENUM, 0x09, dmi_chassis_type, NULL, offsetof(struct chassis_information, chassistype) },
+	{ NULL, DMI_CHASSIS_TYPE, DMI_FIELD_CUSTOM, 0x09, NULL, dmi_decode_chassis_lock, DMI_FIELD_NOWHERE },
+	{ "Version", DMI_CHASSIS_VERSION, DMI_FIELD_STRING, 0x09, NULL, NULL, offsetof(struct chassis_information, version) },
+	{ "Serial Number", DMI_CHASSIS_SERIAL_NUMBER, DMI_FIELD_STRING, 0x09, NULL, NULL, offsetof(struct chassis_information, serialnumber) },
+	{ "Asset Tag", DMI_CHASSIS_ASSET_TAG, DMI_FIELD_STRING, 0x09, NULL, NULL, offsetof(struct chassis_information, assettag) },
+	{ "Boot-up State", 0x09, DMI_FIELD_ENUM, 0x0D, dmi_chassis_state, NULL, offsetof(struct chassis_information, bootupstate) },
+	{ "Power Supply State", 0x0A, DMI_FIELD_ENUM, 0x0D, dmi_chassis_state, NULL, offsetof(struct chassis_information, powersupplystate) },
+	{ "Thermal State", 0x0B, DMI_FIELD_ENUM, 0x0D, dmi_chassis_state, NULL, offsetof(struct chassis_information, thermalstate) },
+	{ "Security Status", 0x0C, DMI_FIELD_ENUM, 0x0D, dmi_chassis_security_status, NULL, offsetof(struct chassis_information, securitystatus) },
+	{ NULL, 0x0D, DMI_FIELD_CUSTOM, 0x11, NULL, dmi_decode_chassis_oem_information, DMI_FIELD_NOWHERE },
+	{ NULL, 0x11, DMI_FIELD_CUSTOM, 0x13, NULL, dmi_decode_chassis_height, DMI_FIELD_NOWHERE },
+	{ NULL, 0x12, DMI_FIELD_CUSTOM, 0x13, NULL, dmi_decode_chassis_power_cords, DMI_FIELD_NOWHERE },
+};
+
+// 7.9 Port Connector Information
+static const struct dmi_field portConnectorFields[] = {
+	{ "Internal Reference Designator", 0x04, DMI_FIELD_STRING, 0x09, NULL, NULL, offsetof(struct port_connector, internaldesignator) },
+	{ "Internal Connector Type", 0x05, DMI_FIELD_ENUM, 0x09, dmi_port_connector_type, NULL, offsetof(struct port_connector, internalconnector) },
+	{ "External Reference Designator", 0x06, DMI_FIELD_STRING, 0x09, NULL, NULL, offsetof(struct port_connector, externaldesignator) },
+	{ "External Connector Type", 0x07, DMI_FIELD_ENUM, 0x09, dmi_port_connector_type, NULL, offsetof(struct port_connector, externalconnector) },
+	{ "Port Type", 0x08, DMI_FIELD_ENUM, 0x09, dmi_port_type, NULL, offsetof(struct port_connector, porttype) },
+};
+
+// 7.10 System Slots
+static const struct dmi_field systemSlotFields[] = {
+	{ "Designation", 0x04, DMI_FIELD_STRING, 0x0C, NULL, NULL, offsetof(struct system_slot, designation) },
+	{ NULL, 0x05, DMI_FIELD_CUSTOM, 0x0C, NULL, dmi_decode_system_slot_type, DMI_FIELD_NOWHERE },
+	{ NULL, 0x05, DMI_FIELD_ENUM, 0x0C, dmi_slot_type, NULL, offsetof(struct system_slot, slottype) },
+	{ NULL, 0x06, DMI_FIELD_ENUM, 0x0C, dmi_slot_bus_width_of, NULL, offsetof(struct system_slot, buswidth) },
+	{ "Current Usage", 0x07, DMI_FIELD_ENUM, 0x0C, dmi_slot_current_usage, NULL, offsetof(struct system_slot, currentusage) },
+	{ "Length", 0x08, DMI_FIELD_ENUM, 0x0C, dmi_slot_length, NULL, offsetof(struct system_slot, slotlength) },
+};
+
+// 7.27 Voltage Probe, 7.29 Temperature Probe and 7.30 Electrical Current Probe (located as the voltage ones)
+static const struct dmi_field voltageProbeFields[] = {
+	{ "Description", 0x04, DMI_FIELD_STRING, 0x14, NULL, NULL, offsetof(struct management_probe, description) },
+	{ "Location", 0x05, DMI_FIELD_ENUM, 0x14, dmi_voltage_probe_location_of, NULL, offsetof(struct management_probe, location) },
+	{ "Status", 0x05, DMI_FIELD_ENUM, 0x14, dmi_probe_status_of, NULL, offsetof(struct management_probe, status) },
+};
+
+static const struct dmi_field temperatureProbeFields[] = {
+	{ "Description", 0x04, DMI_FIELD_STRING, 0x14, NULL, NULL, offsetof(struct management_probe, description) },
+	{ "Location", 0x05, DMI_FIELD_ENUM, 0x14, dmi_temperature_probe_location_of, NULL, offsetof(struct management_probe, location) },
+	{ "Status", 0x05, DMI_FIELD_ENUM, 0x14, dmi_probe_status_of, NULL, offsetof(struct management_probe, status) },
+};
+
+// 7.40 System Power Supply
+static const struct dmi_field powerSupplyFields[] = {
+	{ NULL, 0x04, DMI_FIELD_CUSTOM, 0x10, NULL, dmi_decode_power_unit_group, DMI_FIELD_NOWHERE },
+	{ "Location", 0x05, DMI_FIELD_STRING, 0x10, NULL, NULL, offsetof(struct power_supply, location) },
+	{ "Name", 0x06, DMI_FIELD_STRING, 0x10, NULL, NULL, offsetof(struct power_supply, devicename) },
+	{ "Manufacturer", 0x07, DMI_FIELD_STRING, 0x10, NULL, NULL, offsetof(struct power_supply, manufacturer) },
+	{ "Serial Number", 0x08, DMI_FIELD_STRING, 0x10, NULL, NULL, offsetof(struct power_supply, serialnumber) },
+	{ "Asset Tag", 0x09, DMI_FIELD_STRING, 0x10, NULL, NULL, offsetof(struct power_supply, assettag) },
+	{ "Model Part Number", 0x0A, DMI_FIELD_STRING, 0x10, NULL, NULL, offsetof(struct power_supply, modelpartnumber) },
+	{ "Revision", 0x0B, DMI_FIELD_STRING, 0x10, NULL, NULL, offsetof(struct power_supply, revisionlevel) },
+};
+
+// What the fields leave out: the numbers, and the lists
+static void dmi_decode_base_board_rest(struct br_context* context, const struct dmi_header* h, u16 ver, void* record)
+{
+	struct base_board* baseBoard = record;
+	const u8* data = h->data;
+
+	if (h->length < 0x0E)
+	{
+		baseBoard->chassishandle = 0xFFFF;
+		return;
+	}
+
+	if (bDisplayOutput && h->length >= 0x0F + data[0x0E] * sizeof(u16) && data[0x0E] != 0)
+	{
+		dmi_base_board_handles(data[0x0E], data + 0x0F);
+	}
+}
+
+static void dmi_decode_chassis_rest(struct br_context* context, const struct dmi_header* h, u16 ver, void* record)
+{
+	const u8* data = h->data;
+
+	if (!bDisplayOutput || h->length < 0x15 || h->length < 0x15 + data[0x13] * data[0x14])
+	{
+		return;
+	}
+
+	dmi_chassis_elements(data[0x13], data[0x14], data + 0x15);
+
+	if (h->length >= 0x16 + data[0x13] * data[0x14])
+	{
+		pr_attr("SKU Number", "%s", dmi_string(h, data[0x15 + data[0x13] * data[0x14]]));
+	}
+}
+
+static void dmi_decode_system_slot_rest(struct br_context* context, const struct dmi_header* h, u16 ver, void* record)
+{
+	struct system_slot* slot = record;
+	const u8* data = h->data;
+
+	slot->slotid = WORD(data + 0x09);
+
+	if (!bDisplayOutput)
+	{
+		return;
+	}
+
+	dmi_slot_id(data[0x09], data[0x0A], data[0x05]);
+	dmi_slot_characteristics("Characteristics", data[0x0B], h->length < 0x0D ? 0x00 : data[0x0C]);
+
+	if (h->length >= 0x11)
+	{
+		dmi_slot_segment_bus_func(WORD(data + 0x0D), data[0x0F], data[0x10]);
+	}
+}
+
+static void dmi_decode_probe_rest(struct br_context* context, const struct dmi_header* h, u16 ver, void* record)
 {
+	struct management_probe* probe = record;
 	const u8* data = h->data;
 
-	if (graphicsprocessingunit.bIsFilled == 0)
+	// Signed, 0x8000 being unknown, as the spec has it for all three of them
+	probe->type = h->type;
+	probe->maximum = (i16)WORD(data + 0x06);
+	probe->minimum = (i16)WORD(data + 0x08);
+	probe->tolerance = (i16)WORD(data + 0x0C);
+	probe->nominal = h->length >= 0x16 ? (i16)WORD(data + 0x14) : BR_PROBE_UNKNOWN;
+
+	if (bDisplayOutput)
 	{
-		// With the hope of SMBIOS reading GPU specs one day, sayeth the turtle, I shall
-		// be gald to add yet another clause in the switch. Till then let glad(ness) (the library)
-		// be the vessel for gpu identification, alongwith glfw.
+		void (*value)(const char* attr, u16 code) = dmi_current_probe_value;
+		void (*resolution)(u16 code) = dmi_current_probe_resolution;
 
-		int resultA = imgl3wInit();// with compliments from Dear ImGui
-		if (resultA != 0)
+		if (h->type == 26)
 		{
-			printf("Failed to initialize GLAD");
+			value = dmi_voltage_probe_value;
+			resolution = dmi_voltage_probe_resolution;
 		}
-		/*
-		glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-		glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-		glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-		glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_API);
-		glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_NATIVE_CONTEXT_API);
-		glfwWindowHint(GLFW_RESIZABLE, GLFW_TRUE);
-
-		// It is quite funny that GLFW doesn't support OpenGL context without window. Think Stadia and you may get
-		// the gist.
-		// Anywho, https://www.glfw.org/docs/3.3/context_guide.html#:~:text=GLFW%20doesn't%20support%20creating,with%20the%20GLFW_VISIBLE%20window%20hint.
-		// there is a very hacky way to achieve. Very, because having OpenGL context in BR itself is hacky stuff.
-		glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
-
-		GLFWwindow* br_window_hack = glfwCreateWindow(1, 1, "BR_Hack", NULL, NULL);
-		if (!br_window_hack)
+		else if (h->type == 28)
 		{
-			return;
+			value = dmi_temperature_probe_value;
+			resolution = dmi_temperature_probe_resolution;
 		}
 
-		glfwMakeContextCurrent(br_window_hack);
+		value("Maximum Value", WORD(data + 0x06));
+		value("Minimum Value", WORD(data + 0x08));
+		resolution(WORD(data + 0x0A));
+		value("Tolerance", WORD(data + 0x0C));
+		dmi_probe_accuracy(WORD(data + 0x0E));
+		pr_attr("OEM-specific Information", "0x%08X", DWORD(data + 0x10));
 
-		if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+		if (h->length >= 0x16)
 		{
-			printf("Failed to initialize GLAD");
-			return;
-		}*/
+			value("Nominal Value", WORD(data + 0x14));
+		}
+	}
+}
+
+static void dmi_decode_power_supply_rest(struct br_context* context, const struct dmi_header* h, u16 ver, void* record)
+{
+	struct power_supply* powerSupply = record;
+	u16 characteristics = WORD(h->data + 0x0E);
+	struct dmi_field_value supplyType = { (characteristics >> 10) & 0x0F, dmi_power_supply_type((characteristics >> 10) & 0x0F) };
+	struct dmi_field_value rangeSwitching = { (characteristics >> 3) & 0x0F, dmi_power_supply_range_switching((characteristics >> 3) & 0x0F) };
+
+	powerSupply->maximumpowerwatts = WORD(h->data + 0x0C) != 0x8000 ? WORD(h->data + 0x0C) : 0;
+	powerSupply->bPresent = (characteristics & 0x0002) != 0;
+	powerSupply->bUnplugged = (characteristics & 0x0004) != 0;
+	powerSupply->bHotReplaceable = characteristics & 0x0001;
+
+	copy_to_structure_char(context, &powerSupply->status,
+		powerSupply->bPresent ? dmi_power_supply_status((characteristics >> 7) & 0x07) : "Not Present");
+
+	if (bDisplayOutput)
+	{
+		dmi_power_supply_power(WORD(h->data + 0x0C));
+
+		if (powerSupply->bPresent)
+		{
+			pr_attr("Status", "Present, %s", powerSupply->status);
+		}
+		else
+		{
+			pr_attr("Status", "Not Present");
+		}
+	}
+
+	dmi_emit_field(context, "Type", &supplyType, &powerSupply->supplytype);
+	dmi_emit_field(context, "Input Voltage Range Switching", &rangeSwitching, &powerSupply->inputvoltagerangeswitching);
+
+	if (bDisplayOutput)
+	{
+		pr_attr("Plugged", "%s", powerSupply->bUnplugged ? "No" : "Yes");
+		pr_attr("Hot Replaceable", "%s", powerSupply->bHotReplaceable ? "Yes" : "No");
+	}
+}
+
+// Where the strings of the records are, for the records to be kept elsewhere (see dmicache.c)
+static const size_t systemStrings[] = {
+	offsetof(struct system_information, manufacturer),
+	offsetof(struct system_information, productname),
+	offsetof(struct system_information, version),
+	offsetof(struct system_information, serialnumber),
+	offsetof(struct system_information, uuid),
+	offsetof(struct system_information, wakeuptype),
+	offsetof(struct system_information, skunumber),
+	offsetof(struct system_information, family),
+};
+
+static const size_t baseBoardStrings[] = {
+	offsetof(struct base_board, manufacturer),
+	offsetof(struct base_board, productname),
+	offsetof(struct base_board, version),
+	offsetof(struct base_board, serialnumber),
+	offsetof(struct base_board, assettag),
+	offsetof(struct base_board, locationinchassis),
+	offsetof(struct base_board, boardtype),
+};
+
+static const size_t chassisStrings[] = {
+	offsetof(struct chassis_information, manufacturer),
+	offsetof(struct chassis_information, chassistype),
+	offsetof(struct chassis_information, version),
+	offsetof(struct chassis_information, serialnumber),
+	offsetof(struct chassis_information, assettag),
+	offsetof(struct chassis_information, bootupstate),
+	offsetof(struct chassis_information, powersupplystate),
+	offsetof(struct chassis_information, thermalstate),
+	offsetof(struct chassis_information, securitystatus),
+};
+
+static const size_t portConnectorStrings[] = {
+	offsetof(struct port_connector, internaldesignator),
+	offsetof(struct port_connector, internalconnector),
+	offsetof(struct port_connector, externaldesignator),
+	offsetof(struct port_connector, externalconnector),
+	offsetof(struct port_connector, porttype),
+};
+
+static const size_t systemSlotStrings[] = {
+	offsetof(struct system_slot, designation),
+	offsetof(struct system_slot, slottype),
+	offsetof(struct system_slot, buswidth),
+	offsetof(struct system_slot, currentusage),
+	offsetof(struct system_slot, slotlength),
+};
+
+static const size_t probeStrings[] = {
+	offsetof(struct management_probe, description),
+	offsetof(struct management_probe, location),
+	offsetof(struct management_probe, status),
+};
+
+static const size_t powerSupplyStrings[] = {
+	offsetof(struct power_supply, location),
+	offsetof(struct power_supply, devicename),
+	offsetof(struct power_supply, manufacturer),
+	offsetof(struct power_supply, serialnumber),
+	offsetof(struct power_supply, assettag),
+	offsetof(struct power_supply, modelpartnumber),
+	offsetof(struct power_supply, revisionlevel),
+	offsetof(struct power_supply, supplytype),
+	offsetof(struct power_supply, status),
+	offsetof(struct power_supply, inputvoltagerangeswitching),
+};
+
+/*
+ * What makes a record out of a structure, by enum dmi_record_kind
+ */
+struct dmi_record_description
+{
+	struct dmi_record_layout layout;
+	u8 type;
+	u8 minimumlength; // for the record to be filled at all
+	u8 category; // enum bios_reader_information_classification the type is decoded with
+	const char* name; // as displayed
+	size_t handle; // offsetof() the handle of the record
+	size_t filled; // offsetof() bIsFilled
+	const struct dmi_field* fields;
+	size_t fieldCount;
+	void (*rest)(struct br_context* context, const struct dmi_header* h, u16 ver, void* record);
+};
+
+#define DMI_RECORD(type, length, category, name, record, strings, fields, rest) \
+	{ { sizeof(struct record), strings, ARRAY_SIZE(strings) }, type, length, category, name, \
+		offsetof(struct record, handle), offsetof(struct record, bIsFilled), fields, ARRAY_SIZE(fields), rest }
+
+static const struct dmi_record_description recordKinds[DMI_RECORD_KINDS] = {
+	DMI_RECORD(1, 0x08, pi_manufacturer, "System Information", system_information, systemStrings, systemFields, NULL),
+	DMI_RECORD(2, 0x08, ps_motherboard, "Base Board Information", base_board, baseBoardStrings, baseBoardFields, dmi_decode_base_board_rest),
+	DMI_RECORD(3, 0x09, ps_chassis, "Chassis Information", chassis_information, chassisStrings, chassisFields, dmi_decode_chassis_rest),
+	DMI_RECORD(8, 0x09, ps_motherboard, "Port Connector Information", port_connector, portConnectorStrings, portConnectorFields, NULL),
+	DMI_RECORD(9, 0x0C, ps_motherboard, "System Slot Information", system_slot, systemSlotStrings, systemSlotFields, dmi_decode_system_slot_rest),
+	DMI_RECORD(26, 0x14, ps_motherboard, "Voltage Probe", management_probe, probeStrings, voltageProbeFields, dmi_decode_probe_rest),
+	DMI_RECORD(28, 0x14, ps_motherboard, "Temperature Probe", management_probe, probeStrings, temperatureProbeFields, dmi_decode_probe_rest),
+	DMI_RECORD(29, 0x14, ps_motherboard, "Electrical Current Probe", management_probe, probeStrings, voltageProbeFields, dmi_decode_probe_rest),
+	DMI_RECORD(39, 0x10, ps_chassis, "System Power Supply", power_supply, powerSupplyStrings, powerSupplyFields, dmi_decode_power_supply_rest),
+};
+
+const struct dmi_record_layout* dmi_record_layout_of(enum dmi_record_kind kind)
+{
+	return &recordKinds[kind].layout;
+}
+
+/*
+ * The next record of the kind, out of the structure. Every structure of the type gets its record,
+ * so that the records line up with the index, filled if the structure is long enough for it.
+ */
+static void dmi_decode_record(struct br_context* context, const struct dmi_header* h, u16 ver, enum dmi_record_kind kind)
+{
+	const struct dmi_record_description* description = &recordKinds[kind];
+	struct dmi_record_array* array = &context->records[kind];
+	u8* record;
+
+	if (bDisplayOutput)
+	{
+		pr_handle_name("%s", description->name);
+	}
+
+	if (array->counter >= array->count)
+	{
+		return;
+	}
+
+	record = (u8*)array->records + (size_t)array->counter++ * description->layout.size;
+	*(unsigned int*)(record + description->handle) = h->handle;
+
+	if (h->length < description->minimumlength)
+	{
+		return;
+	}
+
+	dmi_decode_fields(context, h, ver, description->fields, description->fieldCount, record);
+
+	if (description->rest != NULL)
+	{
+		description->rest(context, h, ver, record);
+	}
+
+	*(int*)(record + description->filled) = 1;
+}
+
+/*
+ * Record counter of the kind, decoding its category first if need be
+ */
+static void* fetch_record(struct br_context* context, enum dmi_record_kind kind, unsigned int counter)
+{
+	const struct dmi_record_description* description = &recordKinds[kind];
+
+	if (context->bAlreadyRun == 0 || !(context->decodedCategories & (1u << description->category)))
+	{
+		br_decode(context, description->category);
+	}
+
+	if (counter >= context->records[kind].count)
+	{
+		return NULL;
+	}
+
+	return (u8*)context->records[kind].records + (size_t)counter * description->layout.size;
+}
+
+struct system_information* br_fetch_system(struct br_context* context, unsigned int counter)
+{
+	return fetch_record(context, DMI_RECORD_SYSTEM, counter);
+}
+
+struct base_board* br_fetch_base_board(struct br_context* context, unsigned int counter)
+{
+	return fetch_record(context, DMI_RECORD_BASE_BOARD, counter);
+}
 
-		// This method works for OpenGL renderer not for Vulkan.
-		// Shall work on some day based on mood!!
-#define GL_GPU_MEM_INFO_TOTAL_AVAILABLE_MEM_NVX 0x9048
-		//#define GL_GPU_MEM_INFO_CURRENT_AVAILABLE_MEM_NVX 0x9049
+struct chassis_information* br_fetch_chassis(struct br_context* context, unsigned int counter)
+{
+	return fetch_record(context, DMI_RECORD_CHASSIS, counter);
+}
 
-		GLint total_mem_kb = 0;
-		glGetIntegerv(GL_GPU_MEM_INFO_TOTAL_AVAILABLE_MEM_NVX, &total_mem_kb);
+struct port_connector* br_fetch_port_connector(struct br_context* context, unsigned int counter)
+{
+	return fetch_record(context, DMI_RECORD_PORT_CONNECTOR, counter);
+}
 
-		char graphicsmemorysize[10];
-		char propertyPie[50];
+struct system_slot* br_fetch_system_slot(struct br_context* context, unsigned int counter)
+{
+	return fetch_record(context, DMI_RECORD_SYSTEM_SLOT, counter);
+}
 
-		br_safe_sprintf(graphicsmemorysize, 10, "%d MB", total_mem_kb / 1000);
-		copy_to_structure_char(&graphicsprocessingunit.grandtotalvideomemory, graphicsmemorysize);
+struct management_probe* br_fetch_probe(struct br_context* context, u8 type, unsigned int counter)
+{
+	switch (type)
+	{
+	case 26:
+		return fetch_record(context, DMI_RECORD_VOLTAGE_PROBE, counter);
+	case 28:
+		return fetch_record(context, DMI_RECORD_TEMPERATURE_PROBE, counter);
+	case 29:
+		return fetch_record(context, DMI_RECORD_CURRENT_PROBE, counter);
+	default:
+		return NULL;
+	}
+}
 
-		br_safe_sprintf(propertyPie, 50, "%s", (char*)glGetString(GL_VENDOR));
-		copy_to_structure_char(&graphicsprocessingunit.vendor, propertyPie);
+struct power_supply* br_fetch_power_supply(struct br_context* context, unsigned int counter)
+{
+	return fetch_record(context, DMI_RECORD_POWER_SUPPLY, counter);
+}
 
-		br_safe_sprintf(propertyPie, 50, "%s", (char*)glGetString(GL_RENDERER));
-		copy_to_structure_char(&graphicsprocessingunit.gpuModel, propertyPie);
+ /************************************************************************************
+  *
+  * Decoding DMI structures for electronics components, handle by handle!
+  * @param h                 Pointer to the dmi_header sturcture under the microscope
+  * @param ver               SMBIOS version in octal system, right shifted by 8,
+  *                          converted to unsigned short (observe the u32 -> u16)
+  *
+  ************************************************************************************
+  */
+static void dmi_decode(struct br_context* context, const struct dmi_header* h, u16 ver)
+{
+	const u8* data = h->data;
 
-		graphicsprocessingunit.bIsFilled = 1;
+	// Every processor gets decoded afresh into centralprocessinguint, then kept (see below)
+	if (h->type == 4)
+	{
+		initialize_processor(&context->centralprocessinguint);
+		context->centralprocessinguint.handle = h->handle;
 	}
+
 	/*
 	 * Note: DMI types 37 and 42 are untested
 	 */
@@ -5510,22 +6872,12 @@ static void dmi_decode(const struct dmi_header* h, u16 ver)
 			pr_handle_name("BIOS Information");
 		}
 
-		if (h->length < 0x12)
+		if (!dmi_decode_fields(context, h, ver, biosFields, ARRAY_SIZE(biosFields), &context->biosinformation))
 		{
 			break;
 		}
 
-		if (bDisplayOutput)
-		{
-			pr_attr("Vendor", "%s", dmi_string(h, data[0x04]));
-			pr_attr("Version", "%s", dmi_string(h, data[0x05]));
-			pr_attr("Release Date", "%s", dmi_string(h, data[0x08]));
-		}
-
-		copy_to_structure_char(&biosinformation.vendor, dmi_string(h, data[0x04]));
-		copy_to_structure_char(&biosinformation.version, dmi_string(h, data[0x05]));
-		copy_to_structure_char(&biosinformation.biosreleasedate, dmi_string(h, data[0x08]));
-		biosinformation.bIsFilled = 1;
+		context->biosinformation.bIsFilled = 1;
 
 		/*
 		 * On IA-64 and UEFI-based systems, the BIOS base
@@ -5540,108 +6892,96 @@ static void dmi_decode(const struct dmi_header* h, u16 ver)
 				dmi_bios_runtime_size((0x10000 - WORD(data + 0x06)) << 4);
 			}
 		}
-		dmi_bios_rom_size(data[0x09], h->length < 0x1A ? 16 : WORD(data + 0x18), (char* const)&biosinformation.biosromsize);
-
-		if (bDisplayOutput)
-		{
-			pr_list_start("Characteristics", NULL);
-		}
-
-		dmi_bios_characteristics(QWORD(data + 0x0A), (char* const)&biosinformation.bioscharacteristics);
-
-		if (bDisplayOutput)
-		{
-			pr_list_end();
-		}
-
-		if (h->length < 0x13)
-		{
-			break;
-		}
+		dmi_bios_rom_size(context, data[0x09], h->length < 0x1A ? 16 : WORD(data + 0x18), (char* const)&context->biosinformation.biosromsize);
 
-		dmi_bios_characteristics_x1(data[0x12], (char* const)&biosinformation.bioscharacteristics);
-
-		if (h->length < 0x14)
+		// Bits, and lines of text out of them (see br_bios_has() and br_bios_characteristics_text())
+		context->biosinformation.characteristics = QWORD(data + 0x0A).l;
+		if (h->length >= 0x13)
 		{
-			break;
+			context->biosinformation.characteristics |= (unsigned long long)data[0x12] << 32;
 		}
-
-		dmi_bios_characteristics_x2(data[0x13], (char* const)&biosinformation.bioscharacteristics);
-
-		if (h->length < 0x18)
+		if (h->length >= 0x14)
 		{
-			break;
+			context->biosinformation.characteristics |= (unsigned long long)data[0x13] << 40;
 		}
 
-		if (data[0x14] != 0xFF && data[0x15] != 0xFF && bDisplayOutput)
+		// The lines are rendered out of the bits once asked for, see render_bios_characteristics()
+		context->biosinformation.bioscharacteristics = NULL;
+		if (context->biosinformation.characteristics == 0)
 		{
-			pr_attr("BIOS Revision", "%u.%u", data[0x14], data[0x15]);
+			copy_to_structure_char(context, &context->biosinformation.bioscharacteristics, "");
 		}
 
-		if (data[0x16] != 0xFF && data[0x17] != 0xFF && bDisplayOutput)
+		if (bDisplayOutput)
 		{
-			pr_attr("Firmware Revision", "%u.%u", data[0x16], data[0x17]);
-		}
+			pr_list_start("Characteristics", NULL);
+			dmi_bios_characteristics(QWORD(data + 0x0A));
 
-		break;
+			// The extension bytes carry on with the same list
+			if (h->length >= 0x13)
+			{
+				dmi_bios_characteristics_x1(data[0x12]);
+			}
 
-	case 4: /* 7.5 Processor Information */
+			if (h->length >= 0x14)
+			{
+				dmi_bios_characteristics_x2(data[0x13]);
+			}
 
-		if (bDisplayOutput)
-		{
-			pr_handle_name("Processor Information");
+			pr_list_end();
 		}
 
-		if (h->length < 0x1A)
+		if (h->length < 0x18)
 		{
 			break;
 		}
 
-		if (bDisplayOutput)
+		if (data[0x14] != 0xFF && data[0x15] != 0xFF && bDisplayOutput)
 		{
-			pr_attr("Socket Designation", "%s", dmi_string(h, data[0x04]));
+			pr_attr("BIOS Revision", "%u.%u", data[0x14], data[0x15]);
 		}
 
-		copy_to_structure_char(&centralprocessinguint.designation, dmi_string(h, data[0x04]));
-
-		if (bDisplayOutput)
+		if (data[0x16] != 0xFF && data[0x17] != 0xFF && bDisplayOutput)
 		{
-			pr_attr("Type", "%s", dmi_processor_type(data[0x05]));
+			pr_attr("Firmware Revision", "%u.%u", data[0x16], data[0x17]);
 		}
 
-		copy_to_structure_char(&centralprocessinguint.cputype, dmi_processor_type(data[0x05]));
-
-		if (bDisplayOutput)
-		{
-			pr_attr("Family", "%s", dmi_processor_family(h, ver));
-		}
+		break;
 
-		copy_to_structure_char(&centralprocessinguint.processingfamily, dmi_processor_family(h, ver));
+	case 1: /* 7.2 System Information */
+		dmi_decode_record(context, h, ver, DMI_RECORD_SYSTEM);
+		break;
 
-		if (bDisplayOutput)
-		{
-			pr_attr("Manufacturer", "%s", dmi_string(h, data[0x07]));
-		}
+	case 2: /* 7.3 Base Board Information */
+		dmi_decode_record(context, h, ver, DMI_RECORD_BASE_BOARD);
+		break;
 
-		copy_to_structure_char(&centralprocessinguint.manufacturer, dmi_string(h, data[0x07]));
+	case 3: /* 7.4 Chassis Information */
+		dmi_decode_record(context, h, ver, DMI_RECORD_CHASSIS);
+		break;
 
-		// Flags
-		dmi_processor_id(h);
+	case 4: /* 7.5 Processor Information */
 
 		if (bDisplayOutput)
 		{
-			pr_attr("Version", "%s", dmi_string(h, data[0x10]));
+			pr_handle_name("Processor Information");
 		}
 
-		copy_to_structure_char(&centralprocessinguint.version, dmi_string(h, data[0x10]));
+		if (!dmi_decode_fields(context, h, ver, processorFields, ARRAY_SIZE(processorFields), &context->centralprocessinguint))
+		{
+			break;
+		}
 
-		dmi_processor_voltage("Voltage", data[0x11]);
+		dmi_processor_voltage(context, "Voltage", data[0x11]);
 
-		dmi_processor_frequency("External Clock", data + 0x12, (char* const)&centralprocessinguint.externalclock);
+		dmi_processor_frequency(context, "External Clock", data + 0x12, (char* const)&context->centralprocessinguint.externalclock);
+		context->centralprocessinguint.externalclockmhz = WORD(data + 0x12);
 
-		dmi_processor_frequency("Max Speed", data + 0x14, (char* const)&centralprocessinguint.maximumspeed);
+		dmi_processor_frequency(context, "Max Speed", data + 0x14, (char* const)&context->centralprocessinguint.maximumspeed);
+		context->centralprocessinguint.maximumspeedmhz = WORD(data + 0x14);
 
-		dmi_processor_frequency("Current Speed", data + 0x16, (char* const)&centralprocessinguint.currentspeed);
+		dmi_processor_frequency(context, "Current Speed", data + DMI_PROCESSOR_CURRENT_SPEED, (char* const)&context->centralprocessinguint.currentspeed);
+		context->centralprocessinguint.currentspeedmhz = WORD(data + DMI_PROCESSOR_CURRENT_SPEED);
 
 		// Nah doesn't seem interesting
 		if (data[0x18] & (1 << 6))
@@ -5665,20 +7005,20 @@ static void dmi_decode(const struct dmi_header* h, u16 ver)
 			pr_attr("Upgrade", "%s", dmi_processor_upgrade(data[0x19]));
 		}
 
-		centralprocessinguint.bIsFilled = 0;
+		context->centralprocessinguint.bIsFilled = 0;
 
 		if (h->length < 0x20)
 		{
 			char unknownString[36] = "UnKnowable in this Machine";
 
 			// Fill rest fields with unknown
-			copy_to_structure_char(&centralprocessinguint.serialnumber, unknownString);
-			copy_to_structure_char(&centralprocessinguint.assettag, unknownString);
-			copy_to_structure_char(&centralprocessinguint.partnumber, unknownString);
-			copy_to_structure_char(&centralprocessinguint.corescount, unknownString);
-			copy_to_structure_char(&centralprocessinguint.enabledcorescount, unknownString);
-			copy_to_structure_char(&centralprocessinguint.threadcount, unknownString);
-			copy_to_structure_char(&centralprocessinguint.characterstics, unknownString);
+			copy_to_structure_char(context, &context->centralprocessinguint.serialnumber, unknownString);
+			copy_to_structure_char(context, &context->centralprocessinguint.assettag, unknownString);
+			copy_to_structure_char(context, &context->centralprocessinguint.partnumber, unknownString);
+			copy_to_structure_char(context, &context->centralprocessinguint.corescount, unknownString);
+			copy_to_structure_char(context, &context->centralprocessinguint.enabledcorescount, unknownString);
+			copy_to_structure_char(context, &context->centralprocessinguint.threadcount, unknownString);
+			copy_to_structure_char(context, &context->centralprocessinguint.characterstics, unknownString);
 
 			break;
 		}
@@ -5690,36 +7030,31 @@ static void dmi_decode(const struct dmi_header* h, u16 ver)
 			dmi_processor_cache("L3 Cache Handle", WORD(data + 0x1E), "L3", ver);
 		}
 
-		if (h->length < 0x23)
-		{
-			break;
-		}
+		// Resolved by br_processor_caches()
+		context->centralprocessinguint.l1cachehandle = WORD(data + 0x1A);
+		context->centralprocessinguint.l2cachehandle = WORD(data + 0x1C);
+		context->centralprocessinguint.l3cachehandle = WORD(data + 0x1E);
 
-		if (bDisplayOutput)
+		if (!dmi_decode_fields(context, h, ver, processorAssetFields, ARRAY_SIZE(processorAssetFields), &context->centralprocessinguint))
 		{
-			pr_attr("Serial Number", "%s", dmi_string(h, data[0x20]));
-			pr_attr("Asset Tag", "%s", dmi_string(h, data[0x21]));
-			pr_attr("Part Number", "%s", dmi_string(h, data[0x22]));
+			break;
 		}
 
-		copy_to_structure_char(&centralprocessinguint.serialnumber, dmi_string(h, data[0x20]));
-		copy_to_structure_char(&centralprocessinguint.assettag, dmi_string(h, data[0x21]));
-		copy_to_structure_char(&centralprocessinguint.partnumber, dmi_string(h, data[0x22]));
-
 		if (h->length < 0x28)
 		{
 			break;
 		}
 
-		if (data[0x23] != 0)
+		if (data[DMI_PROCESSOR_CORE_COUNT] != 0)
 		{
 			char coreCountPie[10];
 			if (bDisplayOutput)
 			{
-				pr_attr("Core Count", "%u", h->length >= 0x2C && data[0x23] == 0xFF ? WORD(data + 0x2A) : data[0x23]);
+				pr_attr("Core Count", "%u", h->length >= 0x2C && data[DMI_PROCESSOR_CORE_COUNT] == 0xFF ? WORD(data + 0x2A) : data[DMI_PROCESSOR_CORE_COUNT]);
 			}
-			br_safe_sprintf(coreCountPie, 10, "%u", h->length >= 0x2C && data[0x23] == 0xFF ? WORD(data + 0x2A) : data[0x23]);
-			copy_to_structure_char(&centralprocessinguint.corescount, coreCountPie);
+			context->centralprocessinguint.cores = h->length >= 0x2C && data[DMI_PROCESSOR_CORE_COUNT] == 0xFF ? WORD(data + 0x2A) : data[DMI_PROCESSOR_CORE_COUNT];
+			br_safe_sprintf(coreCountPie, 10, "%u", context->centralprocessinguint.cores);
+			copy_to_structure_char(context, &context->centralprocessinguint.corescount, coreCountPie);
 		}
 
 		if (data[0x24] != 0)
@@ -5729,23 +7064,125 @@ static void dmi_decode(const struct dmi_header* h, u16 ver)
 			{
 				pr_attr("Cores Enabled", "%u", h->length >= 0x2E && data[0x24] == 0xFF ? WORD(data + 0x2C) : data[0x24]);
 			}
-			br_safe_sprintf(coresEnabledCountPie, 10, "%u", h->length >= 0x2E && data[0x24] == 0xFF ? WORD(data + 0x2C) : data[0x24]);
-			copy_to_structure_char(&centralprocessinguint.enabledcorescount, coresEnabledCountPie);
+			context->centralprocessinguint.enabledcores = h->length >= 0x2E && data[0x24] == 0xFF ? WORD(data + 0x2C) : data[0x24];
+			br_safe_sprintf(coresEnabledCountPie, 10, "%u", context->centralprocessinguint.enabledcores);
+			copy_to_structure_char(context, &context->centralprocessinguint.enabledcorescount, coresEnabledCountPie);
 		}
 
-		if (data[0x25] != 0)
+		if (data[DMI_PROCESSOR_THREAD_COUNT] != 0)
 		{
 			char threadsCountPie[10];
 			if (bDisplayOutput)
 			{
-				pr_attr("Thread Count", "%u", h->length >= 0x30 && data[0x25] == 0xFF ? WORD(data + 0x2E) : data[0x25]);
+				pr_attr("Thread Count", "%u", h->length >= 0x30 && data[DMI_PROCESSOR_THREAD_COUNT] == 0xFF ? WORD(data + 0x2E) : data[DMI_PROCESSOR_THREAD_COUNT]);
 			}
-			br_safe_sprintf(threadsCountPie, 10, "%u", h->length >= 0x30 && data[0x25] == 0xFF ? WORD(data + 0x2E) : data[0x25]);
-			copy_to_structure_char(&centralprocessinguint.threadcount, threadsCountPie);
+			context->centralprocessinguint.threads = h->length >= 0x30 && data[DMI_PROCESSOR_THREAD_COUNT] == 0xFF ? WORD(data + 0x2E) : data[DMI_PROCESSOR_THREAD_COUNT];
+			br_safe_sprintf(threadsCountPie, 10, "%u", context->centralprocessinguint.threads);
+			copy_to_structure_char(context, &context->centralprocessinguint.threadcount, threadsCountPie);
+		}
+
+		dmi_processor_characteristics(context, "Characteristics", WORD(data + 0x26));
+
+		break;
+
+	case 7: /* 7.8 Cache Information */
+
+		if (bDisplayOutput)
+		{
+			pr_handle_name("Cache Information");
+		}
+
+		// A record for each and every type 7 structure, so that they line up with the index
+		if (context->cacheCounter >= context->cacheCount)
+		{
+			break;
+		}
+
+		struct cpu_cache* processorCache = &context->processorcaches[context->cacheCounter++];
+		char cachePie[70];
+
+		processorCache->handle = h->handle;
+
+		if (h->length < 0x0F)
+		{
+			break;
+		}
+
+		struct dmi_field_value designation = { data[0x04], dmi_string(h, data[0x04]) };
+		struct dmi_field_value operationMode = { (WORD(data + 0x05) >> 8) & 0x0003, dmi_cache_mode((WORD(data + 0x05) >> 8) & 0x0003) };
+		struct dmi_field_value location = { (WORD(data + 0x05) >> 5) & 0x0003, dmi_cache_location((WORD(data + 0x05) >> 5) & 0x0003) };
+
+		dmi_emit_field(context, "Socket Designation", &designation, &processorCache->designation);
+
+		if (bDisplayOutput)
+		{
+			pr_attr("Configuration", "%s, %s, Level %u",
+				WORD(data + 0x05) & 0x0080 ? "Enabled" : "Disabled",
+				WORD(data + 0x05) & 0x0008 ? "Socketed" : "Not Socketed",
+				(WORD(data + 0x05) & 0x0007) + 1);
+		}
+
+		dmi_emit_field(context, "Operational Mode", &operationMode, &processorCache->operationmode);
+		dmi_emit_field(context, "Location", &location, &processorCache->location);
+
+		if (bDisplayOutput)
+		{
+			if (h->length >= 0x1B)
+				dmi_cache_size_2("Installed Size", DWORD(data + 0x17));
+			else
+				dmi_cache_size("Installed Size", WORD(data + 0x09));
+
+			if (h->length >= 0x17)
+				dmi_cache_size_2("Maximum Size", DWORD(data + 0x13));
+			else
+				dmi_cache_size("Maximum Size", WORD(data + 0x07));
+
+			dmi_cache_types("Supported SRAM Types", WORD(data + 0x0B), 0);
+			dmi_cache_types("Installed SRAM Type", WORD(data + 0x0D), 1);
+		}
+
+		copy_to_structure_char(context, &processorCache->status, WORD(data + 0x05) & 0x0080 ? "Enabled" : "Disabled");
+		processorCache->level = (WORD(data + 0x05) & 0x0007) + 1;
+
+		// The 32-bit sizes supersede the 16-bit ones
+		processorCache->installedsizebytes = h->length >= 0x1B ? dmi_cache_size_bytes(DWORD(data + 0x17))
+			: dmi_cache_size_bytes((((u32)WORD(data + 0x09) & 0x8000LU) << 16) | (WORD(data + 0x09) & 0x7FFFLU));
+		processorCache->maximumsizebytes = h->length >= 0x17 ? dmi_cache_size_bytes(DWORD(data + 0x13))
+			: dmi_cache_size_bytes((((u32)WORD(data + 0x07) & 0x8000LU) << 16) | (WORD(data + 0x07) & 0x7FFFLU));
+		copy_to_structure_char(context, &processorCache->installedsize, br_format_memory_size(processorCache->installedsizebytes, cachePie, sizeof(cachePie)));
+		copy_to_structure_char(context, &processorCache->maximumsize, br_format_memory_size(processorCache->maximumsizebytes, cachePie, sizeof(cachePie)));
+
+		copy_to_structure_char(context, &processorCache->sramtype, dmi_cache_types_flat(WORD(data + 0x0D), cachePie));
+
+		processorCache->bIsFilled = 1;
+
+		if (h->length < 0x13)
+		{
+			break;
+		}
+
+		if (bDisplayOutput)
+		{
+			dmi_memory_module_speed("Speed", data[0x0F]);
+		}
+
+		processorCache->speedns = data[0x0F];
+		if (data[0x0F] != 0)
+		{
+			br_safe_sprintf(cachePie, sizeof(cachePie), "%u ns", data[0x0F]);
 		}
+		copy_to_structure_char(context, &processorCache->speed, data[0x0F] != 0 ? cachePie : "Unknown");
+
+		dmi_decode_fields(context, h, ver, cacheFields, ARRAY_SIZE(cacheFields), processorCache);
+
+		break;
 
-		dmi_processor_characteristics("Characteristics", WORD(data + 0x26));
+	case 8: /* 7.9 Port Connector Information */
+		dmi_decode_record(context, h, ver, DMI_RECORD_PORT_CONNECTOR);
+		break;
 
+	case 9: /* 7.10 System Slots */
+		dmi_decode_record(context, h, ver, DMI_RECORD_SYSTEM_SLOT);
 		break;
 
 	case 13: /* 7.14 BIOS Language Information */
@@ -5759,8 +7196,8 @@ static void dmi_decode(const struct dmi_header* h, u16 ver)
 		if (h->length < 0x16)
 		{
 			br_safe_sprintf(languagePie, 65, "Unknown");
-			copy_to_structure_char(&mblanguagemodules.currentactivemodule, languagePie);
-			copy_to_structure_char(&mblanguagemodules.supportedlanguagemodules, languagePie);
+			copy_to_structure_char(context, &context->mblanguagemodules.currentactivemodule, languagePie);
+			copy_to_structure_char(context, &context->mblanguagemodules.supportedlanguagemodules, languagePie);
 			break;
 		}
 
@@ -5777,63 +7214,40 @@ static void dmi_decode(const struct dmi_header* h, u16 ver)
 			pr_list_start("Installable Languages", "%u", data[0x04]);
 		}
 
-		dmi_bios_languages(h);
+		dmi_bios_languages(context, h);
 		pr_list_end();
 
-		if (bDisplayOutput)
-		{
-			pr_attr("Currently Installed Language", "%s", dmi_string(h, data[0x15]));
-		}
+		struct dmi_field_value currentLanguage = { data[0x15], dmi_string(h, data[0x15]) };
 
-		br_safe_sprintf(languagePie, 65, dmi_string(h, data[0x15]));
-		copy_to_structure_char(&mblanguagemodules.currentactivemodule, languagePie);
+		dmi_emit_field(context, "Currently Installed Language", &currentLanguage, &context->mblanguagemodules.currentactivemodule);
 		break;
 
 	case 16: /* 7.17 Physical Memory Array */
-		// Here we make an attempt to count the number of RAM type electronics
 
 		if (bDisplayOutput)
 		{
 			pr_handle_name("Physical Memory Array");
 		}
 
-		if (h->length < 0x0F)
+		// A record for each and every array, in table order
+		if (context->arrayCounter >= context->arrayCount)
 		{
-			turingmachinesystemmemory.number_of_ram_or_system_memory_devices = 0;
 			break;
 		}
 
-		const char* cacheUseType = dmi_memory_array_use(data[0x05]);
-
-		// Depending upon the platform or device, the lingo "may" vary.
-		// Seems like ram is referred as System Memory according to the table 7.17.2 Memory Array — Use
-		// https://github.com/ravimohan1991/BiosReader/wiki/Demystifying-the-RAW-BIOS-information
-		const char ramLingo[] = "System Memory";
-
-		if (bDisplayOutput)
-		{
-			pr_attr("Use", "%s", cacheUseType);
-		}
-
-		if (strcmp(cacheUseType, ramLingo) == 0)// You can't be Sirius, hehe
-		{
-			turingmachinesystemmemory.bIsFilled = 1;
-		}
+		struct turing_machine_system_memory* memoryArray = &context->memoryarrays[context->arrayCounter++];
 
-		if (bDisplayOutput)
-		{
-			pr_attr("Location", "%s", dmi_memory_array_location(data[0x04]));
-		}
+		memoryArray->handle = h->handle;
 
-		if (turingmachinesystemmemory.bIsFilled)
+		if (!dmi_decode_fields(context, h, ver, memoryArrayFields, ARRAY_SIZE(memoryArrayFields), memoryArray))
 		{
-			copy_to_structure_char(&turingmachinesystemmemory.mounting_location, dmi_memory_array_location(data[0x04]));
+			break;
 		}
 
-		if (bDisplayOutput)
-		{
-			pr_attr("Error Correction Type", "%s", dmi_memory_array_ec_type(data[0x06]));
-		}
+		// Depending upon the platform or device, the lingo "may" vary.
+		// Seems like ram is referred as System Memory according to the table 7.17.2 Memory Array — Use
+		// https://github.com/ravimohan1991/BiosReader/wiki/Demystifying-the-RAW-BIOS-information
+		const char ramLingo[] = "System Memory";
 
 		// Reported capacity is quite suspicious and needs further investigations.
 		if (DWORD(data + 0x07) == 0x80000000)
@@ -5844,30 +7258,30 @@ static void dmi_decode(const struct dmi_header* h, u16 ver)
 				{
 					pr_attr("Maximum Capacity", "Unknown");
 				}
-				if (turingmachinesystemmemory.bIsFilled)
-				{
-					copy_to_structure_char(&turingmachinesystemmemory.total_grand_capacity, "Capacity Unknown");
-				}
+
+				copy_to_structure_char(context, &memoryArray->total_grand_capacity, "Capacity Unknown");
 			}
 			else
 			{
+				char sizeInformation[8];
+
 				if (bDisplayOutput)
 				{
 					dmi_print_memory_size("Maximum Capacity", QWORD(data + 0x0F), 0);
 				}
 
-				if (turingmachinesystemmemory.bIsFilled)
-				{
-					char sizeInformation[8];
-					br_safe_sprintf(sizeInformation, 8, "%lu %s", dmi_compute_memory_size_numerical_part(QWORD(data + 0x0F)),
-						dmi_compute_memory_size_units_or_dimensions_part(QWORD(data + 0x0F), 0));
-					copy_to_structure_char(&turingmachinesystemmemory.total_grand_capacity, sizeInformation);
-				}
+				br_safe_sprintf(sizeInformation, 8, "%lu %s", dmi_compute_memory_size_numerical_part(QWORD(data + 0x0F)),
+					dmi_compute_memory_size_units_or_dimensions_part(QWORD(data + 0x0F), 0));
+				copy_to_structure_char(context, &memoryArray->total_grand_capacity, sizeInformation);
+
+				// In bytes already
+				memoryArray->total_grand_capacity_bytes = (unsigned long long)QWORD(data + 0x0F).h << 32 | QWORD(data + 0x0F).l;
 			}
 		}
 		else
 		{
 			u64 capacity;
+			char sizeInformation[8];
 
 			capacity.h = 0;
 			capacity.l = DWORD(data + 0x07);
@@ -5877,13 +7291,12 @@ static void dmi_decode(const struct dmi_header* h, u16 ver)
 				dmi_print_memory_size("Maximum Capacity", capacity, 1);
 			}
 
-			if (turingmachinesystemmemory.bIsFilled)
-			{
-				char sizeInformation[8];
-				br_safe_sprintf(sizeInformation, 8, "%lu %s", dmi_compute_memory_size_numerical_part(capacity),
-					dmi_compute_memory_size_units_or_dimensions_part(capacity, 1));
-				copy_to_structure_char(&turingmachinesystemmemory.total_grand_capacity, sizeInformation);
-			}
+			br_safe_sprintf(sizeInformation, 8, "%lu %s", dmi_compute_memory_size_numerical_part(capacity),
+				dmi_compute_memory_size_units_or_dimensions_part(capacity, 1));
+			copy_to_structure_char(context, &memoryArray->total_grand_capacity, sizeInformation);
+
+			// In kB
+			memoryArray->total_grand_capacity_bytes = (unsigned long long)capacity.l << 10;
 		}
 
 		if (bDisplayOutput)
@@ -5891,18 +7304,24 @@ static void dmi_decode(const struct dmi_header* h, u16 ver)
 			dmi_memory_array_error_handle(WORD(data + 0x0B));
 		}
 
-		if (bDisplayOutput)
-		{
-			pr_attr("Number Of Devices", "%u", WORD(data + 0x0D));
-		}
+		memoryArray->errorhandle = WORD(data + 0x0B);
+
+		dmi_decode_fields(context, h, ver, memoryArrayDeviceFields, ARRAY_SIZE(memoryArrayDeviceFields), memoryArray);
 
-		if (turingmachinesystemmemory.bIsFilled)
+		// Memory devices are counted (and allocated) by dmi_table_decode(context) from the actual
+		// type 17 structures, the number above is merely what the array can hold. Those of the
+		// array are counted once all of them are decoded, see count_memory_devices_of_arrays(context)
+
+		memoryArray->bIsFilled = 1;
+
+		// The one of old: the (last) array of system memory, with every memory device to its name
+		if (strcmp(memoryArray->use, ramLingo) == 0)// You can't be Sirius, hehe
 		{
-			turingmachinesystemmemory.number_of_ram_or_system_memory_devices = WORD(data + 0x0D);
-		}
+			unsigned int memoryDevices = context->turingmachinesystemmemory.number_of_ram_or_system_memory_devices;
 
-		// Instantiate the "number" of estimated memory devices. BIOS lies :(
-		allocate_and_initialize_memory_structure();
+			context->turingmachinesystemmemory = *memoryArray;
+			context->turingmachinesystemmemory.number_of_ram_or_system_memory_devices = memoryDevices;
+		}
 
 		break;
 
@@ -5913,11 +7332,28 @@ static void dmi_decode(const struct dmi_header* h, u16 ver)
 			pr_handle_name("Memory Device");
 		}
 
+		// Every type 17 structure gets its slot, taken before anything else so that the devices line up
+		// with the index, whichever length the structure stops at
+		if (context->randomaccessmemory == NULL
+			|| context->ramCounter >= context->turingmachinesystemmemory.number_of_ram_or_system_memory_devices)
+		{
+			break;
+		}
+
+		struct random_access_memory* device = &context->randomaccessmemory[context->ramCounter++];
+
+		device->handle = h->handle;
+		device->arrayhandle = 0xFFFF;
+		device->errorhandle = 0xFFFF;
+
 		if (h->length < 0x15)
 		{
 			break;
 		}
 
+		device->arrayhandle = WORD(data + 0x04);
+		device->errorhandle = WORD(data + 0x06);
+
 		if (bDisplayOutput)
 		{
 			pr_attr("Array Handle", "0x%04X", WORD(data + 0x04));
@@ -5926,105 +7362,56 @@ static void dmi_decode(const struct dmi_header* h, u16 ver)
 			dmi_memory_device_width("Data Width", WORD(data + 0x0A));
 		}
 
-		if (h->length >= 0x20 && WORD(data + 0x0C) == 0x7FFF)
-		{
-			dmi_memory_device_extended_size(DWORD(data + 0x1C), (char* const)&randomaccessmemory[ramCounter].ramsize);
-		}
-		else
-		{
-			dmi_memory_device_size(WORD(data + 0x0C), (char* const)&randomaccessmemory[ramCounter].ramsize);
-		}
-
-		if (bDisplayOutput)
+		if (h->length >= 0x20 && WORD(data + DMI_MEMORY_DEVICE_SIZE) == 0x7FFF)
 		{
-			pr_attr("Form Factor", "%s", dmi_memory_device_form_factor(data[0x0E]));
-		}
-
-		copy_to_structure_char(&randomaccessmemory[ramCounter].formfactor, dmi_memory_device_form_factor(data[0x0E]));
+			dmi_memory_device_extended_size(context, DWORD(data + DMI_MEMORY_DEVICE_EXTENDED_SIZE), (char* const)&device->ramsize);
 
-		// Won't be used in Karma. I don't know what this is utilitiwise.
-		dmi_memory_device_set(data[0x0F]);
-
-		if (bDisplayOutput)
-		{
-			pr_attr("Locator", "%s", dmi_string(h, data[0x10]));
+			// In MB
+			device->ramsizebytes = (unsigned long long)(DWORD(data + DMI_MEMORY_DEVICE_EXTENDED_SIZE) & 0x7FFFFFFFUL) << 20;
 		}
-
-		copy_to_structure_char(&randomaccessmemory[ramCounter].locator, dmi_string(h, data[0x10]));
-
-		if (bDisplayOutput)
+		else
 		{
-			pr_attr("Bank Locator", "%s", dmi_string(h, data[0x11]));
-		}
+			dmi_memory_device_size(context, WORD(data + DMI_MEMORY_DEVICE_SIZE), (char* const)&device->ramsize);
 
-		copy_to_structure_char(&randomaccessmemory[ramCounter].banklocator, dmi_string(h, data[0x11]));
-
-		if (bDisplayOutput)
-		{
-			pr_attr("Type", "%s", dmi_memory_device_type(data[0x12]));
+			// In MB, or kB with the top bit set. 0 (no module) and 0xFFFF (unknown) are no size at all
+			if (WORD(data + DMI_MEMORY_DEVICE_SIZE) != 0 && WORD(data + DMI_MEMORY_DEVICE_SIZE) != 0xFFFF)
+			{
+				device->ramsizebytes = (unsigned long long)(WORD(data + DMI_MEMORY_DEVICE_SIZE) & 0x7FFF) << (WORD(data + DMI_MEMORY_DEVICE_SIZE) & 0x8000 ? 10 : 20);
+			}
 		}
 
-		copy_to_structure_char(&randomaccessmemory[ramCounter].ramtype, dmi_memory_device_type(data[0x12]));
+		dmi_decode_fields(context, h, ver, memoryDeviceFields, ARRAY_SIZE(memoryDeviceFields), device);
 
 		dmi_memory_device_type_detail(WORD(data + 0x13));
 
 		if (h->length < 0x17)
 		{
-			ramCounter++;
 			break;
 		}
 
 		/* If no module is present, the remaining fields are irrelevant */
 		// We can leverage just that, in the sense, check later fields to
 		// know if module is present or not, if on display. Choice of those later fields would be tricky though.
-		if (WORD(data + 0x0C) == 0)
+		if (WORD(data + DMI_MEMORY_DEVICE_SIZE) == 0)
 		{
-			ramCounter++;
 			break;
 		}
 
-		dmi_memory_device_speed("Speed", WORD(data + 0x15), h->length >= 0x5C ? DWORD(data + 0x54) : 0, (char* const)&randomaccessmemory[ramCounter].memoryspeed);
+		dmi_memory_device_speed(context, "Speed", WORD(data + DMI_MEMORY_DEVICE_SPEED), h->length >= 0x5C ? DWORD(data + 0x54) : 0, (char* const)&device->memoryspeed);
+		device->memoryspeedmts = dmi_memory_device_speed_value(WORD(data + DMI_MEMORY_DEVICE_SPEED), h->length >= 0x5C ? DWORD(data + 0x54) : 0);
 
-		if (h->length < 0x1B)
+		if (!dmi_decode_fields(context, h, ver, memoryDeviceAssetFields, ARRAY_SIZE(memoryDeviceAssetFields), device))
 		{
-			ramCounter++;
 			break;
 		}
 
-		if (bDisplayOutput)
-		{
-			pr_attr("Manufacturer", "%s", dmi_string(h, data[0x17]));
-		}
-
-		copy_to_structure_char(&randomaccessmemory[ramCounter].manufacturer, dmi_string(h, data[0x17]));
-
-		if (bDisplayOutput)
-		{
-			pr_attr("Serial Number", "%s", dmi_string(h, data[0x18]));
-		}
-
-		copy_to_structure_char(&randomaccessmemory[ramCounter].serialnumber, dmi_string(h, data[0x18]));
-
-		if (bDisplayOutput)
-		{
-			pr_attr("Asset Tag", "%s", dmi_string(h, data[0x19]));
-		}
-
-		copy_to_structure_char(&randomaccessmemory[ramCounter].assettag, dmi_string(h, data[0x19]));
-
-		if (bDisplayOutput)
-		{
-			pr_attr("Part Number", "%s", dmi_string(h, data[0x1A]));
-		}
-
-		copy_to_structure_char(&randomaccessmemory[ramCounter].partnumber, dmi_string(h, data[0x1A]));
-
 		if (h->length < 0x1C)
 		{
-			ramCounter++;
 			break;
 		}
 
+		device->ranks = data[0x1B] & 0x0F;
+
 		if ((data[0x1B] & 0x0F) == 0)
 		{
 			if (bDisplayOutput)
@@ -6042,26 +7429,25 @@ static void dmi_decode(const struct dmi_header* h, u16 ver)
 
 		if (h->length < 0x22)
 		{
-			ramCounter++;
 			break;
 		}
 
-		dmi_memory_device_speed("Configured Memory Speed", WORD(data + 0x20), h->length >= 0x5C ? DWORD(data + 0x58) : 0, (char* const)&randomaccessmemory[ramCounter].configuredmemoryspeed);
+		dmi_memory_device_speed(context, "Configured Memory Speed", WORD(data + DMI_MEMORY_DEVICE_CONFIGURED_SPEED), h->length >= 0x5C ? DWORD(data + 0x58) : 0, (char* const)&device->configuredmemoryspeed);
+		device->configuredmemoryspeedmts = dmi_memory_device_speed_value(WORD(data + DMI_MEMORY_DEVICE_CONFIGURED_SPEED), h->length >= 0x5C ? DWORD(data + 0x58) : 0);
 
 		if (h->length < 0x28)
 		{
-			ramCounter++;
 			break;
 		}
 
-		dmi_memory_voltage_value("Minimum Voltage", WORD(data + 0x22), NULL);
-		dmi_memory_voltage_value("Maximum Voltage", WORD(data + 0x24), NULL);
-		dmi_memory_voltage_value("Configured Voltage", WORD(data + 0x26), (char* const)&randomaccessmemory[ramCounter].operatingvoltage);
+		dmi_memory_voltage_value(context, "Minimum Voltage", WORD(data + 0x22), NULL);
+		dmi_memory_voltage_value(context, "Maximum Voltage", WORD(data + 0x24), NULL);
+		dmi_memory_voltage_value(context, "Configured Voltage", WORD(data + 0x26), (char* const)&device->operatingvoltage);
+		device->operatingvoltagemv = WORD(data + 0x26);
 
 		// Seems like for ram this is the bottom line (?)
 		if (h->length < 0x34)
 		{
-			ramCounter++;
 			break;
 		}
 
@@ -6096,7 +7482,6 @@ static void dmi_decode(const struct dmi_header* h, u16 ver)
 
 		if (h->length < 0x3C)
 		{
-			ramCounter++;
 			break;
 		}
 
@@ -6135,8 +7520,29 @@ static void dmi_decode(const struct dmi_header* h, u16 ver)
 			dmi_memory_size("Logical Size", QWORD(data + 0x4C));
 		}
 
-		ramCounter++;
 		break;
+
+	case 26: /* 7.27 Voltage Probe */
+		dmi_decode_record(context, h, ver, DMI_RECORD_VOLTAGE_PROBE);
+		break;
+
+	case 28: /* 7.29 Temperature Probe */
+		dmi_decode_record(context, h, ver, DMI_RECORD_TEMPERATURE_PROBE);
+		break;
+
+	case 29: /* 7.30 Electrical Current Probe */
+		dmi_decode_record(context, h, ver, DMI_RECORD_CURRENT_PROBE);
+		break;
+
+	case 39: /* 7.40 System Power Supply */
+		dmi_decode_record(context, h, ver, DMI_RECORD_POWER_SUPPLY);
+		break;
+	}
+
+	// One record per processor, in table order
+	if (h->type == 4 && context->processorCounter < context->processorCount)
+	{
+		context->processors[context->processorCounter++] = context->centralprocessinguint;
 	}
 }
 
@@ -6159,15 +7565,36 @@ static void to_dmi_header(struct dmi_header* h, u8* data)
 	h->length = data[1]; // A BYTE worth
 	h->handle = WORD(data + 2); // Well, a WORD worth
 	h->data = data; // Entirety
+	h->strings = NULL; // Look strings up the slow way
+	h->stringcount = 0;
+}
+
+/*
+ * Same as above, only with the string offsets of the structure known from the index
+ */
+static void to_dmi_header_indexed(struct br_context* context, struct dmi_header* h, u8* buf, const struct dmi_structure_entry* entry)
+{
+	to_dmi_header(h, buf + entry->offset);
+
+	if (entry->firststring != DMI_NO_STRING_TABLE)
+	{
+		h->strings = context->tableIndex.strings + entry->firststring;
+		h->stringcount = entry->stringcount;
+	}
+}
+
+void br_context_header_of(struct br_context* context, u32 i, struct dmi_header* h)
+{
+	to_dmi_header_indexed(context, h, context->loadedTable.buf, &context->tableIndex.entries[i]);
 }
 
 // No clue about the utility of this crap
-static void dmi_table_string(const struct dmi_header* h, const u8* data, u16 ver)
+static void dmi_table_string(struct br_context* context, const struct dmi_header* h, const u8* data, u16 ver)
 {
 	int key;
-	u8 offset = opt.string->offset;
+	u8 offset = context->opt.string->offset;
 
-	if (opt.string->type == 11) /* OEM strings */
+	if (context->opt.string->type == 11) /* OEM strings */
 	{
 		if (h->length < 5 || offset > data[4])
 		{
@@ -6185,7 +7612,7 @@ static void dmi_table_string(const struct dmi_header* h, const u8* data, u16 ver
 	if (offset >= h->length)
 		return;
 
-	key = (opt.string->type << 8) | offset;
+	key = (context->opt.string->type << 8) | offset;
 	switch (key)
 	{
 	case 0x015: /* -s bios-revision */
@@ -6206,7 +7633,7 @@ static void dmi_table_string(const struct dmi_header* h, const u8* data, u16 ver
 		printf("%s\n", dmi_processor_family(h, ver));
 		break;
 	case 0x416:
-		dmi_processor_frequency(NULL, data + offset, NULL);
+		dmi_processor_frequency(context, NULL, data + offset, NULL);
 		break;
 	default:
 		printf("%s\n", dmi_string(h, data[offset]));
@@ -6359,7 +7786,7 @@ void iterate_over_mac_platform_devices(const char* serviceClassString)
  **************************************************************************************************************************
  */
 
-static void fill_up_bios_from_mac_equivalent()
+static void fill_up_bios_from_mac_equivalent(struct br_context* context)
 {
 	if (macPort == MACH_PORT_NULL)
 	{
@@ -6389,7 +7816,7 @@ static void fill_up_bios_from_mac_equivalent()
 
 	extract_property_value_from_dictionary(propertiesDict, "target-type", &valuePointer);
 	data = valuePointer;
-	copy_to_structure_char(&biosinformation.version, (const char*)data.bytes);
+	copy_to_structure_char(context, &context->biosinformation.version, (const char*)data.bytes);
 	if (valuePointer != NULL)
 	{
 		CFRelease(valuePointer);
@@ -6399,7 +7826,7 @@ static void fill_up_bios_from_mac_equivalent()
 
 	extract_property_value_from_dictionary(propertiesDict, "time-stamp", &valuePointer);
 	data = valuePointer;
-	copy_to_structure_char(&biosinformation.biosreleasedate, (const char*)data.bytes);
+	copy_to_structure_char(context, &context->biosinformation.biosreleasedate, (const char*)data.bytes);
 	if (valuePointer != NULL)
 	{
 		CFRelease(valuePointer);
@@ -6409,7 +7836,7 @@ static void fill_up_bios_from_mac_equivalent()
 
 	extract_property_value_from_dictionary(propertiesDict, "manufacturer", &valuePointer);
 	data = valuePointer;
-	copy_to_structure_char(&biosinformation.vendor, (const char*)data.bytes);
+	copy_to_structure_char(context, &context->biosinformation.vendor, (const char*)data.bytes);
 	if (valuePointer != NULL)
 	{
 		CFRelease(valuePointer);
@@ -6421,7 +7848,7 @@ static void fill_up_bios_from_mac_equivalent()
 	extract_property_value_from_dictionary(propertiesDict, "#size-cells", &valuePointer);
 	data = valuePointer;
 	br_safe_sprintf(stringToPrint, 50, "%u MB", DWORD(data.bytes));
-	copy_to_structure_char(&biosinformation.biosromsize, stringToPrint);
+	copy_to_structure_char(context, &context->biosinformation.biosromsize, stringToPrint);
 	if (valuePointer != NULL)
 	{
 		CFRelease(valuePointer);
@@ -6431,7 +7858,7 @@ static void fill_up_bios_from_mac_equivalent()
 
 	// Again, maybe model-config property is BIOS characteristic equivalent
 
-	biosinformation.bIsFilled = true;
+	context->biosinformation.bIsFilled = true;
 
 	// Free Apple resources via handles
 	if (serviceDictionary != NULL)
@@ -6454,7 +7881,7 @@ static void fill_up_bios_from_mac_equivalent()
 	}
 }
 
-static void fill_up_ram_information()
+static void fill_up_ram_information(struct br_context* context)
 {
 	if (macPort == MACH_PORT_NULL)
 	{
@@ -6473,27 +7900,29 @@ static void fill_up_ram_information()
 	// 2.
 
 	// Assumption: only 1 ram
-	turingmachinesystemmemory.number_of_ram_or_system_memory_devices = 1;
+	context->turingmachinesystemmemory.number_of_ram_or_system_memory_devices = 1;
 
 	// Courtsey: https://stackoverflow.com/a/1396703
 	br_safe_sprintf(stringToPrint, 50, "%llu GB", [[NSProcessInfo processInfo]physicalMemory] / 1000000000);
 
-	copy_to_structure_char(&turingmachinesystemmemory.total_grand_capacity, stringToPrint);
-	copy_to_structure_char(&turingmachinesystemmemory.mounting_location, "System Board or Motherborad");
+	copy_to_structure_char(context, &context->turingmachinesystemmemory.total_grand_capacity, stringToPrint);
+	copy_to_structure_char(context, &context->turingmachinesystemmemory.mounting_location, "System Board or Motherborad");
+	context->turingmachinesystemmemory.total_grand_capacity_bytes = [[NSProcessInfo processInfo]physicalMemory];
 
-	allocate_and_initialize_memory_structure();
+	allocate_and_initialize_memory_structure(context);
 
-	randomaccessmemory[0].bIsFilled = true;
-	copy_to_structure_char(&randomaccessmemory[0].ramsize, stringToPrint);
-	copy_to_structure_char(&randomaccessmemory[0].memoryspeed, "Some Speed");
-	copy_to_structure_char(&randomaccessmemory[0].configuredmemoryspeed, "Some Speed");
-	copy_to_structure_char(&randomaccessmemory[0].formfactor, "Some Factor");
-	copy_to_structure_char(&randomaccessmemory[0].banklocator, "Some Locator");
-	copy_to_structure_char(&randomaccessmemory[0].operatingvoltage, "Some Voltage");
-	copy_to_structure_char(&randomaccessmemory[0].manufacturer, "Some Manufacturer");
+	context->randomaccessmemory[0].bIsFilled = true;
+	copy_to_structure_char(context, &context->randomaccessmemory[0].ramsize, stringToPrint);
+	context->randomaccessmemory[0].ramsizebytes = context->turingmachinesystemmemory.total_grand_capacity_bytes;
+	copy_to_structure_char(context, &context->randomaccessmemory[0].memoryspeed, "Some Speed");
+	copy_to_structure_char(context, &context->randomaccessmemory[0].configuredmemoryspeed, "Some Speed");
+	copy_to_structure_char(context, &context->randomaccessmemory[0].formfactor, "Some Factor");
+	copy_to_structure_char(context, &context->randomaccessmemory[0].banklocator, "Some Locator");
+	copy_to_structure_char(context, &context->randomaccessmemory[0].operatingvoltage, "Some Voltage");
+	copy_to_structure_char(context, &context->randomaccessmemory[0].manufacturer, "Some Manufacturer");
 }
 
-static void fill_up_processor_information()
+static void fill_up_processor_information(struct br_context* context)
 {
 	if (macPort == MACH_PORT_NULL)
 	{
@@ -6551,8 +7980,9 @@ static void fill_up_processor_information()
 
 			extract_property_value_from_dictionary(propertiesDict, "max_cpus", &valuePointer);
 			data = valuePointer;
-			br_safe_sprintf(stringToPrint, 50, "%u", DWORD(data.bytes));
-			copy_to_structure_char(&centralprocessinguint.corescount, stringToPrint);
+			context->centralprocessinguint.cores = DWORD(data.bytes);
+			br_safe_sprintf(stringToPrint, 50, "%u", context->centralprocessinguint.cores);
+			copy_to_structure_char(context, &context->centralprocessinguint.corescount, stringToPrint);
 			if (valuePointer != NULL)
 			{
 				CFRelease(valuePointer);
@@ -6614,8 +8044,9 @@ static void fill_up_processor_information()
 		}
 	}
 
+	context->centralprocessinguint.enabledcores = activeCores;
 	br_safe_sprintf(stringToPrint, 50, "%u", activeCores);
-	copy_to_structure_char(&centralprocessinguint.enabledcorescount, stringToPrint);
+	copy_to_structure_char(context, &context->centralprocessinguint.enabledcorescount, stringToPrint);
 
 	int64_t fetchedValue = 0;
 	size_t size = sizeof(fetchedValue);
@@ -6630,8 +8061,9 @@ static void fill_up_processor_information()
 	else
 	{
 		br_safe_sprintf(stringToPrint, 50, "%lld MHz", fetchedValue / 1000000);
+		context->centralprocessinguint.currentspeedmhz = (unsigned int)(fetchedValue / 1000000);
 	}
-	copy_to_structure_char(&centralprocessinguint.currentspeed, stringToPrint);
+	copy_to_structure_char(context, &context->centralprocessinguint.currentspeed, stringToPrint);
 
 	/*
 	 // The idea is to read sysctl.h file and look at the list of parameters, for instance
@@ -6653,7 +8085,7 @@ static void fill_up_processor_information()
 	{
 		br_safe_sprintf(stringToPrint, 50, "%lld MHz", fetchedValue / 1000000);
 	}
-	copy_to_structure_char(&centralprocessinguint.maximumspeed, stringToPrint);
+	copy_to_structure_char(context, &context->centralprocessinguint.maximumspeed, stringToPrint);
 
 	queryParam = "kern.clockrate";
 
@@ -6666,7 +8098,7 @@ static void fill_up_processor_information()
 	{
 		br_safe_sprintf(stringToPrint, 50, "%lld MHz", fetchedValue / 1000000);
 	}
-	copy_to_structure_char(&centralprocessinguint.externalclock, stringToPrint);
+	copy_to_structure_char(context, &context->centralprocessinguint.externalclock, stringToPrint);
 
 	queryParam = "kern.osversion";
 
@@ -6696,15 +8128,21 @@ static void fill_up_processor_information()
  **************************************************************************************************************************
  */
 
-static void mac_device_service_gauger()
+static void mac_device_service_gauger(struct br_context* context)
 {
 	// Check if run once only
 	IOMainPort(MACH_PORT_NULL, &macPort);
 
-	fill_up_bios_from_mac_equivalent();
-	fill_up_processor_information();
+	fill_up_bios_from_mac_equivalent(context);
+	fill_up_processor_information(context);
 
-	fill_up_ram_information();
+	fill_up_ram_information(context);
+
+	// No table, the one processor and the one array are all there is
+	context->processors = &context->centralprocessinguint;
+	context->processorCount = 1;
+	context->memoryarrays = &context->turingmachinesystemmemory;
+	context->arrayCount = 1;
 
 	// We shall begin by attempt to extract the Apple cpu clock speed
 	// Done and done
@@ -6712,6 +8150,77 @@ static void mac_device_service_gauger()
 }
 #endif
 
+/*
+ * The last structure of the index may run off the table (see dmi_index_build()), the buffer ends where the table does
+ */
+static int dmi_entry_truncated(const struct br_context* context, u32 i)
+{
+	return context->tableIndex.btruncated && i == context->tableIndex.count - 1;
+}
+
+/*
+ **************************************************************************************************************************
+ *
+ * Decoding (parsing) a single structure of the table, as found by the walk
+ * @param buf      The raw table
+ * @param i        Position of the structure in the index
+ * @param ver      SMBIOS version in octal system, right shifted by 8, converted to unsigned short (observe the u32 -> u16)
+ *
+ **************************************************************************************************************************
+ */
+
+static void dmi_table_decode_entry(struct br_context* context, u8* buf, u32 i, u16 ver)
+{
+	const struct dmi_structure_entry* entry = &context->tableIndex.entries[i];
+	u8* data = buf + entry->offset;
+	struct dmi_header h;
+	int binventoryItem;
+
+	to_dmi_header_indexed(context, &h, buf, entry);
+	binventoryItem = ((context->opt.type == NULL || context->opt.type[h.type])
+		&& (context->opt.handle == ~0U || context->opt.handle == h.handle)
+		&& !((h.type == 126 || h.type == 127))
+		&& !context->opt.string);
+
+	/* Make sure the whole structure fits in the table, nothing of it is read otherwise */
+	if (dmi_entry_truncated(context, i))
+	{
+		if (binventoryItem)
+		{
+			if (bDisplayOutput)
+			{
+				pr_handle(&h);
+			}
+			pr_struct_err("<TRUNCATED>");
+		}
+		pr_sep();
+		return;
+	}
+
+	/* Fixup a common mistake */
+	if (h.type == 34)
+	{
+		dmi_fixup_type_34(&h, binventoryItem);
+	}
+
+	// Ok it seems all checks are in place for this particular structure handle
+	// Now we can fill up relevant electonics structures
+	if (binventoryItem)
+	{
+		// Printing the inventory handle
+		if (bDisplayOutput)
+		{
+			pr_handle(&h);
+		}
+		// Handles for various electronics items (in the PC)
+		dmi_decode(context, &h, ver);
+	}
+	else if (context->opt.string != NULL && context->opt.string->type == h.type)
+	{
+		dmi_table_string(context, &h, data, ver);
+	}
+}
+
 /*
  **************************************************************************************************************************
  *
@@ -6726,156 +8235,243 @@ static void mac_device_service_gauger()
  **************************************************************************************************************************
  */
 
-static void dmi_table_decode(u8* buf, u32 len, u16 num, u16 ver, u32 flags)
+static void dmi_table_decode(struct br_context* context, u8* buf, u32 len, u16 num, u16 ver, u32 flags)
 {
 	u8* data;
-	int i = 0;
+	u32 i;
+
+	// Walk the table once, every pass below (and any later query) goes through the index
+	if (dmi_index_build(&context->tableIndex, buf, len, num, flags & FLAG_STOP_AT_EOT) == -1)
+	{
+		dmi_index_clear(&context->tableIndex);
+		return;
+	}
+
+	// Nothing else for the table behind a cached inventory, the records are there already
+	if (flags & FLAG_INDEX_ONLY)
+	{
+		context->loadedTable.buf = buf;
+		context->loadedTable.len = len;
+		context->loadedTable.ver = ver;
+		return;
+	}
 
 	/* First pass: Save specific values needed to decode OEM (Original Equipment Manufacturer) types */
 	// An original equipment manufacturer (OEM) traditionally is defined as a company whose goods are used
 	// as components in the products of another company, which then sells the finished item to users.
-	data = buf;
-	while ((i < num || !num) && data + 4 <= buf + len) /* 4 is the length (in bytes) of an SMBIOS structure header */
+	for (i = 0; i < context->tableIndex.count; i++)
 	{
-		u8* next;
+		const struct dmi_structure_entry* entry = &context->tableIndex.entries[i];
 		struct dmi_header h;
-
-		to_dmi_header(&h, data);
-
-		/*
-		 * If a short entry is found (less than 4 bytes), not only it
-		 * is invalid, but we cannot reliably locate the next entry.
-		 * Also stop at end-of-table marker if so instructed.
-		 */
-		if (h.length < 4 || (h.type == 127))
+
+		/* Stop at end-of-table marker */
+		if (entry->type == 127 || dmi_entry_truncated(context, i))
 		{
 			break;
 		}
 
+		data = buf + entry->offset;
+		to_dmi_header_indexed(context, &h, buf, entry);
+
 		/* Assign vendor for vendor-specific decodes later */
 		if (h.type == 1 && h.length >= 6)
 		{
-			dmi_set_vendor(_dmi_string(&h, data[0x04], 0), _dmi_string(&h, data[0x05], 0));
+			dmi_set_vendor(&context->oem, _dmi_string(&h, data[0x04], 0), _dmi_string(&h, data[0x05], 0));
 		}
 
 		/* Remember CPUID type for HPE type 199 */
-		if (h.type == 4 && h.length >= 0x1A && cpuid_type == cpuid_none)
+		if (h.type == 4 && h.length >= 0x1A && context->oem.cpuid_type == cpuid_none)
 		{
-			cpuid_type = dmi_get_cpuid_type(&h);
+			context->oem.cpuid_type = dmi_get_cpuid_type(&h);
 		}
+	}
+
+	// Exactly as many memory devices as there are type 17 structures. The count announced
+	// in Physical Memory Array (type 16) is a maximum and, more often than not, BIOS lies :(
+	context->turingmachinesystemmemory.number_of_ram_or_system_memory_devices = context->tableIndex.typecount[17];
+	allocate_and_initialize_memory_structure(context);
+
+	// Likewise a record for each processor, memory array and cache
+	context->processors = allocate_records(context, sizeof(struct central_processing_unit), 4, &context->processorCount);
+	context->memoryarrays = allocate_records(context, sizeof(struct turing_machine_system_memory), 16, &context->arrayCount);
+	context->processorcaches = allocate_records(context, sizeof(struct cpu_cache), 7, &context->cacheCount);
+	context->processorCounter = 0;
+	context->arrayCounter = 0;
+	context->cacheCounter = 0;
+
+	for (i = 0; i < DMI_RECORD_KINDS; i++)
+	{
+		context->records[i].records = allocate_records(context, recordKinds[i].layout.size, recordKinds[i].type, &context->records[i].count);
+		context->records[i].counter = 0;
+	}
 
-		/* Look for the next handle */
-		next = data + h.length;
+	// The table is kept around, categories get decoded out of it when asked for
+	context->loadedTable.buf = buf;
+	context->loadedTable.len = len;
+	context->loadedTable.ver = ver;
 
-		// Move forward till reach end or land on another DMI structure
-		while ((unsigned long)(next - buf + 1) < len && (next[0] != 0 || next[1] != 0))
+	/* Second pass: Actually decode the data, all of it, if it is to be displayed */
+	if (bDisplayOutput)
+	{
+		for (i = 0; i < context->tableIndex.count; i++)
 		{
-			next++;
+			dmi_table_decode_entry(context, buf, i, ver);
 		}
-		next += 2;
 
-		/* Make sure the whole structure fits in the table */
-		if ((unsigned long)(next - buf) > len)
-			break;
+		count_memory_devices_of_arrays(context);
 
-		data = next;
-		i++;
+		context->decodedCategories = ~0u & ~(1u << ps_graphicscard);
 	}
 
-	/* Second pass: Actually decode the data */
-	i = 0;
-	data = buf;
-	while ((i < num || !num) && data + 4 <= buf + len) /* 4 is the length of an SMBIOS structure header */
+	/*
+	 * If a short entry is found (less than 4 bytes), not only it
+	 * is invalid, but we cannot reliably locate the next entry.
+	 * Better stop at this point, and let the user know his/her
+	 * table is broken.
+	 */
+	if (context->tableIndex.bbroken)
 	{
-		u8* next;
-		struct dmi_header h;
-		int binventoryItem;
+		fprintf(stderr, "Invalid entry length (%u). DMI table is broken! Stop.\n\n", (unsigned int)context->tableIndex.brokenlength);
+	}
 
-		to_dmi_header(&h, data);
-		binventoryItem = ((opt.type == NULL || opt.type[h.type])
-			&& (opt.handle == ~0U || opt.handle == h.handle)
-			&& !((h.type == 126 || h.type == 127))
-			&& !opt.string);
+	/*
+	 * SMBIOS v3 64-bit entry points do not announce a structures count,
+	 * and only indicate a maximum size for the table.
+	 * https://github.com/ravimohan1991/BiosReader/wiki/Demystifying-the-RAW-BIOS-information
+	 */
 
-		/*
-		 * If a short entry is found (less than 4 bytes), not only it
-		 * is invalid, but we cannot reliably locate the next entry.
-		 * Better stop at this point, and let the user know his/her
-		 * table is broken.
-		 */
-		if (h.length < 4)
-		{
-			fprintf(stderr, "Invalid entry length (%u). DMI table is broken! Stop.\n\n", (unsigned int)h.length);
-			break;
-		}
+	if (num && context->tableIndex.decoded != num)
+	{
+		fprintf(stderr, "Wrong DMI structures count: %d announced, only %u decoded.\n", num, context->tableIndex.decoded);
+	}
+	if (context->tableIndex.consumed > len || (num && context->tableIndex.consumed < len))
+	{
+		fprintf(stderr, "Wrong DMI structures length: %u bytes announced, structures occupy %lu bytes.\n", len, context->tableIndex.consumed);
+	}
+}
 
-		/* Fixup a common mistake */
-		if (h.type == 34)
-		{
-			dmi_fixup_type_34(&h, binventoryItem);
-		}
+/*
+ **************************************************************************************************************************
+ *
+ * Fill up the electronics structures of one category (and only those) out of the loaded table, by decoding the
+ * SMBIOS types it is made of. The structures of a type are decoded in table order.
+ * @param informationCategory      The category of electronics being queried
+ *
+ **************************************************************************************************************************
+ */
 
-		// Ok it seems all checks are in place for this particular structure handle
-		// Now we can fill up relevant electonics structures
-		if (binventoryItem)
-		{
-			// Printing the inventory handle
-			if (bDisplayOutput)
-			{
-				pr_handle(&h);
-			}
-			// Handles for various electronics items (in the PC)
-			dmi_decode(&h, ver);
-		}
-		else if (opt.string != NULL && opt.string->type == h.type)
-		{
-			dmi_table_string(&h, data, ver);
-		}
+static void decode_category(struct br_context* context, enum bios_reader_information_classification informationCategory)
+{
+	static const u8 biosTypes[] = { 0 }; // 7.1 BIOS Information
+	static const u8 processorTypes[] = { 4, 7 }; // 7.5 Processor Information, 7.8 Cache Information
+	static const u8 languageTypes[] = { 13 }; // 7.14 BIOS Language Information
+	static const u8 memoryTypes[] = { 16, 17 }; // 7.17 Physical Memory Array, 7.18 Memory Device
+	static const u8 systemTypes[] = { 1 }; // 7.2 System Information
+	static const u8 motherboardTypes[] = { 2, 8, 9, 26, 28, 29 }; // 7.3 Baseboard, 7.9 Port Connector, 7.10 System Slots and the probes
+	static const u8 chassisTypes[] = { 3, 39 }; // 7.4 System Enclosure or Chassis, 7.40 System Power Supply
 
-		/* Look for the next handle */
-		next = data + h.length;
-		while ((unsigned long)(next - buf + 1) < len && (next[0] != 0 || next[1] != 0))
-		{
-			next++;
-		}
-		next += 2;
+	const u8* types = NULL;
+	size_t typeCount = 0;
+	u32 categoryBits = 1u << informationCategory;
+
+	switch (informationCategory)
+	{
+	case ss_bios:
+		types = biosTypes;
+		typeCount = sizeof(biosTypes);
+		break;
+
+	case ps_processor:
+		types = processorTypes;
+		typeCount = sizeof(processorTypes);
+		break;
+
+	case pi_bioslanguages:
+		types = languageTypes;
+		typeCount = sizeof(languageTypes);
+		break;
+
+	case pi_systemmemory:
+	case ps_systemmemory:
+		// Both sides of the same coin
+		types = memoryTypes;
+		typeCount = sizeof(memoryTypes);
+		categoryBits = (1u << pi_systemmemory) | (1u << ps_systemmemory);
+		break;
+
+	case pi_manufacturer:
+		types = systemTypes;
+		typeCount = sizeof(systemTypes);
+		break;
+
+	case ps_motherboard:
+		types = motherboardTypes;
+		typeCount = sizeof(motherboardTypes);
+		break;
+
+	case ps_chassis:
+		types = chassisTypes;
+		typeCount = sizeof(chassisTypes);
+		break;
 
-		/* Make sure the whole structure fits in the table */
-		if ((unsigned long)(next - buf) > len)
+	case ps_graphicscard:
+#ifndef BR_MAC_PLATFORM
+		// The graphics cards are those of the running machine, which a dump isn't about
+		if (!(context->opt.flags & FLAG_FROM_DUMP))
 		{
-			if (binventoryItem)
-			{
-				pr_struct_err("<TRUNCATED>");
-			}
-			pr_sep();
-			data = next;
-			break;
+			probe_graphics_processing_unit(context);
 		}
+#endif
+		break;
+
+	default:
+		break;
+	}
+
+	context->decodedCategories |= categoryBits;
+
+	// Mac fills up everything in one go, no table there
+	if (context->loadedTable.buf == NULL)
+	{
+		return;
+	}
 
-		data = next;
+	for (size_t t = 0; t < typeCount; t++)
+	{
+		u32 count;
+		const u32* entries = dmi_index_of_type(&context->tableIndex, types[t], &count);
 
-		/* SMBIOS v3 requires stopping at this marker */
-		if (h.type == 127 && (flags & FLAG_STOP_AT_EOT))
+		for (u32 k = 0; k < count; k++)
 		{
-			break;
+			dmi_table_decode_entry(context, context->loadedTable.buf, entries[k], context->loadedTable.ver);
 		}
-		i++;
 	}
 
-	/*
-	 * SMBIOS v3 64-bit entry points do not announce a structures count,
-	 * and only indicate a maximum size for the table.
-	 * https://github.com/ravimohan1991/BiosReader/wiki/Demystifying-the-RAW-BIOS-information
-	 */
+	if (categoryBits & (1u << ps_systemmemory))
+	{
+		count_memory_devices_of_arrays(context);
+	}
+}
 
-	if (num && i != num)
+/*
+ * Let go of the loaded table, the way it was obtained
+ */
+static void release_loaded_table(struct br_context* context)
+{
+	if (context->loadedTable.mapping.base != NULL)
 	{
-		fprintf(stderr, "Wrong DMI structures count: %d announced, only %d decoded.\n", num, i);
+		unmap_file(&context->loadedTable.mapping);
 	}
-	if ((unsigned long)(data - buf) > len || (num && (unsigned long)(data - buf) < len))
+	else if (context->loadedTable.allocation != NULL)
 	{
-		fprintf(stderr, "Wrong DMI structures length: %u bytes announced, structures occupy %lu bytes.\n", len, (unsigned long)(data - buf));
+		free(context->loadedTable.allocation);
 	}
+
+	context->loadedTable.buf = NULL;
+	context->loadedTable.len = 0;
+	context->loadedTable.mapping.base = NULL;
+	context->loadedTable.mapping.length = 0;
+	context->loadedTable.allocation = NULL;
 }
 
 /*
@@ -6897,33 +8493,40 @@ static void dmi_table_decode(u8* buf, u32 len, u16 num, u16 ver, u32 flags)
  *******************************************************************************************************
  */
 
-static void dmi_table(off_t base, u32 len, u16 num, u32 ver, const char* devmem, u32 flags)
+static void dmi_table(struct br_context* context, off_t base, u32 len, u16 num, u32 ver, const char* devmem, u32 flags)
 {
 	// 32-bit data reading is it?!
 	u8* buf;
 
-	if (ver > SUPPORTED_SMBIOS_VER)
-	{
-		pr_comment("SMBIOS implementations newer than version %u.%u.%u are not",
-			SUPPORTED_SMBIOS_VER >> 16,
-			(SUPPORTED_SMBIOS_VER >> 8) & 0xFF,
-			SUPPORTED_SMBIOS_VER & 0xFF);
-		pr_comment("fully supported by this version of BioseReader.");
-	}
+	// Where buf came from, so that we know how to let go of it
+	struct file_mapping tableMapping = { NULL, 0 };
+	int bOwnsBuffer = 0;
 
-	if (num)
+	if (!(context->opt.flags & FLAG_QUIET))
 	{
-		pr_info("%u structures occupying %u bytes.", num, len);
-	}
+		if (ver > SUPPORTED_SMBIOS_VER)
+		{
+			pr_comment("SMBIOS implementations newer than version %u.%u.%u are not",
+				SUPPORTED_SMBIOS_VER >> 16,
+				(SUPPORTED_SMBIOS_VER >> 8) & 0xFF,
+				SUPPORTED_SMBIOS_VER & 0xFF);
+			pr_comment("fully supported by this version of BioseReader.");
+		}
 
-	if (!(flags & FLAG_FROM_API))
-	{
-		pr_info("Table at 0x%08llX.", (unsigned long long)base);
-	}
+		if (num)
+		{
+			pr_info("%u structures occupying %u bytes.", num, len);
+		}
+
+		if (!(flags & FLAG_FROM_API))
+		{
+			pr_info("Table at 0x%08llX.", (unsigned long long)base);
+		}
 
-	pr_sep();
+		pr_sep();
+	}
 
-	if (flags & FLAG_NO_FILE_OFFSET)
+	if ((flags & FLAG_NO_FILE_OFFSET) || (context->opt.flags & FLAG_FROM_DUMP))
 	{
 		/*
 		 * When reading from sysfs or from a dump file, the file may be
@@ -6936,8 +8539,41 @@ static void dmi_table(off_t base, u32 len, u16 num, u32 ver, const char* devmem,
 		size_t size = len;
 		int errorSpit = 0;
 
-		// read the file /sys/firmware/dmi/tables/DMI (Ubuntu)
-		buf = read_file(flags & FLAG_NO_FILE_OFFSET ? 0 : base, &size, devmem, &errorSpit);
+		// sysfs has the table in a file of its own, dumps have it right after the entry point
+		off_t fileOffset = (flags & FLAG_NO_FILE_OFFSET) ? 0 : base;
+
+		// Zero-copy first: decode straight out of the mapped file.
+		// sysfs doesn't support mmap on /sys/firmware/dmi/tables/DMI (Ubuntu), so that one ends up being read,
+		// preferably into the pinned buffer so that there is no allocation per run.
+		buf = map_file(fileOffset, &size, devmem, &tableMapping);
+
+		if (buf == NULL)
+		{
+			u8* into = NULL;
+
+			size = len;
+
+			if (context->pinnedTableBuffer != NULL && size <= context->pinnedTableBufferSize)
+			{
+				into = context->pinnedTableBuffer;
+			}
+
+			// A dump is a file of the user's, it is read as such with no privilege raised (nor dropped)
+			if (context->opt.flags & FLAG_FROM_DUMP)
+			{
+				buf = read_user_file(fileOffset, &size, devmem, into, &errorSpit);
+			}
+			else if (into != NULL)
+			{
+				buf = read_file_into(fileOffset, &size, devmem, into, &errorSpit);
+			}
+			else
+			{
+				buf = read_file(fileOffset, &size, devmem, &errorSpit);
+			}
+
+			bOwnsBuffer = into == NULL;
+		}
 
 		//Sanity check!!
 		if (num && size != (size_t)len)
@@ -6945,10 +8581,14 @@ static void dmi_table(off_t base, u32 len, u16 num, u32 ver, const char* devmem,
 			fprintf(stderr, "Wrong DMI structures length: %u bytes "
 				"announced, only %lu bytes available.\n", len, (unsigned long)size);
 		}
+
+		// Never walk past what we actually have at hand
+		len = size;
 	}
 	else
 	{
 		buf = mem_chunk(base, len, devmem);
+		bOwnsBuffer = 1;
 	}
 
 	if (buf == NULL)
@@ -6964,9 +8604,14 @@ static void dmi_table(off_t base, u32 len, u16 num, u32 ver, const char* devmem,
 	}
 
 	// Let's boogie!
-	dmi_table_decode(buf, len, num, ver >> 8, flags);
+	dmi_table_decode(context, buf, len, num, ver >> 8, flags);
 
-	free(buf);
+	// Kept till reset, the categories are decoded out of it
+	context->loadedTable.mapping = tableMapping;
+	if (tableMapping.base == NULL && bOwnsBuffer)
+	{
+		context->loadedTable.allocation = buf;
+	}
 }
 
 /*
@@ -7014,8 +8659,7 @@ static void overwrite_smbios3_address(u8* buf)
  *
  *****************************************************************************************************************
  */
-#if defined (BR_LINUX_PLATFORM) || defined (BR_MAC_PLATFORM)
-static int smbios3_decode(u8* buf, const char* devmem, u32 flags)
+static int smbios3_decode(struct br_context* context, u8* buf, const char* devmem, u32 flags)
 {
 	u32 ver;
 	u64 offset;
@@ -7035,7 +8679,10 @@ static int smbios3_decode(u8* buf, const char* devmem, u32 flags)
 
 	// Extract the version (https://github.com/ravimohan1991/BiosReader/wiki/Demystifying-the-RAW-BIOS-information)
 	ver = (buf[0x07] << 16) + (buf[0x08] << 8) + buf[0x09];
-	pr_info("SMBIOS %u.%u.%u present.", buf[0x07], buf[0x08], buf[0x09]);
+	if (!(context->opt.flags & FLAG_QUIET))
+	{
+		pr_info("SMBIOS %u.%u.%u present.", buf[0x07], buf[0x08], buf[0x09]);
+	}
 
 	// offset for identifying the fully packed SMBIOS structures (containing electronics information)
 	// again, refer to (https://github.com/ravimohan1991/BiosReader/wiki/Demystifying-the-RAW-BIOS-information)
@@ -7052,26 +8699,214 @@ static int smbios3_decode(u8* buf, const char* devmem, u32 flags)
 
 	// Not really sure why trimming of upper part is needed when we have elminated that case earlier!?
 	// For version 3, the number of structures are not present in the table :(. So we feed zero
-	dmi_table((off_t)offset.h << 32 | offset.l, DWORD(buf + 0x0C), 0, ver, devmem, flags | FLAG_STOP_AT_EOT);
+	dmi_table(context, (off_t)offset.h << 32 | offset.l, DWORD(buf + 0x0C), 0, ver, devmem, flags | FLAG_STOP_AT_EOT);
+
+	return 1;
+}
+
+/*
+ *****************************************************************************************************************
+ *
+ * Same as above, for the 32-bit (SMBIOS 2.1 to 2.8) entry points, which are followed by a legacy (_DMI_) one
+ *
+ * @param buf           The entry point, at least 0x1F bytes
+ * @param devmem        The file containing the table
+ * @param flags         Passed on to dmi_table()
+ * @return int          1 on success and 0 on faliure
+ *
+ *****************************************************************************************************************
+ */
+
+static int smbios_decode(struct br_context* context, u8* buf, const char* devmem, u32 flags)
+{
+	u16 ver;
+
+	/* Don't let checksum run beyond the buffer */
+	if (buf[0x05] > 0x20)
+	{
+		fprintf(stderr,
+			"Entry point length too large (%u bytes, expected %u).\n",
+			(unsigned int)buf[0x05], 0x1FU);
+		return 0;
+	}
+
+	if (!checksum(buf, buf[0x05])
+		|| memcmp(buf + 0x10, "_DMI_", 5) != 0
+		|| !checksum(buf + 0x10, 0x0F))
+		return 0;
+
+	ver = (buf[0x06] << 8) + buf[0x07];
+
+	/* Some BIOS report weird SMBIOS version, fix that up */
+	switch (ver)
+	{
+	case 0x021F:
+	case 0x0221:
+		ver = 0x0203;
+		break;
+	case 0x0233:
+		ver = 0x0206;
+		break;
+	}
+
+	if (!(context->opt.flags & FLAG_QUIET))
+	{
+		pr_info("SMBIOS %u.%u present.", ver >> 8, ver & 0xFF);
+	}
+
+	dmi_table(context, DWORD(buf + 0x18), WORD(buf + 0x16), WORD(buf + 0x1C),
+		ver << 8, devmem, flags);
 
 	return 1;
 }
-#endif // BR_LINUX_PLATFORM
 
-static int legacy_decode(u8* buf, const char* devmem, u32 flags)
+static int legacy_decode(struct br_context* context, u8* buf, const char* devmem, u32 flags)
 {
 	if (!checksum(buf, 0x0F))
 		return 0;
 
-	pr_info("Legacy DMI %u.%u present.", buf[0x0E] >> 4, buf[0x0E] & 0x0F);
+	if (!(context->opt.flags & FLAG_QUIET))
+	{
+		pr_info("Legacy DMI %u.%u present.", buf[0x0E] >> 4, buf[0x0E] & 0x0F);
+	}
 
-	dmi_table(DWORD(buf + 0x08), WORD(buf + 0x06), WORD(buf + 0x0C),
+	dmi_table(context, DWORD(buf + 0x08), WORD(buf + 0x06), WORD(buf + 0x0C),
 		((buf[0x0E] & 0xF0) << 12) + ((buf[0x0E] & 0x0F) << 8),
 		devmem, flags);
 
 	return 1;
 }
 
+/*
+ *****************************************************************************************************************
+ *
+ * smbios3_decode() for the running machine, by way of the on-disk cache (see dmicache.h). Firmware tables hardly
+ * ever change between boots, so what was decoded out of this very table the last time round does as well as
+ * decoding it again, and needs neither the table nor the decode. A miss is decoded as usual, all of it, and saved
+ * for the next time.
+ *
+ * @param buf           The entry point, read from SYS_ENTRY_FILE
+ * @param length        Its length
+ * @return int          1 on success and 0 on faliure
+ *
+ *****************************************************************************************************************
+ */
+
+static int cached_smbios3_decode(struct br_context* context, u8* buf, size_t length)
+{
+#if defined (BR_LINUX_PLATFORM)
+	static const enum bios_reader_information_classification cachedCategories[] = {
+		ss_bios, ps_processor, pi_bioslanguages, ps_systemmemory, pi_manufacturer, ps_motherboard, ps_chassis
+	};
+	char cachePath[4096];
+	unsigned long long fingerprint;
+	struct stat tableStatistics;
+	u32 tableLength;
+
+	// The listing of a display run is what's wanted, that doesn't come out of a cache
+	if (bDisplayOutput || context->bNoCache || dmi_cache_path(cachePath, sizeof(cachePath)) != 0)
+	{
+		return smbios3_decode(context, buf, SYS_TABLE_FILE, FLAG_NO_FILE_OFFSET);
+	}
+
+	// The size of the table as the kernel has it, what the entry point says otherwise
+	tableLength = stat(SYS_TABLE_FILE, &tableStatistics) == 0 ? (u32)tableStatistics.st_size : DWORD(buf + 0x0C);
+	fingerprint = dmi_cache_fingerprint(buf, length, tableLength);
+
+	if (dmi_cache_load(context, fingerprint, cachePath))
+	{
+		context->bTableLeftOnDisk = 1;
+		return 1;
+	}
+
+	if (!smbios3_decode(context, buf, SYS_TABLE_FILE, FLAG_NO_FILE_OFFSET))
+	{
+		return 0;
+	}
+
+	if (context->loadedTable.buf != NULL)
+	{
+		for (size_t c = 0; c < ARRAY_SIZE(cachedCategories); c++)
+		{
+			if (!(context->decodedCategories & (1u << cachedCategories[c])))
+			{
+				decode_category(context, cachedCategories[c]);
+			}
+		}
+
+		dmi_cache_store(context, fingerprint, cachePath);
+	}
+
+	return 1;
+#else
+	return smbios3_decode(context, buf, SYS_TABLE_FILE, FLAG_NO_FILE_OFFSET);
+#endif
+}
+
+/*
+ * The table of the running machine, read and walked for a context whose inventory came out of the on-disk cache
+ * (see br_context_table_at_hand()). Only SMBIOS 3 entry points make it into the cache.
+ */
+static void index_table_of_cached_inventory(struct br_context* context)
+{
+	context->bTableLeftOnDisk = 0;
+
+#if defined (BR_LINUX_PLATFORM)
+	u8 entryPointBuffer[0x20];
+	size_t fileSize = 0x20;
+	int errorSpit = 0;
+
+	if (read_file_into(0, &fileSize, SYS_ENTRY_FILE, entryPointBuffer, &errorSpit) != NULL
+		&& fileSize >= 24 && memcmp(entryPointBuffer, "_SM3_", 5) == 0)
+	{
+		smbios3_decode(context, entryPointBuffer, SYS_TABLE_FILE, FLAG_NO_FILE_OFFSET | FLAG_INDEX_ONLY);
+	}
+#endif
+}
+
+/*
+ *****************************************************************************************************************
+ *
+ * Decode a table saved by write_dump() (dmidecode --dump-bin does the same): the entry point at the very
+ * beginning, with its table address patched to 32, and the table right there. Any of the three kinds of
+ * entry points will do, whichever machine the dump came from.
+ *
+ * @return int          1 on success and 0 on faliure
+ *
+ *****************************************************************************************************************
+ */
+
+static int dump_decode(struct br_context* context)
+{
+	const char* dumpfile = context->opt.devmem;
+	u8 entryPointBuffer[0x20];
+	size_t size = 0x20;
+	int errorSpit = 0;
+
+	// The user's own file, no privileges needed (see read_user_file())
+	if (read_user_file(0, &size, dumpfile, entryPointBuffer, &errorSpit) == NULL)
+	{
+		return 0;
+	}
+
+	if (size >= 24 && memcmp(entryPointBuffer, "_SM3_", 5) == 0)
+	{
+		return smbios3_decode(context, entryPointBuffer, dumpfile, 0);
+	}
+
+	if (size >= 31 && memcmp(entryPointBuffer, "_SM_", 4) == 0)
+	{
+		return smbios_decode(context, entryPointBuffer, dumpfile, 0);
+	}
+
+	if (size >= 15 && memcmp(entryPointBuffer, "_DMI_", 5) == 0)
+	{
+		return legacy_decode(context, entryPointBuffer, dumpfile, 0);
+	}
+
+	return 0;
+}
+
 /*
  * Probe for EFI interface
  */
@@ -7193,10 +9028,7 @@ int count_smbios_structures(u8* buff, u32 len)
 		 * increses the offset to point to the next header that's
 		 * after the strings at the end of the structure.
 		 */
-		while ((*(WORD*)offset != 0) && (offset < (buff + len)))
-		{
-			offset++;
-		}
+		offset = (u8*)dmi_find_double_nul(offset, buff + len);
 
 		/*
 		 * Points to the next stucture thas after two null BYTEs
@@ -7214,7 +9046,9 @@ int count_smbios_structures(u8* buff, u32 len)
  * Microsoft blocks access to physical memory.
  *
  * return - pointer to the SMBIOS table returned
- * by GetSystemFirmwareTable.
+ * by GetSystemFirmwareTable. Either the pinned
+ * buffer (see br_pin_table_buffer()) or a freshly
+ * allocated one which the caller frees.
  *
  * see RawSMBIOSData on winsmbios.h
  *
@@ -7241,7 +9075,7 @@ int count_smbios_structures(u8* buff, u32 len)
   * You can achieve access to the SMBIOS data in the MSSMBios_RawSMBiosTables class by using the class GUID, {8F680850-A584-11d1-BF38-00A0C9062910}.
  */
 
-PRawSMBIOSData get_raw_smbios_table(void)
+PRawSMBIOSData get_raw_smbios_table(struct br_context* context)
 {
 	void* buf = NULL;
 	u32 size = 0;
@@ -7249,7 +9083,16 @@ PRawSMBIOSData get_raw_smbios_table(void)
 	if (1)// Maybe add Windows version checker?
 	{
 		size = GetSystemFirmwareTable('RSMB', 0, buf, size);
-		buf = (void*)malloc(size);
+
+		// Reuse the pinned buffer if the caller was generous enough
+		if (context->pinnedTableBuffer != NULL && size <= context->pinnedTableBufferSize)
+		{
+			buf = context->pinnedTableBuffer;
+		}
+		else
+		{
+			buf = (void*)malloc(size);
+		}
 		GetSystemFirmwareTable('RSMB', 0, buf, size);
 	}
 
@@ -0,0 +1,378 @@
+/*
+ *   ----------------------------
+ *  |  dmiindex.c
+ *   ----------------------------
+ *   This file is part of BiosReader.
+ *
+ *   BiosReader is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   BiosReader is distributed in the hope and belief that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with BiosReader.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "types.h"
+#include "dmiindex.h"
+#include "dmiscan.h"
+
+/*
+ * Make room for more entries. Capacity only ever grows.
+ */
+static int dmi_index_grow(struct dmi_structure_index* index, u32 minimum)
+{
+	struct dmi_structure_entry* entries;
+	u32* bytype;
+	u32 capacity = index->capacity ? index->capacity : 64;
+
+	while (capacity < minimum)
+	{
+		capacity *= 2;
+	}
+
+	if (capacity == index->capacity)
+	{
+		return 0;
+	}
+
+	entries = realloc(index->entries, capacity * sizeof(struct dmi_structure_entry));
+	if (entries == NULL)
+	{
+		perror("realloc");
+		return -1;
+	}
+	index->entries = entries;
+
+	bytype = realloc(index->bytype, capacity * sizeof(u32));
+	if (bytype == NULL)
+	{
+		perror("realloc");
+		return -1;
+	}
+	index->bytype = bytype;
+
+	index->capacity = capacity;
+
+	return 0;
+}
+
+/*
+ * Make room for (at least) so many more string offsets.
+ */
+static int dmi_index_grow_strings(struct dmi_structure_index* index, u32 more)
+{
+	u32* strings;
+	u32 capacity = index->stringscapacity ? index->stringscapacity : 256;
+
+	while (capacity - index->stringsused < more)
+	{
+		capacity *= 2;
+	}
+
+	if (capacity == index->stringscapacity)
+	{
+		return 0;
+	}
+
+	strings = realloc(index->strings, capacity * sizeof(u32));
+	if (strings == NULL)
+	{
+		perror("realloc");
+		return -1;
+	}
+	index->strings = strings;
+	index->stringscapacity = capacity;
+
+	return 0;
+}
+
+/*
+ * Record where the strings of the string-set [first, last] live, last being the NUL
+ * which starts the double-NUL terminator. Strings are picked up exactly the way
+ * a linear lookup would, that is up to the first empty one. Only the first 255 are
+ * of any interest since strings are referred to by a BYTE.
+ */
+static int dmi_index_strings(struct dmi_structure_index* index, struct dmi_structure_entry* entry,
+	const u8* structure, const u8* first, const u8* last)
+{
+	const u8* p = first;
+	u32 most = (u32)(last - first) < 255 ? (u32)(last - first) : 255;
+	u32* offsets;
+	u16 count = 0;
+
+	// The strings plus the sentinel
+	if (dmi_index_grow_strings(index, most + 1) == -1)
+	{
+		return -1;
+	}
+
+	offsets = index->strings + index->stringsused;
+
+	while (*p && count < most)
+	{
+		offsets[count++] = (u32)(p - structure);
+
+		// last is a NUL, so the search is bound to succeed
+		p = (const u8*)memchr(p, 0, last - p + 1) + 1;
+	}
+	offsets[count] = (u32)(p - structure);
+
+	entry->firststring = index->stringsused;
+	entry->stringcount = count;
+	index->stringsused += count + 1;
+
+	return 0;
+}
+
+/*
+ * Fibonacci hashing, handles tend to come in runs (0x0400, 0x0401, ...) and this spreads them
+ */
+static u32 dmi_index_hash(u16 handle, u32 bits)
+{
+	return (u32)(handle * 2654435769u) >> (32 - bits);
+}
+
+/*
+ * Fill up the handle table out of the entries. Should the table carry a handle twice, the
+ * first structure wins, as it would for a linear search.
+ */
+static int dmi_index_hash_handles(struct dmi_structure_index* index)
+{
+	u32 bits = 4;
+	u32 mask;
+
+	while ((1u << bits) < index->count * 2)
+	{
+		bits++;
+	}
+
+	if (bits > index->handlebits)
+	{
+		u32* byhandle = realloc(index->byhandle, (1u << bits) * sizeof(u32));
+
+		if (byhandle == NULL)
+		{
+			perror("realloc");
+			return -1;
+		}
+		index->byhandle = byhandle;
+		index->handlebits = bits;
+	}
+
+	// Never shrinks, the table at hand is as good as any bigger one
+	bits = index->handlebits;
+	mask = (1u << bits) - 1;
+	memset(index->byhandle, 0, (mask + 1) * sizeof(u32));
+
+	for (u32 i = 0; i < index->count; i++)
+	{
+		u16 handle = index->entries[i].handle;
+		u32 slot = dmi_index_hash(handle, bits);
+
+		while (index->byhandle[slot] != 0 && index->entries[index->byhandle[slot] - 1].handle != handle)
+		{
+			slot = (slot + 1) & mask;
+		}
+
+		if (index->byhandle[slot] == 0)
+		{
+			index->byhandle[slot] = i + 1;
+		}
+	}
+
+	return 0;
+}
+
+/*
+ *************************************************************************************************
+ *
+ * Walk the table once and remember where every structure and its strings live.
+ * The walk mirrors what the decoding passes did on their own so far, quirks included.
+ * https://github.com/ravimohan1991/BiosReader/wiki/Demystifying-the-RAW-BIOS-information
+ *
+ * @param index                  The index to (re)fill. Zero initialize before first use
+ * @param buf                    The raw table
+ * @param len                    The size (in bytes) of the table
+ * @param num                    Announced number of structures, 0 if unknown (SMBIOS 3)
+ * @param bStopAtEndOfTable      Stop at the end-of-table marker (type 127)
+ * @return int                   0 on success, -1 on allocation failure
+ *
+ *************************************************************************************************
+ */
+
+int dmi_index_build(struct dmi_structure_index* index, const u8* buf, u32 len, u16 num, int bStopAtEndOfTable)
+{
+	const u8* data = buf;
+	u32 i = 0;
+	u32 t;
+
+	dmi_index_clear(index);
+
+	if (dmi_index_grow(index, len / 32 + 1) == -1)
+	{
+		return -1;
+	}
+
+	while ((i < num || !num) && data + 4 <= buf + len) /* 4 is the length of an SMBIOS structure header */
+	{
+		struct dmi_structure_entry* entry;
+		const u8* next;
+
+		/*
+		 * If a short entry is found (less than 4 bytes), not only it
+		 * is invalid, but we cannot reliably locate the next entry.
+		 */
+		if (data[1] < 4)
+		{
+			index->bbroken = 1;
+			index->brokenlength = data[1];
+			break;
+		}
+
+		if (index->count == index->capacity && dmi_index_grow(index, index->count + 1) == -1)
+		{
+			return -1;
+		}
+
+		entry = &index->entries[index->count++];
+		entry->type = data[0];
+		entry->length = data[1];
+		entry->handle = WORD(data + 2);
+		entry->offset = (u32)(data - buf);
+		entry->stringoffset = entry->offset + entry->length;
+
+		index->typecount[entry->type]++;
+
+		/* Look for the next handle */
+		next = dmi_find_double_nul(data + entry->length, buf + len);
+
+		// Strings of a structure running off the table are left to the linear lookup
+		entry->firststring = DMI_NO_STRING_TABLE;
+		entry->stringcount = 0;
+		if (next + 1 < buf + len && dmi_index_strings(index, entry, data, buf + entry->stringoffset, next) == -1)
+		{
+			return -1;
+		}
+
+		next += 2;
+
+		/* Make sure the whole structure fits in the table */
+		if ((unsigned long)(next - buf) > len)
+		{
+			index->btruncated = 1;
+			data = next;
+			break;
+		}
+
+		data = next;
+
+		/* SMBIOS v3 requires stopping at this marker */
+		if (entry->type == 127 && bStopAtEndOfTable)
+		{
+			break;
+		}
+		i++;
+	}
+
+	index->decoded = i;
+	index->consumed = (unsigned long)(data - buf);
+
+	// Group the entries by type, in table order
+	index->typefirst[0] = 0;
+	for (t = 1; t < 256; t++)
+	{
+		index->typefirst[t] = index->typefirst[t - 1] + index->typecount[t - 1];
+	}
+
+	{
+		u32 cursor[256];
+
+		memcpy(cursor, index->typefirst, sizeof(cursor));
+		for (i = 0; i < index->count; i++)
+		{
+			struct dmi_structure_entry* entry = &index->entries[i];
+
+			entry->ordinal = cursor[entry->type] - index->typefirst[entry->type];
+			index->bytype[cursor[entry->type]++] = i;
+		}
+	}
+
+	// Cross references (cache handles, array handles and so on) get resolved through this
+	return dmi_index_hash_handles(index);
+}
+
+/*
+ * Entries (as positions in index->entries) of the given type, in table order.
+ */
+const u32* dmi_index_of_type(const struct dmi_structure_index* index, u8 type, u32* count)
+{
+	*count = index->typecount[type];
+
+	return index->bytype + index->typefirst[type];
+}
+
+/*
+ * The structure with the given handle, NULL if there is none.
+ */
+const struct dmi_structure_entry* dmi_index_of_handle(const struct dmi_structure_index* index, u16 handle)
+{
+	u32 mask;
+	u32 slot;
+
+	if (index->count == 0)
+	{
+		return NULL;
+	}
+
+	mask = (1u << index->handlebits) - 1;
+	slot = dmi_index_hash(handle, index->handlebits);
+
+	while (index->byhandle[slot] != 0)
+	{
+		const struct dmi_structure_entry* entry = &index->entries[index->byhandle[slot] - 1];
+
+		if (entry->handle == handle)
+		{
+			return entry;
+		}
+
+		slot = (slot + 1) & mask;
+	}
+
+	return NULL;
+}
+
+/*
+ * Forget the table (without giving the memory back), until the next dmi_index_build().
+ */
+void dmi_index_clear(struct dmi_structure_index* index)
+{
+	index->count = 0;
+	index->stringsused = 0;
+	index->decoded = 0;
+	index->consumed = 0;
+	index->btruncated = 0;
+	index->bbroken = 0;
+	index->brokenlength = 0;
+	memset(index->typecount, 0, sizeof(index->typecount));
+	memset(index->typefirst, 0, sizeof(index->typefirst));
+}
+
+void dmi_index_release(struct dmi_structure_index* index)
+{
+	free(index->entries);
+	free(index->bytype);
+	free(index->strings);
+	free(index->byhandle);
+	memset(index, 0, sizeof(*index));
+}
@@ -28,23 +28,6 @@
 #include "dmiopt.h"
 #include "dmioutput.h"
 
- /*
-  * Globals for vendor-specific decodes
-  */
-
-enum DMI_VENDORS
-{
-	VENDOR_UNKNOWN,
-	VENDOR_ACER,
-	VENDOR_HP,
-	VENDOR_HPE,
-	VENDOR_IBM,
-	VENDOR_LENOVO,
-};
-
-static enum DMI_VENDORS dmi_vendor = VENDOR_UNKNOWN;
-static const char* dmi_product = NULL;
-
 /*
  * Remember the system vendor for later use. We only actually store the
  * value if we know how to decode at least one specific entry type for
@@ -53,7 +36,7 @@ static const char* dmi_product = NULL;
 
  // Please visit https://en.wikipedia.org/wiki/Desktop_Management_Interface for
  // bon-appatite
-void dmi_set_vendor(const char* v, const char* p)
+void dmi_set_vendor(struct dmi_oem_state* state, const char* v, const char* p)
 {
 	// The list may nut be exhaustive a good start nevertheless!
 	const struct { const char* str; enum DMI_VENDORS id; } vendor[] = {
@@ -81,12 +64,12 @@ void dmi_set_vendor(const char* v, const char* p)
 		if (strlen(vendor[i].str) == len &&
 			strncmp(v, vendor[i].str, len) == 0)
 		{
-			dmi_vendor = vendor[i].id;
+			state->vendor = vendor[i].id;
 			break;
 		}
 	}
 
-	dmi_product = p;
+	state->product = p;
 }
 
 /*
@@ -137,18 +120,17 @@ static int dmi_decode_acer(const struct dmi_header* h)
  * Code contributed by John Cagle and Tyler Bell.
  */
 
-static void dmi_print_hp_net_iface_rec(u8 id, u8 bus, u8 dev, const u8* mac)
+static void dmi_print_hp_net_iface_rec(struct dmi_oem_state* state, u8 id, u8 bus, u8 dev, const u8* mac)
 {
 	/* Some systems do not provide an id. nic_ctr provides an artificial
 	 * id, and assumes the records will be provided "in order".  Also,
 	 * using 0xFF marker is not future proof. 256 NICs is a lot, but
 	 * 640K ought to be enough for anybody(said no one, ever).
 	 * */
-	static u8 nic_ctr;
 	char attr[8];
 
 	if (id == 0xFF)
-		id = ++nic_ctr;
+		id = ++state->nic_ctr;
 
 	br_safe_sprintf(attr, 8, "NIC %hhu", id);
 	if (dev == 0x00 && bus == 0x00)
@@ -166,7 +148,7 @@ static void dmi_print_hp_net_iface_rec(u8 id, u8 bus, u8 dev, const u8* mac)
 
 typedef enum { G6 = 6, G7, G8, G9, G10, G10P } dmi_hpegen_t;
 
-static int dmi_hpegen(const char* s)
+static int dmi_hpegen(const struct dmi_oem_state* state, const char* s)
 {
 	struct { const char* name; dmi_hpegen_t gen; } table[] = {
 		{ "Gen10 Plus",	G10P },
@@ -187,7 +169,7 @@ static int dmi_hpegen(const char* s)
 			return(table[i].gen);
 	}
 
-	return (dmi_vendor == VENDOR_HPE) ? G10P : G6;
+	return (state->vendor == VENDOR_HPE) ? G10P : G6;
 }
 
 static void dmi_hp_240_attr(u64 defined, u64 set)
@@ -466,15 +448,15 @@ static void dmi_hp_238_speed(const char* fname, unsigned int code)
 	pr_attr(fname, "%s", str);
 }
 
-static int dmi_decode_hp(const struct dmi_header* h)
+static int dmi_decode_hp(struct dmi_oem_state* state, const struct dmi_header* h)
 {
 	u8* data = h->data;
 	int nic, ptr;
 	u32 feat;
-	const char* company = (dmi_vendor == VENDOR_HP) ? "HP" : "HPE";
+	const char* company = (state->vendor == VENDOR_HP) ? "HP" : "HPE";
 	int gen;
 
-	gen = dmi_hpegen(dmi_product);
+	gen = dmi_hpegen(state, state->product);
 	if (gen < 0)
 		return 0;
 
@@ -520,10 +502,10 @@ static int dmi_decode_hp(const struct dmi_header* h)
 			u32 date;
 
 			/* AMD omits BaseFamily. Reconstruction valid on family >= 15. */
-			if (cpuid_type == cpuid_x86_amd)
+			if (state->cpuid_type == cpuid_x86_amd)
 				cpuid = ((cpuid & 0xfff00) << 8) | 0x0f00 | (cpuid & 0xff);
 
-			dmi_print_cpuid(pr_attr, "CPU ID", cpuid_type, (u8*)&cpuid);
+			dmi_print_cpuid(NULL, pr_attr, "CPU ID", state->cpuid_type, (u8*)&cpuid);
 
 			date = DWORD(data + ptr + 4);
 			pr_subattr("Date", "%04x-%02x-%02x",
@@ -663,7 +645,7 @@ static int dmi_decode_hp(const struct dmi_header* h)
 		ptr = 4;
 		while (h->length >= ptr + 8)
 		{
-			dmi_print_hp_net_iface_rec(nic,
+			dmi_print_hp_net_iface_rec(state, nic,
 				data[ptr + 0x01],
 				data[ptr],
 				&data[ptr + 0x02]);
@@ -798,7 +780,7 @@ static int dmi_decode_hp(const struct dmi_header* h)
 		 * use 0xFF to use the internal counter.
 		 * */
 		nic = h->length > 0x28 ? data[0x28] : 0xFF;
-		dmi_print_hp_net_iface_rec(nic, data[0x06], data[0x07],
+		dmi_print_hp_net_iface_rec(state, nic, data[0x06], data[0x07],
 			&data[0x08]);
 		break;
 
@@ -1069,13 +1051,13 @@ static int dmi_decode_ibm_lenovo(const struct dmi_header* h)
  * Dispatch vendor-specific entries decoding
  * Return 1 if decoding was successful, 0 otherwise
  */
-int dmi_decode_oem(const struct dmi_header* h)
+int dmi_decode_oem(struct dmi_oem_state* state, const struct dmi_header* h)
 {
-	switch (dmi_vendor)
+	switch (state->vendor)
 	{
 	case VENDOR_HP:
 	case VENDOR_HPE:
-		return dmi_decode_hp(h);
+		return dmi_decode_hp(state, h);
 	case VENDOR_ACER:
 		return dmi_decode_acer(h);
 	case VENDOR_IBM:
@@ -20,117 +20,840 @@
 
 #include <stdarg.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include "dmioutput.h"
 
-void pr_comment(const char *format, ...)
+BR_THREAD_LOCAL const struct br_output_sink *currentOutputSink;
+
+const struct br_output_sink *pr_bind_sink(const struct br_output_sink *sink)
 {
-	va_list args;
+	const struct br_output_sink *previous = currentOutputSink;
 
-	printf("# ");
-	va_start(args, format);
-	vprintf(format, args);
-	va_end(args);
-	printf("\n");
+	currentOutputSink = sink;
+
+	return previous;
 }
 
-void pr_info(const char *format, ...)
+/*
+ * A growable buffer, for the sinks which format before they write
+ */
+struct pr_buffer
 {
-	va_list args;
+	char *data;
+	size_t length;
+	size_t capacity;
+	int bFailed; // ran out of memory at some point
+};
 
-	va_start(args, format);
-	vprintf(format, args);
-	va_end(args);
-	printf("\n");
+static int buffer_reserve(struct pr_buffer *buffer, size_t extra)
+{
+	size_t capacity;
+	char *data;
+
+	if (buffer->length + extra <= buffer->capacity)
+	{
+		return 0;
+	}
+
+	capacity = buffer->capacity ? buffer->capacity : 4096;
+	while (capacity < buffer->length + extra)
+	{
+		capacity *= 2;
+	}
+
+	data = realloc(buffer->data, capacity);
+	if (data == NULL)
+	{
+		buffer->bFailed = 1;
+		return -1;
+	}
+
+	buffer->data = data;
+	buffer->capacity = capacity;
+
+	return 0;
+}
+
+static void buffer_append(struct pr_buffer *buffer, const char *text, size_t length)
+{
+	if (length != 0 && buffer_reserve(buffer, length) == 0)
+	{
+		memcpy(buffer->data + buffer->length, text, length);
+		buffer->length += length;
+	}
+}
+
+static void buffer_append_literal(struct pr_buffer *buffer, const char *text)
+{
+	buffer_append(buffer, text, strlen(text));
+}
+
+/* Formatted, as it is, at the end of the buffer, and NUL terminated */
+static int buffer_format(struct pr_buffer *buffer, const char *format, va_list args)
+{
+	va_list retry;
+	size_t room;
+	int length;
+
+	if (buffer_reserve(buffer, 128) != 0)
+	{
+		return -1;
+	}
+
+	va_copy(retry, args);
+
+	room = buffer->capacity - buffer->length;
+	length = vsnprintf(buffer->data + buffer->length, room, format, args);
+	if (length >= 0 && (size_t)length >= room)
+	{
+		if (buffer_reserve(buffer, (size_t)length + 1) == 0)
+		{
+			length = vsnprintf(buffer->data + buffer->length, (size_t)length + 1, format, retry);
+		}
+		else
+		{
+			length = -1;
+		}
+	}
+
+	va_end(retry);
+
+	if (length < 0)
+	{
+		buffer->data[buffer->length] = '\0';
+		return -1;
+	}
+
+	buffer->length += (size_t)length;
+
+	return 0;
+}
+
+void br_output_sink_destroy(struct br_output_sink *sink)
+{
+	if (sink != NULL && sink->release != NULL)
+	{
+		sink->release(sink);
+	}
+}
+
+/*
+ **********************************************************
+ * The pr_* functions themselves, handing over to the sink
+ * bound to the thread. Nothing happens without one.
+ *
+ **********************************************************
+ */
+
+#define FORWARD(handler, ...) \
+	do \
+	{ \
+		const struct br_output_sink *sink = currentOutputSink; \
+		va_list args; \
+		\
+		if (sink == NULL || sink->handler == NULL) \
+		{ \
+			return; \
+		} \
+		\
+		va_start(args, format); \
+		sink->handler(sink->userdata, __VA_ARGS__, args); \
+		va_end(args); \
+	} while (0)
+
+void pr_document_start(void)
+{
+	if (currentOutputSink != NULL && currentOutputSink->document_start != NULL)
+	{
+		currentOutputSink->document_start(currentOutputSink->userdata);
+	}
+}
+
+void pr_document_end(void)
+{
+	if (currentOutputSink != NULL && currentOutputSink->document_end != NULL)
+	{
+		currentOutputSink->document_end(currentOutputSink->userdata);
+	}
+}
+
+void pr_comment(const char *format, ...)
+{
+	FORWARD(comment, format);
+}
+
+void pr_info(const char *format, ...)
+{
+	FORWARD(info, format);
 }
 
 void pr_handle(const struct dmi_header *h)
 {
-	printf("Handle 0x%04X, DMI type %d, %d bytes\n",
-	       h->handle, h->type, h->length);
+	if (currentOutputSink != NULL && currentOutputSink->handle != NULL)
+	{
+		currentOutputSink->handle(currentOutputSink->userdata, h);
+	}
 }
 
 void pr_handle_name(const char *format, ...)
 {
-	va_list args;
-
-	va_start(args, format);
-	vprintf(format, args);
-	va_end(args);
-	printf("\n");
+	FORWARD(handle_name, format);
 }
 
 void pr_attr(const char *name, const char *format, ...)
 {
-	va_list args;
+	FORWARD(attr, name, format);
+}
 
-	printf("\t%s: ", name);
+void pr_subattr(const char *name, const char *format, ...)
+{
+	FORWARD(subattr, name, format);
+}
+
+void pr_list_start(const char *name, const char *format, ...)
+{
+	FORWARD(list_start, name, format);
+}
+
+void pr_list_item(const char *format, ...)
+{
+	FORWARD(list_item, format);
+}
+
+void pr_list_end(void)
+{
+	if (currentOutputSink != NULL && currentOutputSink->list_end != NULL)
+	{
+		currentOutputSink->list_end(currentOutputSink->userdata);
+	}
+}
+
+void pr_sep(void)
+{
+	if (currentOutputSink != NULL && currentOutputSink->sep != NULL)
+	{
+		currentOutputSink->sep(currentOutputSink->userdata);
+	}
+}
+
+void pr_struct_err(const char *format, ...)
+{
+	FORWARD(struct_err, format);
+}
+
+/*
+ **********************************************************
+ * Text sink, dmidecode's listing
+ *
+ **********************************************************
+ */
 
-	va_start(args, format);
+static void text_document_end(void *userdata)
+{
+	fflush(stdout);
+}
+
+static void text_comment(void *userdata, const char *format, va_list args)
+{
+	printf("# ");
 	vprintf(format, args);
-	va_end(args);
 	printf("\n");
 }
 
-void pr_subattr(const char *name, const char *format, ...)
+static void text_line(void *userdata, const char *format, va_list args)
 {
-	va_list args;
+	vprintf(format, args);
+	printf("\n");
+}
 
-	printf("\t\t%s: ", name);
+static void text_handle(void *userdata, const struct dmi_header *h)
+{
+	printf("Handle 0x%04X, DMI type %d, %d bytes\n",
+	       h->handle, h->type, h->length);
+}
 
-	va_start(args, format);
+static void text_attr(void *userdata, const char *name, const char *format, va_list args)
+{
+	printf("\t%s: ", name);
 	vprintf(format, args);
-	va_end(args);
 	printf("\n");
 }
 
-void pr_list_start(const char *name, const char *format, ...)
+static void text_subattr(void *userdata, const char *name, const char *format, va_list args)
 {
-	va_list args;
+	printf("\t\t%s: ", name);
+	vprintf(format, args);
+	printf("\n");
+}
 
+static void text_list_start(void *userdata, const char *name, const char *format, va_list args)
+{
 	printf("\t%s:", name);
 
 	/* format is optional, skip value if not provided */
 	if (format)
 	{
 		printf(" ");
-		va_start(args, format);
 		vprintf(format, args);
-		va_end(args);
 	}
 	printf("\n");
-
 }
 
-void pr_list_item(const char *format, ...)
+static void text_list_item(void *userdata, const char *format, va_list args)
 {
-	va_list args;
-
 	printf("\t\t");
-
-	va_start(args, format);
 	vprintf(format, args);
-	va_end(args);
 	printf("\n");
 }
 
-void pr_list_end(void)
+static void text_sep(void *userdata)
 {
-	/* a no-op for text output */
+	printf("\n");
 }
 
-void pr_sep(void)
+static void text_struct_err(void *userdata, const char *format, va_list args)
 {
+	printf("\t");
+	vprintf(format, args);
 	printf("\n");
 }
 
-void pr_struct_err(const char *format, ...)
+static const struct br_output_sink textSink =
 {
-	va_list args;
+	NULL, // document_start
+	text_document_end,
+	text_comment,
+	text_line, // info
+	text_handle,
+	text_line, // handle_name
+	text_attr,
+	text_subattr,
+	text_list_start,
+	text_list_item,
+	NULL, // list_end, a no-op for text output
+	text_sep,
+	text_struct_err,
+	NULL, // release
+	NULL
+};
 
-	printf("\t");
+const struct br_output_sink *br_text_output_sink(void)
+{
+	return &textSink;
+}
 
-	va_start(args, format);
-	vprintf(format, args);
-	va_end(args);
-	printf("\n");
+/*
+ **********************************************************
+ * JSON sink. The document is put together in memory and
+ * written out in one go at the end of the run. Messages
+ * (comments, info and anything said outside of a
+ * structure) and structures are kept apart, so that each
+ * ends up an array of its own.
+ *
+ **********************************************************
+ */
+
+enum json_list
+{
+	JSON_NO_LIST,
+	JSON_LIST, // "name": [ items ]
+	JSON_VALUED_LIST // "name": { "value": value, "items": [ items ] }
+};
+
+struct json_sink
+{
+	struct br_output_sink sink; // first, see json_release()
+	FILE *stream;
+
+	struct pr_buffer messages;
+	struct pr_buffer structures;
+	struct pr_buffer scratch; // formatted, yet to be escaped
+
+	int bInStructure;
+	int bInAttributes;
+	enum json_list listKind;
+	int bListEmpty;
+};
+
+/*
+ * A JSON string out of whatever the firmware had to say. Bytes above 0x7F are
+ * taken for Latin-1, which SMBIOS strings mostly are when they aren't ASCII,
+ * so that the document stays valid UTF-8 no matter what.
+ */
+static void json_append_string(struct pr_buffer *buffer, const char *text, size_t length)
+{
+	static const char hex[] = "0123456789abcdef";
+	char *out;
+
+	/* At worst six bytes per byte, and the quotes */
+	if (buffer_reserve(buffer, length * 6 + 2) != 0)
+	{
+		return;
+	}
+
+	out = buffer->data + buffer->length;
+
+	*out++ = '"';
+	for (size_t i = 0; i < length; i++)
+	{
+		unsigned char c = (unsigned char)text[i];
+
+		switch (c)
+		{
+		case '"':
+			*out++ = '\\';
+			*out++ = '"';
+			break;
+		case '\\':
+			*out++ = '\\';
+			*out++ = '\\';
+			break;
+		case '\n':
+			*out++ = '\\';
+			*out++ = 'n';
+			break;
+		case '\t':
+			*out++ = '\\';
+			*out++ = 't';
+			break;
+		default:
+			if (c < 0x20 || c == 0x7F)
+			{
+				memcpy(out, "\\u00", 4);
+				out[4] = hex[c >> 4];
+				out[5] = hex[c & 0x0F];
+				out += 6;
+			}
+			else if (c >= 0x80)
+			{
+				*out++ = (char)(0xC0 | (c >> 6));
+				*out++ = (char)(0x80 | (c & 0x3F));
+			}
+			else
+			{
+				*out++ = (char)c;
+			}
+			break;
+		}
+	}
+	*out++ = '"';
+
+	buffer->length = (size_t)(out - buffer->data);
+}
+
+static void json_append_formatted(struct json_sink *json, struct pr_buffer *buffer, const char *format, va_list args)
+{
+	/* Something has to stand there, an empty string if need be */
+	json->scratch.length = 0;
+	buffer_format(&json->scratch, format, args);
+	json_append_string(buffer, json->scratch.data, json->scratch.length);
+}
+
+static void json_message(struct json_sink *json, const char *name, const char *format, va_list args)
+{
+	if (json->messages.length != 0)
+	{
+		buffer_append_literal(&json->messages, ",");
+	}
+
+	/* Said outside of a structure, the name goes into the message */
+	json->scratch.length = 0;
+	if (name != NULL)
+	{
+		buffer_append_literal(&json->scratch, name);
+		buffer_append_literal(&json->scratch, ": ");
+	}
+
+	buffer_format(&json->scratch, format, args);
+	json_append_string(&json->messages, json->scratch.data, json->scratch.length);
+}
+
+static void json_close_list(struct json_sink *json)
+{
+	if (json->listKind == JSON_LIST)
+	{
+		buffer_append_literal(&json->structures, "]");
+	}
+	else if (json->listKind == JSON_VALUED_LIST)
+	{
+		buffer_append_literal(&json->structures, "]}");
+	}
+
+	json->listKind = JSON_NO_LIST;
+}
+
+static void json_close_structure(struct json_sink *json)
+{
+	if (!json->bInStructure)
+	{
+		return;
+	}
+
+	json_close_list(json);
+
+	if (json->bInAttributes)
+	{
+		buffer_append_literal(&json->structures, "}");
+	}
+	buffer_append_literal(&json->structures, "}");
+
+	json->bInStructure = 0;
+	json->bInAttributes = 0;
+}
+
+/* "name": of the next attribute of the open structure */
+static void json_attribute(struct json_sink *json, const char *name)
+{
+	json_close_list(json);
+
+	buffer_append_literal(&json->structures, json->bInAttributes ? "," : ",\"attributes\":{");
+	json->bInAttributes = 1;
+
+	json_append_string(&json->structures, name, strlen(name));
+	buffer_append_literal(&json->structures, ":");
+}
+
+static void json_document_start(void *userdata)
+{
+	struct json_sink *json = userdata;
+
+	json->messages.length = 0;
+	json->structures.length = 0;
+	json->messages.bFailed = 0;
+	json->structures.bFailed = 0;
+	json->scratch.bFailed = 0;
+	json->bInStructure = 0;
+	json->bInAttributes = 0;
+	json->listKind = JSON_NO_LIST;
+}
+
+static void json_document_end(void *userdata)
+{
+	struct json_sink *json = userdata;
+
+	json_close_structure(json);
+
+	/* The whole document, in one buffer and one write */
+	json->scratch.length = 0;
+	buffer_append_literal(&json->scratch, "{\"messages\":[");
+	buffer_append(&json->scratch, json->messages.data, json->messages.length);
+	buffer_append_literal(&json->scratch, "],\"structures\":[");
+	buffer_append(&json->scratch, json->structures.data, json->structures.length);
+	buffer_append_literal(&json->scratch, "]}\n");
+
+	if (json->messages.bFailed || json->structures.bFailed || json->scratch.bFailed)
+	{
+		fprintf(stderr, "Out of memory, JSON output dropped\n");
+		return;
+	}
+
+	fwrite(json->scratch.data, 1, json->scratch.length, json->stream);
+	fflush(json->stream);
+}
+
+static void json_info(void *userdata, const char *format, va_list args)
+{
+	json_message(userdata, NULL, format, args);
+}
+
+static void json_handle(void *userdata, const struct dmi_header *h)
+{
+	struct json_sink *json = userdata;
+	char opening[64];
+
+	json_close_structure(json);
+
+	snprintf(opening, sizeof(opening), "%s{\"handle\":%u,\"type\":%u,\"length\":%u",
+		json->structures.length != 0 ? "," : "", h->handle, h->type, h->length);
+	buffer_append_literal(&json->structures, opening);
+
+	json->bInStructure = 1;
+}
+
+static void json_handle_name(void *userdata, const char *format, va_list args)
+{
+	struct json_sink *json = userdata;
+
+	if (json->bInStructure && !json->bInAttributes)
+	{
+		buffer_append_literal(&json->structures, ",\"name\":");
+		json_append_formatted(json, &json->structures, format, args);
+	}
+	else
+	{
+		json_message(json, NULL, format, args);
+	}
+}
+
+/* Subattributes go along with the attributes, JSON has no use for the indentation */
+static void json_attr(void *userdata, const char *name, const char *format, va_list args)
+{
+	struct json_sink *json = userdata;
+
+	if (json->bInStructure)
+	{
+		json_attribute(json, name);
+		json_append_formatted(json, &json->structures, format, args);
+	}
+	else
+	{
+		json_message(json, name, format, args);
+	}
+}
+
+static void json_list_start(void *userdata, const char *name, const char *format, va_list args)
+{
+	struct json_sink *json = userdata;
+
+	if (!json->bInStructure)
+	{
+		return;
+	}
+
+	json_attribute(json, name);
+
+	if (format)
+	{
+		buffer_append_literal(&json->structures, "{\"value\":");
+		json_append_formatted(json, &json->structures, format, args);
+		buffer_append_literal(&json->structures, ",\"items\":[");
+		json->listKind = JSON_VALUED_LIST;
+	}
+	else
+	{
+		buffer_append_literal(&json->structures, "[");
+		json->listKind = JSON_LIST;
+	}
+
+	json->bListEmpty = 1;
+}
+
+static void json_list_item(void *userdata, const char *format, va_list args)
+{
+	struct json_sink *json = userdata;
+
+	if (json->listKind == JSON_NO_LIST)
+	{
+		json_message(json, NULL, format, args);
+		return;
+	}
+
+	if (!json->bListEmpty)
+	{
+		buffer_append_literal(&json->structures, ",");
+	}
+	json_append_formatted(json, &json->structures, format, args);
+	json->bListEmpty = 0;
+}
+
+static void json_list_end(void *userdata)
+{
+	json_close_list(userdata);
+}
+
+static void json_sep(void *userdata)
+{
+	json_close_structure(userdata);
+}
+
+static void json_struct_err(void *userdata, const char *format, va_list args)
+{
+	struct json_sink *json = userdata;
+
+	if (json->bInStructure)
+	{
+		json_attribute(json, "Error");
+		json_append_formatted(json, &json->structures, format, args);
+	}
+	else
+	{
+		json_message(json, NULL, format, args);
+	}
+}
+
+static void json_release(struct br_output_sink *sink)
+{
+	struct json_sink *json = (struct json_sink *)sink;
+
+	free(json->messages.data);
+	free(json->structures.data);
+	free(json->scratch.data);
+	free(json);
+}
+
+struct br_output_sink *br_json_output_sink_create(FILE *stream)
+{
+	struct json_sink *json = calloc(1, sizeof(struct json_sink));
+
+	if (json == NULL)
+	{
+		return NULL;
+	}
+
+	json->sink.document_start = json_document_start;
+	json->sink.document_end = json_document_end;
+	json->sink.comment = json_info;
+	json->sink.info = json_info;
+	json->sink.handle = json_handle;
+	json->sink.handle_name = json_handle_name;
+	json->sink.attr = json_attr;
+	json->sink.subattr = json_attr;
+	json->sink.list_start = json_list_start;
+	json->sink.list_item = json_list_item;
+	json->sink.list_end = json_list_end;
+	json->sink.sep = json_sep;
+	json->sink.struct_err = json_struct_err;
+	json->sink.release = json_release;
+	json->sink.userdata = json;
+
+	json->stream = stream != NULL ? stream : stdout;
+
+	return &json->sink;
+}
+
+/*
+ **********************************************************
+ * Callback sink, everything formatted and handed over
+ *
+ **********************************************************
+ */
+
+struct callback_sink
+{
+	struct br_output_sink sink; // first, see callback_release()
+	br_output_callback callback;
+	void *userdata;
+	struct pr_buffer value;
+};
+
+static void callback_event(struct callback_sink *sink, enum br_output_event event, const char *name,
+	const char *format, va_list args)
+{
+	const char *value = NULL;
+
+	if (format != NULL)
+	{
+		sink->value.length = 0;
+		if (buffer_format(&sink->value, format, args) == 0)
+		{
+			value = sink->value.data;
+		}
+	}
+
+	sink->callback(event, name, value, NULL, sink->userdata);
+}
+
+static void callback_document_start(void *userdata)
+{
+	struct callback_sink *sink = userdata;
+
+	sink->callback(BR_OUTPUT_DOCUMENT_START, NULL, NULL, NULL, sink->userdata);
+}
+
+static void callback_document_end(void *userdata)
+{
+	struct callback_sink *sink = userdata;
+
+	sink->callback(BR_OUTPUT_DOCUMENT_END, NULL, NULL, NULL, sink->userdata);
+}
+
+static void callback_comment(void *userdata, const char *format, va_list args)
+{
+	callback_event(userdata, BR_OUTPUT_COMMENT, NULL, format, args);
+}
+
+static void callback_info(void *userdata, const char *format, va_list args)
+{
+	callback_event(userdata, BR_OUTPUT_INFO, NULL, format, args);
+}
+
+static void callback_handle(void *userdata, const struct dmi_header *h)
+{
+	struct callback_sink *sink = userdata;
+
+	sink->callback(BR_OUTPUT_HANDLE, NULL, NULL, h, sink->userdata);
+}
+
+static void callback_handle_name(void *userdata, const char *format, va_list args)
+{
+	callback_event(userdata, BR_OUTPUT_HANDLE_NAME, NULL, format, args);
+}
+
+static void callback_attr(void *userdata, const char *name, const char *format, va_list args)
+{
+	callback_event(userdata, BR_OUTPUT_ATTRIBUTE, name, format, args);
+}
+
+static void callback_subattr(void *userdata, const char *name, const char *format, va_list args)
+{
+	callback_event(userdata, BR_OUTPUT_SUBATTRIBUTE, name, format, args);
+}
+
+static void callback_list_start(void *userdata, const char *name, const char *format, va_list args)
+{
+	callback_event(userdata, BR_OUTPUT_LIST_START, name, format, args);
+}
+
+static void callback_list_item(void *userdata, const char *format, va_list args)
+{
+	callback_event(userdata, BR_OUTPUT_LIST_ITEM, NULL, format, args);
+}
+
+static void callback_list_end(void *userdata)
+{
+	struct callback_sink *sink = userdata;
+
+	sink->callback(BR_OUTPUT_LIST_END, NULL, NULL, NULL, sink->userdata);
+}
+
+static void callback_sep(void *userdata)
+{
+	struct callback_sink *sink = userdata;
+
+	sink->callback(BR_OUTPUT_SEPARATOR, NULL, NULL, NULL, sink->userdata);
+}
+
+static void callback_struct_err(void *userdata, const char *format, va_list args)
+{
+	callback_event(userdata, BR_OUTPUT_STRUCTURE_ERROR, NULL, format, args);
+}
+
+static void callback_release(struct br_output_sink *sink)
+{
+	struct callback_sink *callbackSink = (struct callback_sink *)sink;
+
+	free(callbackSink->value.data);
+	free(callbackSink);
+}
+
+struct br_output_sink *br_callback_output_sink_create(br_output_callback callback, void *userdata)
+{
+	struct callback_sink *sink = calloc(1, sizeof(struct callback_sink));
+
+	if (sink == NULL)
+	{
+		return NULL;
+	}
+
+	sink->sink.document_start = callback_document_start;
+	sink->sink.document_end = callback_document_end;
+	sink->sink.comment = callback_comment;
+	sink->sink.info = callback_info;
+	sink->sink.handle = callback_handle;
+	sink->sink.handle_name = callback_handle_name;
+	sink->sink.attr = callback_attr;
+	sink->sink.subattr = callback_subattr;
+	sink->sink.list_start = callback_list_start;
+	sink->sink.list_item = callback_list_item;
+	sink->sink.list_end = callback_list_end;
+	sink->sink.sep = callback_sep;
+	sink->sink.struct_err = callback_struct_err;
+	sink->sink.release = callback_release;
+	sink->sink.userdata = sink;
+
+	sink->callback = callback;
+	sink->userdata = userdata;
+
+	return &sink->sink;
 }
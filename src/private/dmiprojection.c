@@ -0,0 +1,176 @@
+/*
+ *   ----------------------------
+ *  |  dmiprojection.c
+ *   ----------------------------
+ *   This file is part of BiosReader.
+ *
+ *   BiosReader is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   BiosReader is distributed in the hope and belief that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with BiosReader.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+
+#include "dmiprojection.h"
+#include "dmifields.h"
+#include "brcontext.h"
+
+// The offsets are those dmi_decode() reads the fields at, see dmifields.h
+static const struct br_projection_field projectionKeywords[] = {
+	{ "bios-vendor", 0, DMI_BIOS_VENDOR, BR_FIELD_STRING },
+	{ "bios-version", 0, DMI_BIOS_VERSION, BR_FIELD_STRING },
+	{ "bios-release-date", 0, DMI_BIOS_RELEASE_DATE, BR_FIELD_STRING },
+	{ "system-manufacturer", 1, DMI_SYSTEM_MANUFACTURER, BR_FIELD_STRING },
+	{ "system-product-name", 1, DMI_SYSTEM_PRODUCT_NAME, BR_FIELD_STRING },
+	{ "system-version", 1, DMI_SYSTEM_VERSION, BR_FIELD_STRING },
+	{ "system-serial-number", 1, DMI_SYSTEM_SERIAL_NUMBER, BR_FIELD_STRING },
+	{ "system-sku-number", 1, DMI_SYSTEM_SKU_NUMBER, BR_FIELD_STRING },
+	{ "system-family", 1, DMI_SYSTEM_FAMILY, BR_FIELD_STRING },
+	{ "baseboard-manufacturer", 2, DMI_BASE_BOARD_MANUFACTURER, BR_FIELD_STRING },
+	{ "baseboard-product-name", 2, DMI_BASE_BOARD_PRODUCT_NAME, BR_FIELD_STRING },
+	{ "baseboard-version", 2, DMI_BASE_BOARD_VERSION, BR_FIELD_STRING },
+	{ "baseboard-serial-number", 2, DMI_BASE_BOARD_SERIAL_NUMBER, BR_FIELD_STRING },
+	{ "baseboard-asset-tag", 2, DMI_BASE_BOARD_ASSET_TAG, BR_FIELD_STRING },
+	{ "chassis-manufacturer", 3, DMI_CHASSIS_MANUFACTURER, BR_FIELD_STRING },
+	{ "chassis-type", 3, DMI_CHASSIS_TYPE, DMI_CHASSIS_TYPE_WIDTH, DMI_CHASSIS_TYPE_MASK },
+	{ "chassis-version", 3, DMI_CHASSIS_VERSION, BR_FIELD_STRING },
+	{ "chassis-serial-number", 3, DMI_CHASSIS_SERIAL_NUMBER, BR_FIELD_STRING },
+	{ "chassis-asset-tag", 3, DMI_CHASSIS_ASSET_TAG, BR_FIELD_STRING },
+	{ "processor-socket-designation", 4, DMI_PROCESSOR_SOCKET_DESIGNATION, BR_FIELD_STRING },
+	{ "processor-family", 4, DMI_PROCESSOR_FAMILY, DMI_PROCESSOR_FAMILY_WIDTH },
+	{ "processor-manufacturer", 4, DMI_PROCESSOR_MANUFACTURER, BR_FIELD_STRING },
+	{ "processor-version", 4, DMI_PROCESSOR_VERSION, BR_FIELD_STRING },
+	{ "processor-frequency", 4, DMI_PROCESSOR_CURRENT_SPEED, DMI_PROCESSOR_CURRENT_SPEED_WIDTH }, // MHz
+	{ "processor-serial-number", 4, DMI_PROCESSOR_SERIAL_NUMBER, BR_FIELD_STRING },
+	{ "processor-asset-tag", 4, DMI_PROCESSOR_ASSET_TAG, BR_FIELD_STRING },
+	{ "processor-part-number", 4, DMI_PROCESSOR_PART_NUMBER, BR_FIELD_STRING },
+	{ "processor-core-count", 4, DMI_PROCESSOR_CORE_COUNT, DMI_PROCESSOR_CORE_COUNT_WIDTH },
+	{ "processor-thread-count", 4, DMI_PROCESSOR_THREAD_COUNT, DMI_PROCESSOR_THREAD_COUNT_WIDTH },
+	{ "memory-device-size", 17, DMI_MEMORY_DEVICE_SIZE, DMI_MEMORY_DEVICE_SIZE_WIDTH }, // as encoded, see dmi_memory_device_size()
+	{ "memory-device-locator", 17, DMI_MEMORY_DEVICE_LOCATOR, BR_FIELD_STRING },
+	{ "memory-device-bank-locator", 17, DMI_MEMORY_DEVICE_BANK_LOCATOR, BR_FIELD_STRING },
+	{ "memory-device-speed", 17, DMI_MEMORY_DEVICE_SPEED, DMI_MEMORY_DEVICE_SPEED_WIDTH }, // MT/s
+	{ "memory-device-manufacturer", 17, DMI_MEMORY_DEVICE_MANUFACTURER, BR_FIELD_STRING },
+	{ "memory-device-serial-number", 17, DMI_MEMORY_DEVICE_SERIAL_NUMBER, BR_FIELD_STRING },
+	{ "memory-device-asset-tag", 17, DMI_MEMORY_DEVICE_ASSET_TAG, BR_FIELD_STRING },
+	{ "memory-device-part-number", 17, DMI_MEMORY_DEVICE_PART_NUMBER, BR_FIELD_STRING },
+	{ "memory-device-extended-size", 17, DMI_MEMORY_DEVICE_EXTENDED_SIZE, DMI_MEMORY_DEVICE_EXTENDED_SIZE_WIDTH, DMI_MEMORY_DEVICE_EXTENDED_SIZE_MASK }, // MB
+	{ "memory-device-configured-speed", 17, DMI_MEMORY_DEVICE_CONFIGURED_SPEED, DMI_MEMORY_DEVICE_CONFIGURED_SPEED_WIDTH }, // MT/s
+};
+
+const struct br_projection_field* br_projection_field_of(const char* keyword)
+{
+	for (size_t k = 0; k < ARRAY_SIZE(projectionKeywords); k++)
+	{
+		if (strcmp(projectionKeywords[k].keyword, keyword) == 0)
+		{
+			return &projectionKeywords[k];
+		}
+	}
+
+	return NULL;
+}
+
+const struct br_projection_field* br_projection_keywords(unsigned int* count)
+{
+	*count = ARRAY_SIZE(projectionKeywords);
+
+	return projectionKeywords;
+}
+
+/*
+ * One field out of one structure of the index, see br_projection_value
+ */
+static void project_field(const struct br_context* context, const struct dmi_structure_entry* entry,
+	const struct br_projection_field* field, struct br_projection_value* value)
+{
+	const u8* data = context->loadedTable.buf + entry->offset;
+	u32 length = entry->length;
+
+	// Only the last structure can run off the table (see dmi_index_build())
+	if (entry->offset + length > context->loadedTable.len)
+	{
+		length = context->loadedTable.len - entry->offset;
+	}
+
+	value->field = field;
+	value->handle = entry->handle;
+	value->bPresent = 0;
+	value->string = NULL;
+	value->number = 0;
+
+	if (field->width == BR_FIELD_STRING)
+	{
+		u8 s;
+
+		if (field->offset >= length || entry->firststring == DMI_NO_STRING_TABLE)
+		{
+			return;
+		}
+
+		s = data[field->offset];
+		if (s == 0 || s > entry->stringcount)
+		{
+			return;
+		}
+
+		value->string = (const char*)data + context->tableIndex.strings[entry->firststring + s - 1];
+		value->bPresent = 1;
+	}
+	else
+	{
+		if ((unsigned int)field->offset + field->width > length)
+		{
+			return;
+		}
+
+		// Little endian whatever the width, as the spec wants every field
+		for (unsigned int b = field->width; b > 0; b--)
+		{
+			value->number = value->number << 8 | data[field->offset + b - 1];
+		}
+
+		if (field->mask != 0)
+		{
+			value->number &= field->mask;
+		}
+
+		value->bPresent = 1;
+	}
+}
+
+unsigned int br_project(struct br_context* context, const struct br_projection_field* fields, unsigned int fieldCount,
+	struct br_projection_value* values, unsigned int capacity)
+{
+	unsigned int found = 0;
+
+	if (!br_context_table_at_hand(context))
+	{
+		return 0;
+	}
+
+	for (unsigned int f = 0; f < fieldCount; f++)
+	{
+		u32 count;
+		const u32* entries = dmi_index_of_type(&context->tableIndex, fields[f].type, &count);
+
+		for (u32 k = 0; k < count; k++, found++)
+		{
+			if (found < capacity)
+			{
+				project_field(context, &context->tableIndex.entries[entries[k]], &fields[f], &values[found]);
+			}
+		}
+	}
+
+	return found;
+}
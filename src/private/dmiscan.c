@@ -0,0 +1,227 @@
+/*
+ *   ----------------------------
+ *  |  dmiscan.c
+ *   ----------------------------
+ *   This file is part of BiosReader.
+ *
+ *   BiosReader is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   BiosReader is distributed in the hope and belief that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with BiosReader.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stddef.h>
+
+#if defined(BR_WINDOWS_PLATFORM)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#include "types.h"
+#include "dmiscan.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BR_SCAN_X86_GNU
+#include <immintrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_AMD64))
+#define BR_SCAN_X86_MSVC
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+// Scanning the string-set of the structure, pick one depending on the processor we land on
+typedef const u8* (*double_nul_scanner)(const u8* p, const u8* last);
+
+/*
+ * Portable, a byte at a time. Also finishes up whatever the vector kernels leave behind.
+ * Here (and below) last is limit - 1, the last position a pair can start at.
+ */
+static const u8* scan_double_nul_scalar(const u8* p, const u8* last)
+{
+	while (p < last && (p[0] != 0 || p[1] != 0))
+	{
+		p++;
+	}
+
+	return p;
+}
+
+#if defined(BR_SCAN_X86_GNU) || defined(BR_SCAN_X86_MSVC)
+
+// Index of the lowest set bit of a non zero mask
+static unsigned int lowest_set_bit(unsigned int mask)
+{
+#if defined(BR_SCAN_X86_GNU)
+	return (unsigned int)__builtin_ctz(mask);
+#else
+	unsigned long index;
+
+	_BitScanForward(&index, mask);
+	return (unsigned int)index;
+#endif
+}
+
+/*
+ * 16 pairs at a time. Compare the bytes at p and at p + 1 against zero, the pairs
+ * which are both zero show up in the AND of the two masks.
+ */
+#if defined(BR_SCAN_X86_GNU)
+__attribute__((target("sse2")))
+#endif
+static const u8* scan_double_nul_sse2(const u8* p, const u8* last)
+{
+	const __m128i zero = _mm_setzero_si128();
+
+	// Both loads, the second one being a byte ahead, need to stay within [p, limit)
+	while (last - p >= 16)
+	{
+		__m128i here = _mm_loadu_si128((const __m128i*)p);
+		__m128i ahead = _mm_loadu_si128((const __m128i*)(p + 1));
+		unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(here, zero), _mm_cmpeq_epi8(ahead, zero)));
+
+		if (mask != 0)
+		{
+			return p + lowest_set_bit(mask);
+		}
+		p += 16;
+	}
+
+	return scan_double_nul_scalar(p, last);
+}
+
+// 32 pairs at a time, same trick as above
+#if defined(BR_SCAN_X86_GNU)
+__attribute__((target("avx2")))
+#endif
+static const u8* scan_double_nul_avx2(const u8* p, const u8* last)
+{
+	const __m256i zero = _mm256_setzero_si256();
+
+	while (last - p >= 32)
+	{
+		__m256i here = _mm256_loadu_si256((const __m256i*)p);
+		__m256i ahead = _mm256_loadu_si256((const __m256i*)(p + 1));
+		unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(here, zero), _mm256_cmpeq_epi8(ahead, zero)));
+
+		if (mask != 0)
+		{
+			return p + lowest_set_bit(mask);
+		}
+		p += 32;
+	}
+
+	return scan_double_nul_sse2(p, last);
+}
+
+static int processor_supports_avx2()
+{
+#if defined(BR_SCAN_X86_GNU)
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2");
+#else
+	int registers[4];
+
+	__cpuid(registers, 0);
+	if (registers[0] < 7)
+	{
+		return 0;
+	}
+
+	// OS saves the YMM state (OSXSAVE and AVX, then XCR0)
+	__cpuid(registers, 1);
+	if ((registers[2] & (1 << 27)) == 0 || (registers[2] & (1 << 28)) == 0 || (_xgetbv(0) & 6) != 6)
+	{
+		return 0;
+	}
+
+	__cpuidex(registers, 7, 0);
+	return (registers[1] & (1 << 5)) != 0;
+#endif
+}
+
+static int processor_supports_sse2()
+{
+#if defined(BR_SCAN_X86_GNU)
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("sse2");
+#else
+	// Part of x86-64 itself
+	return 1;
+#endif
+}
+
+#endif // x86
+
+static double_nul_scanner pick_double_nul_scanner()
+{
+#if defined(BR_SCAN_X86_GNU) || defined(BR_SCAN_X86_MSVC)
+	if (processor_supports_avx2())
+	{
+		return scan_double_nul_avx2;
+	}
+
+	if (processor_supports_sse2())
+	{
+		return scan_double_nul_sse2;
+	}
+#endif
+
+	return scan_double_nul_scalar;
+}
+
+// Picked once per process, by whichever thread scans first
+static double_nul_scanner scanner = NULL;
+
+#if defined(BR_WINDOWS_PLATFORM)
+static INIT_ONCE scannerOnce = INIT_ONCE_STATIC_INIT;
+
+static BOOL CALLBACK pick_scanner_once(PINIT_ONCE once, PVOID parameter, PVOID* context)
+{
+	scanner = pick_double_nul_scanner();
+	return TRUE;
+}
+#else
+static pthread_once_t scannerOnce = PTHREAD_ONCE_INIT;
+
+static void pick_scanner_once(void)
+{
+	scanner = pick_double_nul_scanner();
+}
+#endif
+
+/*
+ *************************************************************************************************
+ *
+ * Find the end of the string-set of an SMBIOS structure, that is where the next structure begins
+ * https://github.com/ravimohan1991/BiosReader/wiki/Demystifying-the-RAW-BIOS-information
+ * @param p             Where to start looking, usually right after the formatted area
+ * @param limit         One past the end of the table
+ * @return const u8*    The first NUL of the pair, or limit - 1 if there is no pair
+ *
+ *************************************************************************************************
+ */
+
+const u8* dmi_find_double_nul(const u8* p, const u8* limit)
+{
+	if (p + 1 >= limit)
+	{
+		return p;
+	}
+
+#if defined(BR_WINDOWS_PLATFORM)
+	InitOnceExecuteOnce(&scannerOnce, pick_scanner_once, NULL, NULL);
+#else
+	pthread_once(&scannerOnce, pick_scanner_once);
+#endif
+
+	return scanner(p, limit - 1);
+}
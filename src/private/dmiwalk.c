@@ -0,0 +1,155 @@
+/*
+ *   ----------------------------
+ *  |  dmiwalk.c
+ *   ----------------------------
+ *   This file is part of BiosReader.
+ *
+ *   BiosReader is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   BiosReader is distributed in the hope and belief that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with BiosReader.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "dmiwalk.h"
+#include "brcontext.h"
+
+int br_cursor_begin(struct br_context* context, struct br_cursor* cursor)
+{
+	cursor->context = context;
+	cursor->next = 0;
+
+	if (!br_context_table_at_hand(context))
+	{
+		cursor->next = context->tableIndex.count;
+		return 0;
+	}
+
+	return 1;
+}
+
+int br_cursor_next(struct br_cursor* cursor, struct dmi_header* h)
+{
+	struct br_context* context = cursor->context;
+	u32 end;
+
+	if (cursor->next >= context->tableIndex.count || context->loadedTable.buf == NULL)
+	{
+		return 0;
+	}
+
+	br_context_header_of(context, cursor->next, h);
+
+	// Stop at end-of-table marker, as the decoding passes do
+	if (h->type == 127)
+	{
+		cursor->next = context->tableIndex.count;
+		return 0;
+	}
+
+	// Only the last structure can run off the table (see dmi_index_build())
+	end = context->tableIndex.entries[cursor->next].offset + h->length;
+	if (end > context->loadedTable.len)
+	{
+		h->length = (u8)(h->length - (end - context->loadedTable.len));
+	}
+
+	cursor->next++;
+
+	return 1;
+}
+
+unsigned int br_walk(struct br_context* context, const struct br_type_mask* mask, br_walk_function walk, void* userdata)
+{
+	struct br_cursor cursor;
+	struct dmi_header h;
+	unsigned int walked = 0;
+
+	br_cursor_begin(context, &cursor);
+
+	while (br_cursor_next(&cursor, &h))
+	{
+		if (!br_type_mask_has(mask, h.type))
+		{
+			continue;
+		}
+
+		walked++;
+
+		if (walk(&h, userdata) != 0)
+		{
+			break;
+		}
+	}
+
+	return walked;
+}
+
+const char* br_walk_string(const struct dmi_header* h, u8 offset)
+{
+	return br_walk_string_span(h, offset, NULL);
+}
+
+const char* br_walk_string_span(const struct dmi_header* h, u8 offset, size_t* length)
+{
+	u8 s;
+
+	if (length != NULL)
+	{
+		*length = 0;
+	}
+
+	if (offset >= h->length || h->strings == NULL)
+	{
+		return NULL;
+	}
+
+	s = h->data[offset];
+	if (s == 0 || s > h->stringcount)
+	{
+		return NULL;
+	}
+
+	// Each string runs up to its NUL, right before the next one starts
+	if (length != NULL)
+	{
+		*length = h->strings[s] - h->strings[s - 1] - 1;
+	}
+
+	return (const char*)h->data + h->strings[s - 1];
+}
+
+unsigned long long br_walk_number(const struct dmi_header* h, u8 offset, u8 width, int* bPresent)
+{
+	unsigned long long number = 0;
+
+	if ((unsigned int)offset + width > h->length)
+	{
+		if (bPresent != NULL)
+		{
+			*bPresent = 0;
+		}
+
+		return 0;
+	}
+
+	// Little endian whatever the width, as the spec wants every field
+	for (unsigned int b = width; b > 0; b--)
+	{
+		number = number << 8 | h->data[offset + b - 1];
+	}
+
+	if (bPresent != NULL)
+	{
+		*bPresent = 1;
+	}
+
+	return number;
+}
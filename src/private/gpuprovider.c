@@ -0,0 +1,394 @@
+/*
+ *   ----------------------------
+ *  |  gpuprovider.c
+ *   ----------------------------
+ *   This file is part of BiosReader.
+ *
+ *   BiosReader is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   BiosReader is distributed in the hope and belief that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with BiosReader.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined(BR_WINDOWS_PLATFORM)
+// dladdr()
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(BR_WINDOWS_PLATFORM)
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#include <pthread.h>
+#endif
+
+#if defined(BR_LINUX_PLATFORM)
+#include <dirent.h>
+#endif
+
+#include "gpuprovider.h"
+#include "gpumodule.h"
+
+// Where the kernel lists the display adapters (DRM cards)
+#define SYS_DRM_DIR "/sys/class/drm"
+
+/*
+ * Vendors one is likely to meet, the rest get their ID printed
+ * https://pci-ids.ucw.cz/read/PC
+ */
+const char* gpu_provider_vendor_name(unsigned int vendorid)
+{
+	switch (vendorid)
+	{
+	case 0x1002:
+		return "Advanced Micro Devices, Inc. [AMD/ATI]";
+	case 0x10DE:
+		return "NVIDIA Corporation";
+	case 0x8086:
+		return "Intel Corporation";
+	case 0x1A03:
+		return "ASPEED Technology, Inc.";
+	case 0x102B:
+		return "Matrox Electronics Systems Ltd.";
+	case 0x15AD:
+		return "VMware";
+	case 0x1AF4:
+		return "Red Hat, Inc.";
+	case 0x1234:
+		return "QEMU";
+	case 0x1414:
+		return "Microsoft Corporation";
+	case 0x5143:
+		return "Qualcomm";
+	default:
+		return NULL;
+	}
+}
+
+#if defined(BR_LINUX_PLATFORM)
+
+/*
+ * Reads a (small) sysfs attribute as a NUL terminated line. Returns 0 on success.
+ */
+static int read_sysfs_attribute(const char* path, char* buffer, size_t size)
+{
+	FILE* file = fopen(path, "r");
+	size_t length;
+
+	if (file == NULL)
+	{
+		return -1;
+	}
+
+	length = fread(buffer, 1, size - 1, file);
+	fclose(file);
+
+	buffer[length] = '\0';
+
+	// Lose the trailing newline
+	while (length > 0 && (buffer[length - 1] == '\n' || buffer[length - 1] == ' '))
+	{
+		buffer[--length] = '\0';
+	}
+
+	return 0;
+}
+
+/*
+ * The device's uevent has it all in KEY=value lines:
+ * DRIVER=amdgpu, PCI_ID=1002:73BF, PCI_SLOT_NAME=0000:03:00.0 ...
+ */
+static int read_device_uevent(const char* cardDirectory, struct gpu_provider_device* device)
+{
+	char path[512];
+	char uevent[1024];
+	char* line;
+	char* context = NULL;
+	int bHasPciId = 0;
+
+	snprintf(path, sizeof(path), "%s/device/uevent", cardDirectory);
+	if (read_sysfs_attribute(path, uevent, sizeof(uevent)) != 0)
+	{
+		return -1;
+	}
+
+	for (line = strtok_r(uevent, "\n", &context); line != NULL; line = strtok_r(NULL, "\n", &context))
+	{
+		if (strncmp(line, "DRIVER=", 7) == 0)
+		{
+			snprintf(device->driver, sizeof(device->driver), "%s", line + 7);
+		}
+		else if (strncmp(line, "PCI_ID=", 7) == 0)
+		{
+			bHasPciId = sscanf(line + 7, "%x:%x", &device->vendorid, &device->deviceid) == 2;
+		}
+		else if (strncmp(line, "PCI_SLOT_NAME=", 14) == 0)
+		{
+			snprintf(device->slot, sizeof(device->slot), "%s", line + 14);
+		}
+	}
+
+	return bHasPciId ? 0 : -1;
+}
+
+/*
+ * Dedicated video memory, in bytes. Only some drivers tell (amdgpu does, as does
+ * the xe driver for discrete Intel), the rest leave it at 0.
+ */
+static unsigned long long read_video_memory_size(const char* cardDirectory)
+{
+	static const char* attributes[] = {
+		"device/mem_info_vram_total", // amdgpu
+		"device/lmem_total_bytes", // xe, i915 discrete
+	};
+	char path[512];
+	char value[64];
+
+	for (size_t i = 0; i < sizeof(attributes) / sizeof(attributes[0]); i++)
+	{
+		snprintf(path, sizeof(path), "%s/%s", cardDirectory, attributes[i]);
+		if (read_sysfs_attribute(path, value, sizeof(value)) == 0)
+		{
+			return strtoull(value, NULL, 0);
+		}
+	}
+
+	return 0;
+}
+
+static int compare_card_numbers(const void* a, const void* b)
+{
+	int first = *(const int*)a;
+	int second = *(const int*)b;
+
+	return (first > second) - (first < second);
+}
+
+#endif // BR_LINUX_PLATFORM
+
+/*
+ *************************************************************************************************
+ *
+ * Lists the display adapters from sysfs, /sys/class/drm/card<N>, in card order. Connectors
+ * (card0-HDMI-A-1 and the like) and render nodes are skipped.
+ *
+ * @param devices       Where to put them
+ * @param maxDevices    Room in devices
+ * @return int          Number of adapters found (and put), 0 when there are none or
+ *                      the platform has no such thing as sysfs
+ *
+ *************************************************************************************************
+ */
+
+int gpu_provider_enumerate(struct gpu_provider_device* devices, int maxDevices)
+{
+	int found = 0;
+
+#if defined(BR_LINUX_PLATFORM)
+	DIR* drmDirectory;
+	struct dirent* entry;
+	int cards[BR_MAX_GPUS];
+	int cardCount = 0;
+
+	drmDirectory = opendir(SYS_DRM_DIR);
+	if (drmDirectory == NULL)
+	{
+		return 0;
+	}
+
+	while ((entry = readdir(drmDirectory)) != NULL && cardCount < BR_MAX_GPUS)
+	{
+		char* end;
+		long number;
+
+		if (strncmp(entry->d_name, "card", 4) != 0)
+		{
+			continue;
+		}
+
+		number = strtol(entry->d_name + 4, &end, 10);
+		if (end == entry->d_name + 4 || *end != '\0' || number < 0)
+		{
+			continue;
+		}
+
+		cards[cardCount++] = (int)number;
+	}
+	closedir(drmDirectory);
+
+	qsort(cards, cardCount, sizeof(int), compare_card_numbers);
+
+	for (int i = 0; i < cardCount && found < maxDevices; i++)
+	{
+		char cardDirectory[256];
+		struct gpu_provider_device* device = &devices[found];
+
+		snprintf(cardDirectory, sizeof(cardDirectory), "%s/card%d", SYS_DRM_DIR, cards[i]);
+
+		memset(device, 0, sizeof(*device));
+		if (read_device_uevent(cardDirectory, device) != 0)
+		{
+			// Not a PCI device (virtual or platform display), nothing to report
+			continue;
+		}
+
+		device->vrambytes = read_video_memory_size(cardDirectory);
+		found++;
+	}
+#endif // BR_LINUX_PLATFORM
+
+	return found;
+}
+
+// What the module hands out, looked for once per process whichever context (or thread) asks first
+static gpu_module_probe_function moduleProbe = NULL;
+
+/*
+ * The module next to the binary BiosReader lives in (the library, or the executable it is linked into
+ * statically), which is where the build and an install put it. Returns -1 if that can't be told
+ */
+static int gpu_module_path(char* path, size_t size)
+{
+	size_t directoryLength;
+	const char* separator;
+
+#if defined(BR_WINDOWS_PLATFORM)
+	HMODULE self;
+	DWORD length;
+
+	if (!GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+		(LPCSTR)&gpu_module_path, &self))
+	{
+		return -1;
+	}
+
+	length = GetModuleFileNameA(self, path, (DWORD)size);
+	if (length == 0 || length >= size)
+	{
+		return -1;
+	}
+
+	separator = strrchr(path, '\\');
+#else
+	Dl_info information;
+
+	if (dladdr((void*)&gpu_module_path, &information) == 0 || information.dli_fname == NULL
+		|| strlen(information.dli_fname) >= size)
+	{
+		return -1;
+	}
+
+	strcpy(path, information.dli_fname);
+	separator = strrchr(path, '/');
+#endif
+
+	if (separator == NULL)
+	{
+		return -1;
+	}
+
+	directoryLength = (size_t)(separator - path) + 1;
+	if (directoryLength + sizeof(BR_GPU_MODULE_NAME) > size)
+	{
+		return -1;
+	}
+
+	memcpy(path + directoryLength, BR_GPU_MODULE_NAME, sizeof(BR_GPU_MODULE_NAME));
+
+	return 0;
+}
+
+#if defined(BR_WINDOWS_PLATFORM)
+static INIT_ONCE moduleOnce = INIT_ONCE_STATIC_INIT;
+
+static BOOL CALLBACK load_gpu_module(PINIT_ONCE once, PVOID parameter, PVOID* context)
+{
+	char path[MAX_PATH];
+	HMODULE module = NULL;
+
+	// Beside BiosReader first, then wherever the loader looks
+	if (gpu_module_path(path, sizeof(path)) == 0)
+	{
+		module = LoadLibraryA(path);
+	}
+
+	if (module == NULL)
+	{
+		module = LoadLibraryA(BR_GPU_MODULE_NAME);
+	}
+
+	if (module != NULL)
+	{
+		moduleProbe = (gpu_module_probe_function)GetProcAddress(module, BR_GPU_MODULE_ENTRY);
+	}
+
+	return TRUE;
+}
+#else
+static pthread_once_t moduleOnce = PTHREAD_ONCE_INIT;
+
+static void load_gpu_module(void)
+{
+	char path[4096];
+	void* module = NULL;
+
+	// Beside BiosReader first, then wherever the loader looks
+	if (gpu_module_path(path, sizeof(path)) == 0)
+	{
+		module = dlopen(path, RTLD_LAZY | RTLD_LOCAL);
+	}
+
+	if (module == NULL)
+	{
+		module = dlopen(BR_GPU_MODULE_NAME, RTLD_LAZY | RTLD_LOCAL);
+	}
+
+	if (module != NULL)
+	{
+		moduleProbe = (gpu_module_probe_function)dlsym(module, BR_GPU_MODULE_ENTRY);
+	}
+}
+#endif
+
+/*
+ *************************************************************************************************
+ *
+ * Asks the optional GL module about the graphics processing unit behind the current GL
+ * context. The module is loaded the first time round and kept, a missing module is
+ * simply a "don't know".
+ *
+ * @param device        Filled up on success
+ * @return int          0 on success, -1 when there is no module or it couldn't tell
+ *
+ *************************************************************************************************
+ */
+
+int gpu_provider_probe_module(struct gpu_module_device* device)
+{
+#if defined(BR_WINDOWS_PLATFORM)
+	InitOnceExecuteOnce(&moduleOnce, load_gpu_module, NULL, NULL);
+#else
+	pthread_once(&moduleOnce, load_gpu_module);
+#endif
+
+	if (moduleProbe == NULL)
+	{
+		return -1;
+	}
+
+	memset(device, 0, sizeof(*device));
+
+	return moduleProbe(device) == 0 ? 0 : -1;
+}
@@ -0,0 +1,187 @@
+/*
+ *   ----------------------------
+ *  |  intern.h
+ *   ----------------------------
+ *   This file is part of BiosReader.
+ *
+ *   BiosReader is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   BiosReader is distributed in the hope and belief that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with BiosReader.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "intern.h"
+
+// FNV-1a, folded down to bits the Fibonacci way
+static u32 br_intern_hash(const char* string, u32 bits)
+{
+	u32 hash = 2166136261u;
+
+	while (*string != '\0')
+	{
+		hash ^= (u8)*string++;
+		hash *= 16777619u;
+	}
+
+	return (u32)(hash * 2654435769u) >> (32 - bits);
+}
+
+/*
+ * Slot of the string, or of the empty slot where it would go. The table must have been set up.
+ */
+static u32 br_intern_find(const struct br_intern_pool* pool, const char* string)
+{
+	u32 mask = (1u << pool->slotbits) - 1;
+	u32 slot = br_intern_hash(string, pool->slotbits);
+
+	while (pool->slots[slot] != 0)
+	{
+		const char* interned = pool->strings[pool->slots[slot] - 1];
+
+		if (interned == string || strcmp(interned, string) == 0)
+		{
+			break;
+		}
+
+		slot = (slot + 1) & mask;
+	}
+
+	return slot;
+}
+
+/*
+ * Room for one more string: the table doubled (and everybody rehashed) once it would be more
+ * than half full
+ */
+static int br_intern_grow(struct br_intern_pool* pool)
+{
+	if (pool->count == pool->capacity)
+	{
+		u32 capacity = pool->capacity ? pool->capacity * 2 : 64;
+		const char** strings = realloc(pool->strings, capacity * sizeof(const char*));
+
+		if (strings == NULL)
+		{
+			perror("realloc");
+			return -1;
+		}
+
+		pool->strings = strings;
+		pool->capacity = capacity;
+	}
+
+	if (pool->slots == NULL || (pool->count + 1) * 2 > (1u << pool->slotbits))
+	{
+		u32 bits = pool->slots ? pool->slotbits + 1 : 7;
+		u32* slots = calloc((size_t)1 << bits, sizeof(u32));
+
+		if (slots == NULL)
+		{
+			perror("calloc");
+			return -1;
+		}
+
+		free(pool->slots);
+		pool->slots = slots;
+		pool->slotbits = bits;
+
+		for (u32 id = 1; id <= pool->count; id++)
+		{
+			pool->slots[br_intern_find(pool, pool->strings[id - 1])] = id;
+		}
+	}
+
+	return 0;
+}
+
+/*
+ *************************************************************************************************
+ *
+ * The one copy of the string, made on first sight
+ *
+ * @param pool          The pool. Zero initialize before first use
+ * @param arena         Where the copy goes. NULL to keep the string itself, which must then
+ *                      live as long as what is in the pool
+ * @param string        The string
+ * @return const char*  The interned string, NULL if the heap says no
+ *
+ *************************************************************************************************
+ */
+
+const char* br_intern(struct br_intern_pool* pool, struct br_arena* arena, const char* string)
+{
+	const char* interned;
+	u32 slot;
+
+	if (br_intern_grow(pool) != 0)
+	{
+		return NULL;
+	}
+
+	slot = br_intern_find(pool, string);
+	if (pool->slots[slot] != 0)
+	{
+		return pool->strings[pool->slots[slot] - 1];
+	}
+
+	interned = arena != NULL ? br_arena_strdup(arena, string) : string;
+	if (interned == NULL)
+	{
+		return NULL;
+	}
+
+	pool->strings[pool->count++] = interned;
+	pool->slots[slot] = pool->count;
+
+	return interned;
+}
+
+/*
+ * Id of the string (interned or equal to one that is), 0 if the pool has never seen it
+ */
+u32 br_intern_id(const struct br_intern_pool* pool, const char* string)
+{
+	if (pool->count == 0 || string == NULL)
+	{
+		return 0;
+	}
+
+	return pool->slots[br_intern_find(pool, string)];
+}
+
+const char* br_intern_string(const struct br_intern_pool* pool, u32 id)
+{
+	return id != 0 && id <= pool->count ? pool->strings[id - 1] : NULL;
+}
+
+/*
+ * Forget every string (the arena they live in is being reset), keeping the tables for reuse
+ */
+void br_intern_clear(struct br_intern_pool* pool)
+{
+	if (pool->slots != NULL)
+	{
+		memset(pool->slots, 0, ((size_t)1 << pool->slotbits) * sizeof(u32));
+	}
+
+	pool->count = 0;
+}
+
+void br_intern_release(struct br_intern_pool* pool)
+{
+	free(pool->strings);
+	free(pool->slots);
+	memset(pool, 0, sizeof(*pool));
+}
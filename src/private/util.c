@@ -140,60 +140,51 @@ int checksum(const u8* buffer, size_t length)
 	return (sum == 0);
 }
 
-/*************************************************************************************
- *
- * Reads all of file from given offset, up to max_len bytes.
- * A buffer of at most max_len bytes is allocated by this function, and
- * needs to be freed by the caller.
- * This provides a similar usage model to mem_chunk()
- *
- * Returns a pointer to the allocated buffer, or NULL on error, and
- * sets max_len to the length actually read.
- *
- *************************************************************************************
- */
-
 #ifdef BR_LINUX_PLATFORM
 int getresuid(__uid_t* __ruid, __uid_t* __euid, __uid_t* __suid);
 int getresgid(__gid_t* __rgid, __gid_t* __egid, __gid_t* __sgid);
 int setresuid(__uid_t __ruid, __uid_t __euid, __uid_t __suid);
 int setresgid(__gid_t __rgid, __gid_t __egid, __gid_t __sgid);
-#endif // BR_LINUX_PLATFORM
 
-void* read_file(off_t base, size_t* max_len, const char* filename, int* file_access)
+/*
+ * The identity we were started with, remembered so that the short term
+ * privilege bump around a restricted file read can be undone.
+ */
+struct privilege_identity
 {
-	struct stat statbuf;
-	int fd;
-	u8* p;
-
-#ifdef BR_LINUX_PLATFORM
 	uid_t ruid, euid, suid; /* Real, Effective, Saved user ID */
 	gid_t rgid, egid, sgid; /* Real, Effective, Saved group ID */
-	int uerr, gerr;
+};
 
-	if (getresuid(&ruid, &euid, &suid) == -1)
+/*
+ * Switch to the target user and group for reading the restricted file.
+ * Returns 0 on success, -1 (with file_access filled) elsewise.
+ */
+static int raise_privileges(struct privilege_identity* identity, int* file_access)
+{
+	if (getresuid(&identity->ruid, &identity->euid, &identity->suid) == -1)
 	{
 		fprintf(stderr, "Cannot obtain user identity: %m.\n");
 		*file_access = 35;
-		return NULL;
+		return -1;
 	}
-	if (getresgid(&rgid, &egid, &sgid) == -1)
+	if (getresgid(&identity->rgid, &identity->egid, &identity->sgid) == -1)
 	{
 		fprintf(stderr, "Cannot obtain group identity: %m.\n");
 		*file_access = 36;
-		return NULL;
+		return -1;
 	}
-	if (ruid != (uid_t)TARGET_UID && ruid < (uid_t)UID_MIN)
+	if (identity->ruid != (uid_t)TARGET_UID && identity->ruid < (uid_t)UID_MIN)
 	{
 		fprintf(stderr, "Invalid user.\n");
 		*file_access = 37;
-		return NULL;
+		return -1;
 	}
-	if (rgid != (gid_t)TARGET_UID && rgid < (gid_t)GID_MIN)
+	if (identity->rgid != (gid_t)TARGET_UID && identity->rgid < (gid_t)GID_MIN)
 	{
 		fprintf(stderr, "Invalid group.\n");
 		*file_access = 38;
-		return NULL;
+		return -1;
 	}
 
 	/* Switch to target user. setuid bit handles this, but doing it again does no harm. */
@@ -201,7 +192,7 @@ void* read_file(off_t base, size_t* max_len, const char* filename, int* file_acc
 	{
 		fprintf(stderr, "Insufficient user privileges.\n");
 		*file_access = 39;
-		return NULL;
+		return -1;
 	}
 
 	/* Switch to target group. setgid bit handles this, but doing it again does no harm.
@@ -210,14 +201,71 @@ void* read_file(off_t base, size_t* max_len, const char* filename, int* file_acc
 	{
 		fprintf(stderr, "Insufficient group privileges.\n");
 		*file_access = 40;
-		return NULL;
+		return -1;
 	}
 
-	/* ... privileged operations ... */
-#endif// BR_LINUX_PLATFORM
-	/*
-	 * Open the restricted file.
-	 */
+	return 0;
+}
+
+/*
+ * Drop the privileges obtained by raise_privileges() for good.
+ * Returns 0 on success, -1 elsewise.
+ */
+static int drop_privileges(const struct privilege_identity* identity)
+{
+	int uerr, gerr;
+
+	gerr = 0;
+	if (setresgid(identity->rgid, identity->rgid, identity->rgid) == -1)
+	{
+		gerr = errno;
+		if (!gerr)
+			gerr = EINVAL;
+	}
+	uerr = 0;
+	if (setresuid(identity->ruid, identity->ruid, identity->ruid) == -1)
+	{
+		uerr = errno;
+		if (!uerr)
+		{
+			uerr = EINVAL;
+		}
+	}
+	if (uerr || gerr)
+	{
+		if (uerr)
+		{
+			fprintf(stderr, "Cannot drop user privileges: %s.\n", strerror(uerr));
+		}
+		if (gerr)
+		{
+			fprintf(stderr, "Cannot drop group privileges: %s.\n", strerror(gerr));
+		}
+
+		return -1;
+	}
+
+	return 0;
+}
+#endif // BR_LINUX_PLATFORM
+
+/*************************************************************************************
+ *
+ * Reads all of file from given offset, up to max_len bytes, into buffer. If buffer
+ * is NULL, one of at most max_len bytes is allocated here and the caller owns it.
+ * Whatever privileges are needed for the file, the caller holds them already.
+ *
+ * Returns a pointer to the filled buffer, or NULL on error, and
+ * sets max_len to the length actually read.
+ *
+ *************************************************************************************
+ */
+
+static void* read_file_as_is(off_t base, size_t* max_len, const char* filename, u8* buffer, int* file_access)
+{
+	struct stat statbuf;
+	int fd;
+	u8* p;
 
 	 /*
 	  * Don't print error message on missing file, as we will try to read
@@ -249,7 +297,11 @@ void* read_file(off_t base, size_t* max_len, const char* filename, int* file_acc
 			*max_len = statbuf.st_size - base;
 	}
 
-	if ((p = malloc(*max_len)) == NULL)
+	if (buffer != NULL)
+	{
+		p = buffer;
+	}
+	else if ((p = malloc(*max_len)) == NULL)
 	{
 		perror("malloc");
 		goto out;
@@ -265,84 +317,222 @@ void* read_file(off_t base, size_t* max_len, const char* filename, int* file_acc
 	if (myread(fd, p, *max_len, filename) == 0)
 		goto out;
 
-#ifdef BR_LINUX_PLATFORM
-	/* Drop privileges. */
-	gerr = 0;
-	if (setresgid(rgid, rgid, rgid) == -1)
+err_free:
+	if (p != buffer)
 	{
-		gerr = errno;
-		if (!gerr)
-			gerr = EINVAL;
+		free(p);
 	}
-	uerr = 0;
-	if (setresuid(ruid, ruid, ruid) == -1)
+	p = NULL;
+
+out:
+	if (close(fd) == -1)
 	{
-		uerr = errno;
-		if (!uerr)
-		{
-			uerr = EINVAL;
-		}
+		perror(filename);
 	}
-	if (uerr || gerr)
+
+	return p;
+}
+
+/*************************************************************************************
+ *
+ * Common worker of read_file() and read_file_into(): read_file_as_is() with the
+ * privileges of TARGET_UID, for the restricted files (sysfs, /dev/mem).
+ *
+ *************************************************************************************
+ */
+
+static void* read_file_common(off_t base, size_t* max_len, const char* filename, u8* buffer, int* file_access)
+{
+	u8* p;
+
+#ifdef BR_LINUX_PLATFORM
+	struct privilege_identity identity;
+
+	if (raise_privileges(&identity, file_access) == -1)
 	{
-		if (uerr)
-		{
-			fprintf(stderr, "Cannot drop user privileges: %s.\n", strerror(uerr));
-		}
-		if (gerr)
+		return NULL;
+	}
+#endif// BR_LINUX_PLATFORM
+
+	p = read_file_as_is(base, max_len, filename, buffer, file_access);
+
+#ifdef BR_LINUX_PLATFORM
+	/* Drop privileges. */
+	if (drop_privileges(&identity) == -1)
+	{
+		if (p != NULL && p != buffer)
 		{
-			fprintf(stderr, "Cannot drop group privileges: %s.\n", strerror(gerr));
+			free(p);
 		}
 
 		return NULL;
 	}
-
-	/* ... unprivileged operations ... */
 #endif// BR_LINUX_PLATFORM
+	return p;
+}
 
-err_free:
-	free(p);
-	p = NULL;
+/*************************************************************************************
+ *
+ * Reads all of file from given offset, up to max_len bytes.
+ * A buffer of at most max_len bytes is allocated by this function, and
+ * needs to be freed by the caller.
+ * This provides a similar usage model to mem_chunk()
+ *
+ * Returns a pointer to the allocated buffer, or NULL on error, and
+ * sets max_len to the length actually read.
+ *
+ *************************************************************************************
+ */
 
-out:
+void* read_file(off_t base, size_t* max_len, const char* filename, int* file_access)
+{
+	return read_file_common(base, max_len, filename, NULL, file_access);
+}
+
+/*************************************************************************************
+ *
+ * Same as read_file() but reads into the caller supplied buffer, which must be able
+ * to hold max_len bytes, instead of allocating one. Nothing to be freed afterwards.
+ *
+ * Returns buffer, or NULL on error, and sets max_len to the length actually read.
+ *
+ *************************************************************************************
+ */
+
+void* read_file_into(off_t base, size_t* max_len, const char* filename, u8* buffer, int* file_access)
+{
+	return read_file_common(base, max_len, filename, buffer, file_access);
+}
+
+/*************************************************************************************
+ *
+ * Same as read_file_into() (read_file() when buffer is NULL) for the files of the
+ * user, dumps and the like: no privilege is raised or dropped, so that it is safe
+ * for any number of threads, and for an unprivileged user, to read them at once.
+ *
+ *************************************************************************************
+ */
+
+void* read_user_file(off_t base, size_t* max_len, const char* filename, u8* buffer, int* file_access)
+{
+	return read_file_as_is(base, max_len, filename, buffer, file_access);
+}
+
+/*************************************************************************************
+ *
+ * Maps a file from given offset, up to max_len bytes, so that it can be parsed in
+ * place without copying it into a heap buffer first.
+ *
+ * The mapping is private and copy-on-write: the file stays untouched, but the few
+ * bytes we patch while decoding (ascii filtering of strings, for instance) only
+ * dirty the page they live on.
+ * Files which can't be mapped (sysfs attributes without mmap support, pipes and
+ * whatnot) make this function fail quietly, so that the caller may fall back to
+ * read_file() or read_file_into().
+ *
+ * Returns a pointer to the data, or NULL on error, and sets max_len to the length
+ * actually mapped. Release with unmap_file().
+ *
+ *************************************************************************************
+ */
+
+u8* map_file(off_t base, size_t* max_len, const char* filename, struct file_mapping* mapping)
+{
+	mapping->base = NULL;
+	mapping->length = 0;
+
+#if defined (BR_LINUX_PLATFORM) || defined (BR_MAC_PLATFORM)
+	u8* data;
+	int fd;
+
+	if ((fd = open(filename, O_RDONLY)) == -1)
+	{
+		return NULL;
+	}
+
+	data = map_descriptor(fd, base, max_len, mapping);
+
+	// The mapping outlives the descriptor
 	if (close(fd) == -1)
 	{
 		perror(filename);
 	}
 
-#ifdef BR_LINUX_PLATFORM
-	/* Drop privileges. */
-	gerr = 0;
-	if (setresgid(rgid, rgid, rgid) == -1)
+	return data;
+#else
+	// No mapping support (yet), callers fall back to reading
+	return NULL;
+#endif
+}
+
+/*************************************************************************************
+ *
+ * Same as map_file(), out of a file already opened (and looked into with fstat(),
+ * say) by the caller, who closes it whenever it suits, the mapping staying valid.
+ *
+ *************************************************************************************
+ */
+
+u8* map_descriptor(int fd, off_t base, size_t* max_len, struct file_mapping* mapping)
+{
+	mapping->base = NULL;
+	mapping->length = 0;
+
+#if defined (BR_LINUX_PLATFORM) || defined (BR_MAC_PLATFORM)
+	struct stat statbuf;
+	off_t mmoffset;
+	void* mmp;
+
+	/*
+	 * mmap() will fail with SIGBUS if trying to map beyond the end of
+	 * the file, so only regular files with known size qualify.
+	 */
+	if (fstat(fd, &statbuf) == -1 || !S_ISREG(statbuf.st_mode) || base >= statbuf.st_size)
 	{
-		gerr = errno;
-		if (!gerr)
-			gerr = EINVAL;
+		return NULL;
 	}
-	uerr = 0;
-	if (setresuid(ruid, ruid, ruid) == -1)
+
+	if (*max_len > (size_t)statbuf.st_size - base)
 	{
-		uerr = errno;
-		if (!uerr)
-		{
-			uerr = EINVAL;
-		}
+		*max_len = statbuf.st_size - base;
 	}
-	if (uerr || gerr)
-	{
-		if (uerr)
-		{
-			fprintf(stderr, "Cannot drop user privileges: %s.\n", strerror(uerr));
-		}
-		if (gerr)
-		{
-			fprintf(stderr, "Cannot drop group privileges: %s.\n", strerror(gerr));
-		}
 
+#ifdef _SC_PAGESIZE
+	mmoffset = base % sysconf(_SC_PAGESIZE);
+#else
+	mmoffset = base % getpagesize();
+#endif /* _SC_PAGESIZE */
+
+	mmp = mmap(NULL, mmoffset + *max_len, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, base - mmoffset);
+
+	if (mmp == MAP_FAILED)
+	{
 		return NULL;
 	}
-#endif// BR_LINUX_PLATFORM
-	return p;
+
+	mapping->base = mmp;
+	mapping->length = mmoffset + *max_len;
+
+	return (u8*)mmp + mmoffset;
+#else
+	return NULL;
+#endif
+}
+
+/*
+ * Release the mapping obtained from map_file().
+ */
+void unmap_file(struct file_mapping* mapping)
+{
+#if defined (BR_LINUX_PLATFORM) || defined (BR_MAC_PLATFORM)
+	if (mapping->base != NULL && munmap(mapping->base, mapping->length) == -1)
+	{
+		perror("munmap");
+	}
+#endif
+
+	mapping->base = NULL;
+	mapping->length = 0;
 }
 
 static void safe_memcpy(void* dest, const void* src, size_t n)
@@ -0,0 +1,46 @@
+/*
+ *   ----------------------------
+ *  |  arena.h
+ *   ----------------------------
+ *   This file is part of BiosReader.
+ *
+ *   BiosReader is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   BiosReader is distributed in the hope and belief that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with BiosReader.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+/*
+ * A bump allocator. Everything handed out lives until the arena is reset (all at
+ * once), and a reset keeps the blocks around so that the next run of the same size
+ * doesn't bother the heap at all.
+ */
+struct br_arena_block
+{
+	struct br_arena_block* next;
+	size_t size; // usable bytes, right after this header
+	size_t used;
+};
+
+struct br_arena
+{
+	struct br_arena_block* head;
+	struct br_arena_block* current; // where allocations are made from
+};
+
+void* br_arena_alloc(struct br_arena* arena, size_t size);
+char* br_arena_strdup(struct br_arena* arena, const char* source);
+void br_arena_reset(struct br_arena* arena);
+void br_arena_release(struct br_arena* arena);
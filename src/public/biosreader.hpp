@@ -0,0 +1,252 @@
+/*
+ *   ----------------------------
+ *  |  biosreader.hpp
+ *   ----------------------------
+ *   This file is part of BiosReader.
+ *
+ *   BiosReader is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   BiosReader is distributed in the hope and belief that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with BiosReader.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+/*
+ * BiosReader for C++20, header only. A bios::Table owns a context, its structures come as
+ * views into the table (see br_cursor_next()), strings as std::string_view and the decoded
+ * records as std::span, so nothing is copied or allocated on the way over:
+ *
+ *   bios::Table table;
+ *
+ *   for (const bios::Structure& device : table.structures() | bios::by_type(17))
+ *   {
+ *       std::string_view partNumber = device.string(0x1A);
+ *       ...
+ *   }
+ *
+ *   for (const random_access_memory& device : table.memory_devices())
+ *   {
+ *       ...
+ *   }
+ *
+ * Views, strings and spans are good till the table is reset (or goes away).
+ */
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <new>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <string_view>
+#include <utility>
+
+extern "C"
+{
+#include "dmidecode.h"
+#include "dmicolumns.h"
+#include "dmiwalk.h"
+}
+
+namespace bios
+{
+	/*
+	 * One SMBIOS structure where the table has it, see br_cursor_next()
+	 */
+	class Structure
+	{
+	public:
+		std::uint8_t type() const { return header.type; }
+		std::uint16_t handle() const { return header.handle; }
+
+		// The formatted area, header included
+		std::span<const std::uint8_t> formatted() const { return { header.data, header.length }; }
+
+		// The string whose number is the byte at offset, empty (and data() nullptr) if there is none
+		std::string_view string(std::uint8_t offset) const
+		{
+			std::size_t length;
+			const char* string = br_walk_string_span(&header, offset, &length);
+
+			return string != nullptr ? std::string_view(string, length) : std::string_view();
+		}
+
+		// The little endian number at offset, nullopt if the structure is too short to have it
+		template <std::unsigned_integral T>
+			requires (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)
+		std::optional<T> number(std::uint8_t offset) const
+		{
+			int bPresent;
+			unsigned long long number = br_walk_number(&header, offset, sizeof(T), &bPresent);
+
+			return bPresent ? std::optional<T>(static_cast<T>(number)) : std::nullopt;
+		}
+
+		const dmi_header& raw() const { return header; }
+
+	private:
+		friend class StructureIterator;
+
+		dmi_header header{};
+	};
+
+	/*
+	 * Input iterator over the structures of a context, the C cursor underneath
+	 */
+	class StructureIterator
+	{
+	public:
+		using value_type = Structure;
+		using difference_type = std::ptrdiff_t;
+
+		StructureIterator() = default;
+
+		explicit StructureIterator(br_context* context)
+		{
+			br_cursor_begin(context, &cursor);
+			advance();
+		}
+
+		const Structure& operator*() const { return current; }
+		const Structure* operator->() const { return &current; }
+
+		StructureIterator& operator++()
+		{
+			advance();
+			return *this;
+		}
+
+		void operator++(int) { advance(); }
+
+		friend bool operator==(const StructureIterator& iterator, std::default_sentinel_t) { return iterator.bEnd; }
+
+	private:
+		void advance() { bEnd = !br_cursor_next(&cursor, &current.header); }
+
+		br_cursor cursor{};
+		Structure current;
+		bool bEnd = true;
+	};
+
+	/*
+	 * The structures of a context in table order, up to the end-of-table marker
+	 */
+	class StructureRange : public std::ranges::view_interface<StructureRange>
+	{
+	public:
+		StructureRange() = default;
+		explicit StructureRange(br_context* context) : context(context) {}
+
+		StructureIterator begin() const { return context != nullptr ? StructureIterator(context) : StructureIterator(); }
+		std::default_sentinel_t end() const { return std::default_sentinel; }
+
+	private:
+		br_context* context = nullptr;
+	};
+
+	// table.structures() | by_type(17)
+	inline auto by_type(std::uint8_t type)
+	{
+		return std::views::filter([type](const Structure& structure) { return structure.type() == type; });
+	}
+
+	/*
+	 * Owns a context (see br_context_create()), the table of the running machine unless told
+	 * to decode a dump instead
+	 */
+	class Table
+	{
+	public:
+		Table() : context(br_context_create())
+		{
+			if (context == nullptr)
+			{
+				throw std::bad_alloc();
+			}
+		}
+
+		explicit Table(const char* dumpFile) : Table()
+		{
+			br_context_set_dump_file(context, dumpFile);
+		}
+
+		Table(Table&& other) noexcept : context(std::exchange(other.context, nullptr)) {}
+
+		Table& operator=(Table&& other) noexcept
+		{
+			if (this != &other)
+			{
+				release();
+				context = std::exchange(other.context, nullptr);
+			}
+
+			return *this;
+		}
+
+		Table(const Table&) = delete;
+		Table& operator=(const Table&) = delete;
+
+		~Table() { release(); }
+
+		StructureRange structures() const { return StructureRange(context); }
+
+		// The decoded records, decoding what it takes first (see dmicolumns.h)
+		std::span<const central_processing_unit> processors() const
+		{
+			const struct br_processor_columns* columns = br_processor_columns(context);
+
+			return records(columns != nullptr ? columns->count : 0, br_fetch_processor(context, 0));
+		}
+
+		std::span<const turing_machine_system_memory> memory_arrays() const
+		{
+			const struct br_memory_array_columns* columns = br_memory_array_columns(context);
+
+			return records(columns != nullptr ? columns->count : 0, br_fetch_memory_array(context, 0));
+		}
+
+		std::span<const random_access_memory> memory_devices() const
+		{
+			const struct br_memory_device_columns* columns = br_memory_device_columns(context);
+
+			return records(columns != nullptr ? columns->count : 0, br_fetch_memory_device(context, 0));
+		}
+
+		const bios_information& bios() const { return *static_cast<const bios_information*>(br_decode(context, ss_bios)); }
+
+		void set_dump_file(const char* dumpFile) { br_context_set_dump_file(context, dumpFile); }
+		void use_cache(bool bUseCache) { br_context_use_cache(context, bUseCache); }
+		void reset() { br_context_reset(context); }
+
+		br_context* get() const { return context; }
+
+	private:
+		template <typename T>
+		static std::span<const T> records(unsigned int count, const T* first)
+		{
+			return first != nullptr ? std::span<const T>(first, count) : std::span<const T>();
+		}
+
+		void release()
+		{
+			if (context != nullptr)
+			{
+				br_context_destroy(context);
+				context = nullptr;
+			}
+		}
+
+		br_context* context;
+	};
+}
@@ -0,0 +1,168 @@
+/*
+ *   ----------------------------
+ *  |  brcontext.h
+ *   ----------------------------
+ *   This file is part of BiosReader.
+ *
+ *   BiosReader is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   BiosReader is distributed in the hope and belief that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with BiosReader.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "types.h"
+#include "util.h"
+#include "dmidecode.h"
+#include "dmiopt.h"
+#include "dmioem.h"
+#include "dmiindex.h"
+#include "dmicolumns.h"
+#include "arena.h"
+#include "intern.h"
+
+/*
+ * The table stays at hand after the first query so that categories get decoded on demand
+ */
+struct loaded_dmi_table
+{
+	u8* buf;
+	u32 len;
+	u16 ver;
+	struct file_mapping mapping; // when decoded in place out of a mapped file
+	void* allocation; // when read into the heap, what to free
+};
+
+/*
+ * The records of the types with nothing but a record to them (see br_fetch_system() and the
+ * like), one kind per SMBIOS type
+ */
+enum dmi_record_kind
+{
+	DMI_RECORD_SYSTEM, // 1
+	DMI_RECORD_BASE_BOARD, // 2
+	DMI_RECORD_CHASSIS, // 3
+	DMI_RECORD_PORT_CONNECTOR, // 8
+	DMI_RECORD_SYSTEM_SLOT, // 9
+	DMI_RECORD_VOLTAGE_PROBE, // 26
+	DMI_RECORD_TEMPERATURE_PROBE, // 28
+	DMI_RECORD_CURRENT_PROBE, // 29
+	DMI_RECORD_POWER_SUPPLY, // 39
+	DMI_RECORD_KINDS
+};
+
+/*
+ * A record for each structure of the type, in table order, counter of them decoded so far
+ */
+struct dmi_record_array
+{
+	void* records;
+	unsigned int count;
+	unsigned int counter;
+};
+
+/*
+ * What the records of a kind are made of, for whoever keeps them elsewhere (see dmicache.c)
+ */
+struct dmi_record_layout
+{
+	size_t size;
+	const size_t* strings; // offsetof() every char* of the record
+	size_t stringCount;
+};
+
+// The layout of the records of the kind, out of the one description of them in dmidecode.c
+const struct dmi_record_layout* dmi_record_layout_of(enum dmi_record_kind kind);
+
+/*
+ * Everything one decode is made of. Applications only ever see a pointer to it
+ * (see dmidecode.h), BiosReader's innards see the whole of it. Contexts share
+ * nothing, so that as many of them as one likes can be decoding at the same time,
+ * each on a thread of its own.
+ */
+struct br_context
+{
+	// What the queries hand out
+	struct bios_information biosinformation;
+	struct mb_language_modules mblanguagemodules;
+	struct random_access_memory* randomaccessmemory;
+	struct turing_machine_system_memory turingmachinesystemmemory;
+	struct central_processing_unit centralprocessinguint;
+	struct graphics_processing_unit graphicsprocessingunit;
+
+	// All of the graphics processing units, the one above being the first
+	struct graphics_processing_unit* graphicsprocessingunits;
+	unsigned int gpuCounter;
+
+	unsigned int ramCounter;
+
+	// The caches (type 7 structures), in table order, see br_processor_caches()
+	struct cpu_cache* processorcaches;
+	unsigned int cacheCount;
+	unsigned int cacheCounter;
+
+	// Every processor and every memory array, in table order. The ones above are the last of them
+	struct central_processing_unit* processors;
+	unsigned int processorCount;
+	unsigned int processorCounter;
+	struct turing_machine_system_memory* memoryarrays;
+	unsigned int arrayCount;
+	unsigned int arrayCounter;
+
+	// The rest of what is decoded, see enum dmi_record_kind
+	struct dmi_record_array records[DMI_RECORD_KINDS];
+
+	// The records above, column by column, built on first demand (see dmicolumns.h)
+	struct br_processor_columns processorColumns;
+	struct br_memory_array_columns memoryArrayColumns;
+	struct br_memory_device_columns memoryDeviceColumns;
+	int bColumnsBuilt;
+
+	int bAlreadyRun;
+
+	// One bit per bios_reader_information_classification already decoded (and cached)
+	u32 decodedCategories;
+
+	struct opt opt;
+
+	// Saved by the first pass, for vendor-specific decodes
+	struct dmi_oem_state oem;
+
+	// Where every structure of the loaded table lives, see dmi_index_build()
+	struct dmi_structure_index tableIndex;
+	struct loaded_dmi_table loadedTable;
+
+	// Owns every string (and array) decoded in a run, see copy_to_structure_char()
+	struct br_arena decodeArena;
+
+	// Every distinct string of the run, once, see br_string_id()
+	struct br_intern_pool stringPool;
+
+	// Set to keep away from the on-disk cache of decoded inventories, see dmicache.h
+	int bNoCache;
+
+	// The inventory came out of the on-disk cache, the table is yet to be read (see br_context_table_at_hand())
+	int bTableLeftOnDisk;
+
+	// Where the decode is displayed, NULL for nowhere. See br_context_set_output_sink()
+	const struct br_output_sink* outputSink;
+
+	// Caller supplied buffer the DMI table gets read into, see br_context_pin_table_buffer()
+	u8* pinnedTableBuffer;
+	size_t pinnedTableBufferSize;
+};
+
+// The table read and walked, nothing decoded, see br_project(). 0 if there is no table to be had
+int br_context_table_at_hand(struct br_context* context);
+
+// Header of entry i of the index of the table at hand, see to_dmi_header()
+void br_context_header_of(struct br_context* context, u32 i, struct dmi_header* h);
@@ -0,0 +1,81 @@
+/*
+ *   ----------------------------
+ *  |  dmibatch.h
+ *   ----------------------------
+ *   This file is part of BiosReader.
+ *
+ *   BiosReader is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   BiosReader is distributed in the hope and belief that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with BiosReader.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+/*
+ * What is made of one dump. Strings are copied out of the decode, so that the
+ * result outlives it (the context gets reused for the next dump).
+ */
+struct br_batch_result
+{
+	const char* path; // as handed to br_batch_decode()
+	int bDecoded; // 0 if the dump couldn't be read or holds no SMBIOS table
+
+	unsigned int smbiosversion; // major << 8 | minor
+	unsigned int structurecount;
+	unsigned int tablelength; // bytes
+
+	char biosvendor[64];
+	char biosversion[64];
+	char biosreleasedate[16];
+	char processor[96];
+	unsigned int memorydevices;
+	char systemmemory[32];
+};
+
+struct br_batch_statistics
+{
+	size_t dumps;
+	size_t decoded;
+	size_t steals; // dumps decoded by a thread other than the one they were dealt to
+	unsigned int threads;
+	double seconds; // wall clock, first dump to last
+	double dumpspersecond;
+};
+
+// Called once per dump, in the order the dumps were handed in, never from two threads at once
+typedef void (*br_batch_emit_function)(const struct br_batch_result* result, void* userdata);
+
+/*
+ *************************************************************************************************
+ *
+ * Decode a bunch of dumps (see write_dump()) on a pool of threads, one br_context each.
+ * Dumps are dealt out round-robin, and a thread done with its share steals from the
+ * others, so a few huge dumps don't keep everybody waiting.
+ *
+ * @param paths             The dumps
+ * @param count             How many of them
+ * @param threads           Size of the pool, 0 for one per processor
+ * @param emit              Gets the results, in order. May be NULL
+ * @param userdata          Handed to emit
+ * @param statistics        Filled up at the end. May be NULL
+ * @return int              0 on success, -1 if the pool couldn't be set up
+ *
+ *************************************************************************************************
+ */
+
+int br_batch_decode(const char* const* paths, size_t count, unsigned int threads,
+	br_batch_emit_function emit, void* userdata, struct br_batch_statistics* statistics);
+
+// How many threads br_batch_decode() uses when asked for 0
+unsigned int br_batch_default_threads();
@@ -0,0 +1,85 @@
+/*
+ *   ----------------------------
+ *  |  dmicache.h
+ *   ----------------------------
+ *   This file is part of BiosReader.
+ *
+ *   BiosReader is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   BiosReader is distributed in the hope and belief that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with BiosReader.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+#include "types.h"
+
+// Bump whenever one of the cached structs changes shape, older images are then simply ignored
+#define DMI_CACHE_LAYOUT 6
+
+// The categories an image holds (everything out of the table, the graphics cards aren't)
+#define DMI_CACHE_CATEGORIES ((1u << ss_bios) | (1u << ps_processor) | (1u << pi_bioslanguages) \
+	| (1u << pi_systemmemory) | (1u << ps_systemmemory) | (1u << pi_manufacturer) | (1u << ps_motherboard) \
+	| (1u << ps_chassis))
+
+struct br_context;
+
+/*
+ * What a cached image is made for: the entry point (bytes and all) and the length of
+ * the table it points at. FNV-1a, 64 bits.
+ */
+unsigned long long dmi_cache_fingerprint(const u8* entryPoint, size_t entryPointLength, u32 tableLength);
+
+/*
+ *************************************************************************************************
+ *
+ * Where the image lives: $XDG_CACHE_HOME/biosreader, else ~/.cache/biosreader, else
+ * /run/biosreader. The directories are created as needed, private to the user (0700).
+ *
+ * @param path          Filled up with the path of the image
+ * @param size          Capacity of path
+ * @return int          0 on success, -1 if there is no place for it
+ *
+ *************************************************************************************************
+ */
+
+int dmi_cache_path(char* path, size_t size);
+
+/*
+ *************************************************************************************************
+ *
+ * Fill up the context out of the image, if there is one for the fingerprint. The image
+ * is mapped, checked from top to bottom, and copied into the context's arena, so that
+ * nothing of it is needed afterwards. Images not owned by the effective user, or writable
+ * by the group or others, are passed over.
+ *
+ * @return int          1 on a hit (the cached categories marked decoded), 0 otherwise
+ *
+ *************************************************************************************************
+ */
+
+int dmi_cache_load(struct br_context* context, unsigned long long fingerprint, const char* path);
+
+/*
+ *************************************************************************************************
+ *
+ * Save what the context has decoded (all of DMI_CACHE_CATEGORIES must be) as the image for
+ * the fingerprint. Written aside and renamed over the old one, so that readers see either
+ * image whole.
+ *
+ * @return int          0 on success, -1 otherwise (the cache is a nicety, nothing to report)
+ *
+ *************************************************************************************************
+ */
+
+int dmi_cache_store(const struct br_context* context, unsigned long long fingerprint, const char* path);
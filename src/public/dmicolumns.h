@@ -0,0 +1,102 @@
+/*
+ *   ----------------------------
+ *  |  dmicolumns.h
+ *   ----------------------------
+ *   This file is part of BiosReader.
+ *
+ *   BiosReader is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   BiosReader is distributed in the hope and belief that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with BiosReader.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+/*
+ * The processors, memory arrays and memory devices of a context, column by column: entry i
+ * of every column is about the i-th record (see br_fetch_processor(), br_fetch_memory_array()
+ * and br_fetch_memory_device()). Numbers are 0 where unknown, as in the records. Columns live
+ * as long as the records do, that is till the context is reset.
+ */
+struct br_processor_columns
+{
+	unsigned int count;
+
+	const unsigned int* handles;
+	const unsigned int* cores;
+	const unsigned int* enabledcores;
+	const unsigned int* threads;
+	const unsigned int* maximumspeedmhz;
+	const unsigned int* currentspeedmhz;
+	const unsigned int* externalclockmhz;
+	const unsigned int* voltagemv;
+	const char* const* versions;
+};
+
+struct br_memory_array_columns
+{
+	unsigned int count;
+
+	const unsigned int* handles;
+	const unsigned long long* capacitybytes;
+	const unsigned int* devicecounts;
+	const char* const* uses;
+};
+
+struct br_memory_device_columns
+{
+	unsigned int count;
+
+	const unsigned int* handles;
+	const unsigned int* arrayhandles;
+	const unsigned long long* sizebytes;
+	const unsigned int* speedmts;
+	const unsigned int* configuredspeedmts;
+	const unsigned int* voltagemv;
+	const unsigned int* ranks;
+	const char* const* locators;
+
+	// br_string_id() of the manufacturer and of the part number, to group the devices by
+	const unsigned int* manufacturerids;
+	const unsigned int* partnumberids;
+};
+
+struct br_context;
+
+/*
+ *************************************************************************************************
+ *
+ * The columns of a context, decoding what it takes first.
+ *
+ * @return                  NULL if out of memory
+ *
+ *************************************************************************************************
+ */
+
+const struct br_processor_columns* br_processor_columns(struct br_context* context);
+const struct br_memory_array_columns* br_memory_array_columns(struct br_context* context);
+const struct br_memory_device_columns* br_memory_device_columns(struct br_context* context);
+
+/*
+ *************************************************************************************************
+ *
+ * A couple of the questions asked of every machine of a fleet, answered out of the columns.
+ *
+ * br_installed_memory_bytes()              Sum of the sizes of the memory devices
+ * br_slowest_memory_device()               The installed device with the lowest configured
+ *                                          speed (position among the memory devices), -1 if
+ *                                          no speed is known
+ *
+ *************************************************************************************************
+ */
+
+unsigned long long br_installed_memory_bytes(struct br_context* context);
+int br_slowest_memory_device(struct br_context* context);
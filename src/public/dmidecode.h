@@ -21,6 +21,7 @@
 #ifndef DMIDECODE_H
 #define DMIDECODE_H
 
+#include <stddef.h>
 #include <types.h>
 
 #if defined BR_MAC_PLATFORM
@@ -42,6 +43,8 @@
   *******************************************************************
   */
 
+// Never filled, the structures behind them have records of their own (see base_board, port_connector,
+// system_slot and management_probe)
 struct motherboard_components
 {
 	char* baseboard;
@@ -59,11 +62,20 @@ struct turing_machine_system_memory
 	int bIsFilled;
 
 	// A number
-	unsigned int number_of_ram_or_system_memory_devices; // Computed near "case 16: /* 7.17 Physical Memory Array */"
+	unsigned int number_of_ram_or_system_memory_devices; // Number of Memory Device (type 17) structures, counted in dmi_table_decode(). Those of the array for br_fetch_memory_array()
 	char* total_grand_capacity;
 	char* mounting_location; // usually some view-able und asthetic place
+	char* use; // System Memory, Video Memory, Flash Memory and so on
+
+	// Numbers as they are, no parsing needed. 0 if unknown
+	unsigned long long total_grand_capacity_bytes;
+
+	// Its own handle (the memory devices refer to it, see br_memory_devices_of_array()), and
+	// that of its error information (0xFFFE if not provided, 0xFFFF if there is none)
+	unsigned int handle;
+	unsigned int errorhandle;
 };
-struct turing_machine_system_memory extern turingmachinesystemmemory;
+struct turing_machine_system_memory extern turingmachinesystemmemory; // The (last) array of system memory, with every memory device to its name
 
 // Makes me remind class V, when I first read the word, thought it was Raam
 // https://en.wikipedia.org/wiki/Rama, and in graduate school, I stumbled upon
@@ -97,22 +109,48 @@ struct random_access_memory
 	// Error Correction Code(ECC) an additional 8 bits are added, which makes the data block 72 bits wide
 	// Reference: https://www.crucial.in/support/articles-faq-memory/what-is-a-memory-rank#:~:text=A%20memory%20rank%20is%20a,data%20block%2072%20bits%20wide.
 	char* rank;
+
+	// The above, as numbers. 0 if unknown (or no module installed)
+	unsigned long long ramsizebytes;
+	unsigned int memoryspeedmts; // MT/s
+	unsigned int configuredmemoryspeedmts; // MT/s
+	unsigned int operatingvoltagemv; // millivolts, configured
+	unsigned int ranks;
+
+	// Its own handle, the array it belongs to and its error information (as above)
+	unsigned int handle;
+	unsigned int arrayhandle;
+	unsigned int errorhandle;
 };
 struct random_access_memory extern* randomaccessmemory;
-static unsigned int ramCounter;
 
+// One of the caches the processor refers to by handle, see br_processor_caches()
 struct cpu_cache
 {
+	int bIsFilled;
+
 	char* designation;
-	char* status;
+	char* status; // Enabled or Disabled
 	char* operationmode;
+	char* location;
 	char* sramtype;
 	char* speed;
 	char* errorcorrection;
+	char* systemtype; // Instruction, Data or Unified
 	char* associativity;
 	char* installedsize;
+	char* maximumsize;
+
+	// The above, as numbers. 0 if unknown
+	unsigned int level; // 1 for L1 and so on
+	unsigned long long installedsizebytes;
+	unsigned long long maximumsizebytes;
+	unsigned int speedns; // nanoseconds
+
+	unsigned int handle;
 };
 
+// Never filled, see management_probe
 struct mb_management_elements
 {
 	char* temperatureprobe;
@@ -120,6 +158,144 @@ struct mb_management_elements
 	char* data;
 };
 
+// 7.2 System Information, see br_fetch_system()
+struct system_information
+{
+	int bIsFilled;
+
+	char* manufacturer;
+	char* productname;
+	char* version;
+	char* serialnumber;
+	char* uuid; // 8-4-4-4-12 hex digits, or Not Present, Not Settable
+	char* wakeuptype;
+	char* skunumber;
+	char* family;
+
+	unsigned int handle;
+};
+
+// 7.3 Baseboard (or Module) Information, see br_fetch_base_board()
+struct base_board
+{
+	int bIsFilled;
+
+	char* manufacturer;
+	char* productname;
+	char* version;
+	char* serialnumber;
+	char* assettag;
+	char* locationinchassis;
+	char* boardtype; // Motherboard, Daughter Board and so on
+
+	unsigned int features; // the feature flags, as they are (bit 0: hosting board, bit 3: hot swappable and so on)
+
+	unsigned int handle;
+	unsigned int chassishandle;
+};
+
+// 7.4 System Enclosure or Chassis, see br_fetch_chassis()
+struct chassis_information
+{
+	int bIsFilled;
+
+	char* manufacturer;
+	char* chassistype; // Desktop, Notebook, Rack Mount Chassis and so on
+	char* version;
+	char* serialnumber;
+	char* assettag;
+	char* bootupstate; // Safe, Warning, Critical and so on
+	char* powersupplystate;
+	char* thermalstate;
+	char* securitystatus;
+
+	// Numbers as they are, 0 if unknown
+	int bLocked; // there is a lock
+	unsigned int heightu; // in U (1.75 inches)
+	unsigned int powercords;
+
+	unsigned int handle;
+};
+
+// 7.9 Port Connector Information, see br_fetch_port_connector()
+struct port_connector
+{
+	int bIsFilled;
+
+	char* internaldesignator;
+	char* internalconnector; // None, 9 Pin Dual Inline (pin 10 cut) and so on
+	char* externaldesignator;
+	char* externalconnector; // Access Bus (USB), RJ-45 and so on
+	char* porttype; // USB, Network Port, Audio Port and so on
+
+	unsigned int handle;
+};
+
+// 7.10 System Slots, see br_fetch_system_slot()
+struct system_slot
+{
+	int bIsFilled;
+
+	char* designation;
+	char* slottype; // PCI Express Gen 4, M.2 Socket 3 and so on
+	char* buswidth; // x16 and so on
+	char* currentusage; // Available, In Use and so on
+	char* slotlength;
+
+	unsigned int slotid;
+
+	unsigned int handle;
+};
+
+// What a probe reads is -32768 when unknown, as SMBIOS has it
+#define BR_PROBE_UNKNOWN (-32768)
+
+// 7.27 Voltage Probe, 7.29 Temperature Probe and 7.30 Electrical Current Probe, see br_fetch_probe()
+struct management_probe
+{
+	int bIsFilled;
+
+	unsigned int type; // 26, 28 or 29, which goes for the units below
+
+	char* description;
+	char* location; // Processor, Motherboard and so on
+	char* status; // OK, Non-critical, Critical and so on
+
+	// In millivolts, tenths of degree Celsius or milliamps. BR_PROBE_UNKNOWN if unknown
+	int maximum;
+	int minimum;
+	int tolerance; // plus or minus
+	int nominal;
+
+	unsigned int handle;
+};
+
+// 7.40 System Power Supply, see br_fetch_power_supply()
+struct power_supply
+{
+	int bIsFilled;
+
+	char* location;
+	char* devicename;
+	char* manufacturer;
+	char* serialnumber;
+	char* assettag;
+	char* modelpartnumber;
+	char* revisionlevel;
+	char* supplytype; // Switching, Battery, UPS and so on
+	char* status; // OK, Non-critical and so on, Not Present
+	char* inputvoltagerangeswitching; // Manual, Auto-switch and so on
+
+	// Numbers as they are, 0 if unknown
+	unsigned int maximumpowerwatts;
+	unsigned int powerunitgroup;
+	int bPresent;
+	int bUnplugged;
+	int bHotReplaceable;
+
+	unsigned int handle;
+};
+
 struct mb_language_modules
 {
 	int bIsFilled;
@@ -129,7 +305,7 @@ struct mb_language_modules
 };
 struct mb_language_modules extern mblanguagemodules;
 
-// Assuming 1 cpu only
+// One per socket, see br_fetch_processor(). centralprocessinguint is the last of them
 struct central_processing_unit
 {
 	int bIsFilled;
@@ -141,7 +317,7 @@ struct central_processing_unit
 	char* cputype; // In order to distinguish from GPU processor :) or DSP https://en.wikipedia.org/wiki/Digital_signal_processor
 	char* processingfamily;
 	char* manufacturer;
-	char* cpuflags;
+	char* cpuflags; // One per line, rendered when the record is fetched, see br_cpu_flags_text()
 	char* version; // Kind of the most important element of this struct. eg Intel(R) Core(TM) i5-7400 CPU @ 3.00GHz (completeprocessingunitidentifier)
 	char* operatingvoltage;
 
@@ -162,6 +338,24 @@ struct central_processing_unit
 	// For instance E9 06 09 00 FF FB EB BF (something to be computed by cpu registers and stuff)
 	char* cpuid;
 	char* signature; //
+
+	// The flags above as bits (CPUID EDX, x86 only), see br_cpu_has()
+	unsigned int cpuflagsmask;
+
+	// The above, as numbers. 0 if unknown
+	unsigned int operatingvoltagemv; // millivolts. Older processors tell only which voltages they support, 0 then
+	unsigned int externalclockmhz;
+	unsigned int maximumspeedmhz;
+	unsigned int currentspeedmhz;
+	unsigned int cores;
+	unsigned int enabledcores;
+	unsigned int threads;
+
+	// Its own handle and those of its caches, 0xFFFF for none. See br_processor_caches()
+	unsigned int handle;
+	unsigned int l1cachehandle;
+	unsigned int l2cachehandle;
+	unsigned int l3cachehandle;
 };
 struct central_processing_unit extern centralprocessinguint; // I know it should be unit, can't resist the temptation, besides uint means unsigned so...
 
@@ -184,8 +378,11 @@ struct bios_information
 	char* vendor;
 	char* version;
 	char* biosreleasedate;
-	char bioscharacteristics[9999];
+	char* bioscharacteristics; // One per line, rendered when the record is fetched, see br_bios_characteristics_text()
 	char* biosromsize;
+
+	// The characteristics as bits, see br_bios_has()
+	unsigned long long characteristics;
 	//struct mb_language_modules knownLanguages;
 };
 struct bios_information extern biosinformation;
@@ -220,10 +417,12 @@ enum bios_reader_information_classification
  * performing queries about the electronics.
  *
  * Things to note:
- * 1. First (for instance since application start) query shall iterate over all the electronics
- *    and cache the information which shall be returned on that specific query.
- * 2. Subsequent queries shall return the cached information only.
- * 3. An overall iteration shall be performed only if application restarts or
+ * 1. First (for instance since application start) query shall read and index the electronics
+ *    information (the DMI table), and decode only the category asked for.
+ * 2. First query of any other category decodes that category, out of the same table.
+ *    The GPU, for instance, is probed only when ps_graphicscard is asked for.
+ * 3. Subsequent queries shall return the cached information only.
+ * 4. The table shall be read again only if application restarts or
  *    reset_electronics_structures() is invoked
  *
  * @param informationCategory                        The category of electronics being queried
@@ -256,8 +455,288 @@ void reset_electronics_structures();
 
 struct random_access_memory* fetch_access_memory_members(unsigned int counter);
 
-// Should the electronics be displayed in console with each query
-#define bDisplayOutput 0
+/*
+ ***************************************************************************************************
+ *
+ * Return the graphics_processing_unit structs, one by one. graphicsprocessingunit (the one
+ * electronics_spit(ps_graphicscard) returns) is the first of these. NULL past the last one.
+ *
+ ***************************************************************************************************
+ */
+
+struct graphics_processing_unit* fetch_graphics_processing_unit_members(unsigned int counter);
+
+/*
+ ***************************************************************************************************
+ *
+ * Hand BiosReader a buffer of your own for the raw DMI table to be read into, so that repeated
+ * queries (after reset_electronics_structures()) don't allocate and free the table every time.
+ * Tables which can be mapped are decoded in place and don't need it at all.
+ *
+ * @param buffer                                     Storage which outlives the queries, NULL to unpin
+ * @param size                                       Capacity in bytes (64 kB covers most machines)
+ *
+ ***************************************************************************************************
+ */
+
+void br_pin_table_buffer(void* buffer, size_t size);
+
+/*
+ ***************************************************************************************************
+ *
+ * Have the electronics displayed as they get decoded: br_text_output_sink() for dmidecode's
+ * listing on the console, or a JSON document, or your own handlers (see dmioutput.h). Takes
+ * effect with the next decode, that is, after reset_electronics_structures().
+ *
+ * @param sink                                       Outlives the queries, NULL (the default) for none
+ *
+ ***************************************************************************************************
+ */
+
+struct br_output_sink;
+
+void br_set_output_sink(const struct br_output_sink* sink);
+
+/*
+ ***************************************************************************************************
+ *
+ * Text for the byte counts above, on demand: the largest unit (bytes, kB, MB, ...) the size is a
+ * whole number of, as in "16 GB" or "1536 MB".
+ *
+ * @param bytes                                      The size
+ * @param buffer                                     Where to write the text (24 bytes hold any size)
+ * @param size                                       Capacity of buffer
+ * @return char*                                     buffer
+ *
+ ***************************************************************************************************
+ */
+
+char* br_format_memory_size(unsigned long long bytes, char* buffer, size_t size);
+
+/*
+ ***************************************************************************************************
+ *
+ * BIOS characteristics (7.1.1, and the extension bytes 7.1.2.1 and 7.1.2.2 from bit 32 and bit
+ * 40 on) and processor flags (CPUID EDX), as bits of bios_information::characteristics and
+ * central_processing_unit::cpuflagsmask.
+ *
+ ***************************************************************************************************
+ */
+
+enum br_bios_characteristic
+{
+	BR_BIOS_CHARACTERISTICS_NOT_SUPPORTED = 3,
+	BR_BIOS_ISA,
+	BR_BIOS_MCA,
+	BR_BIOS_EISA,
+	BR_BIOS_PCI,
+	BR_BIOS_PC_CARD,
+	BR_BIOS_PNP,
+	BR_BIOS_APM,
+	BR_BIOS_UPGRADEABLE,
+	BR_BIOS_SHADOWING,
+	BR_BIOS_VLB,
+	BR_BIOS_ESCD,
+	BR_BIOS_BOOT_FROM_CD,
+	BR_BIOS_SELECTABLE_BOOT,
+	BR_BIOS_ROM_SOCKETED,
+	BR_BIOS_BOOT_FROM_PC_CARD,
+	BR_BIOS_EDD,
+	BR_BIOS_FLOPPY_NEC_9800,
+	BR_BIOS_FLOPPY_TOSHIBA,
+	BR_BIOS_FLOPPY_525_360KB,
+	BR_BIOS_FLOPPY_525_1_2MB,
+	BR_BIOS_FLOPPY_35_720KB,
+	BR_BIOS_FLOPPY_35_2_88MB,
+	BR_BIOS_PRINT_SCREEN,
+	BR_BIOS_8042_KEYBOARD,
+	BR_BIOS_SERIAL,
+	BR_BIOS_PRINTER,
+	BR_BIOS_CGA_MONO_VIDEO,
+	BR_BIOS_NEC_PC_98, // 31
+
+	BR_BIOS_ACPI = 32,
+	BR_BIOS_USB_LEGACY,
+	BR_BIOS_AGP,
+	BR_BIOS_I2O_BOOT,
+	BR_BIOS_LS_120_BOOT,
+	BR_BIOS_ATAPI_ZIP_BOOT,
+	BR_BIOS_IEEE_1394_BOOT,
+	BR_BIOS_SMART_BATTERY, // 39
+
+	BR_BIOS_BOOT_SPECIFICATION = 40,
+	BR_BIOS_NETWORK_BOOT,
+	BR_BIOS_TARGETED_CONTENT_DISTRIBUTION,
+	BR_BIOS_UEFI,
+	BR_BIOS_VIRTUAL_MACHINE,
+	BR_BIOS_MANUFACTURING_MODE_SUPPORTED,
+	BR_BIOS_MANUFACTURING_MODE_ENABLED // 46
+};
+
+enum br_cpu_flag
+{
+	BR_CPU_FPU = 0,
+	BR_CPU_VME,
+	BR_CPU_DE,
+	BR_CPU_PSE,
+	BR_CPU_TSC,
+	BR_CPU_MSR,
+	BR_CPU_PAE,
+	BR_CPU_MCE,
+	BR_CPU_CX8,
+	BR_CPU_APIC, // 9
+	BR_CPU_SEP = 11,
+	BR_CPU_MTRR,
+	BR_CPU_PGE,
+	BR_CPU_MCA,
+	BR_CPU_CMOV,
+	BR_CPU_PAT,
+	BR_CPU_PSE_36,
+	BR_CPU_PSN,
+	BR_CPU_CLFSH, // 19
+	BR_CPU_DS = 21,
+	BR_CPU_ACPI,
+	BR_CPU_MMX,
+	BR_CPU_FXSR,
+	BR_CPU_SSE,
+	BR_CPU_SSE2,
+	BR_CPU_SS,
+	BR_CPU_HTT,
+	BR_CPU_TM, // 29
+	BR_CPU_PBE = 31
+};
+
+int br_bios_has(const struct bios_information* bios, enum br_bios_characteristic characteristic);
+int br_cpu_has(const struct central_processing_unit* processor, enum br_cpu_flag flag);
+
+/*
+ * The names of those set, one per line, as dmidecode has them. Like snprintf(), writes what fits
+ * (always NUL terminated unless size is 0) and returns the length of the whole text.
+ */
+size_t br_bios_characteristics_text(const struct bios_information* bios, char* buffer, size_t size);
+size_t br_cpu_flags_text(const struct central_processing_unit* processor, char* buffer, size_t size);
+
+/*
+ ***************************************************************************************************
+ *
+ * Structures refer to one another by handle (processor to caches, memory device to array and
+ * so on). Those handles are resolved through a handle index built along with the walk of the
+ * table, so that joining is as cheap on an 8 socket server as on a laptop.
+ *
+ * br_processor_caches()                             The L1, L2 and L3 caches of the processor into
+ *                                                   caches[0], [1] and [2], NULL where there is none.
+ *                                                   Returns how many were found
+ * br_memory_devices_of_array()                      The memory devices of the array, in table order.
+ *                                                   Like snprintf(), fills up what fits and returns
+ *                                                   how many there are
+ * br_fetch_processor_cache()                        The caches, one by one, NULL past the last one
+ *
+ ***************************************************************************************************
+ */
+
+struct br_context;
+
+unsigned int br_processor_caches(struct br_context* context, const struct central_processing_unit* processor,
+	const struct cpu_cache* caches[3]);
+unsigned int br_memory_devices_of_array(struct br_context* context, const struct turing_machine_system_memory* array,
+	const struct random_access_memory** devices, unsigned int capacity);
+struct cpu_cache* br_fetch_processor_cache(struct br_context* context, unsigned int counter);
+
+/*
+ ***************************************************************************************************
+ *
+ * Every processor (type 4) and every physical memory array (type 16) of the table, in table
+ * order, one by one. NULL past the last one. See dmicolumns.h for all of them at once.
+ *
+ ***************************************************************************************************
+ */
+
+struct central_processing_unit* br_fetch_processor(struct br_context* context, unsigned int counter);
+struct turing_machine_system_memory* br_fetch_memory_array(struct br_context* context, unsigned int counter);
+
+/*
+ ***************************************************************************************************
+ *
+ * The rest of the structures with a record to them, every one of its type, in table order, one
+ * by one. NULL past the last one. Strings are what the table says, as for the records above, and
+ * numbers are as they are.
+ *
+ * br_fetch_system()                                 7.2 System Information (type 1)
+ * br_fetch_base_board()                             7.3 Baseboard Information (type 2)
+ * br_fetch_chassis()                                7.4 System Enclosure or Chassis (type 3)
+ * br_fetch_port_connector()                         7.9 Port Connector Information (type 8)
+ * br_fetch_system_slot()                            7.10 System Slots (type 9)
+ * br_fetch_probe()                                  The voltage (26), temperature (28) or
+ *                                                   electrical current (29) probes
+ * br_fetch_power_supply()                           7.40 System Power Supply (type 39)
+ *
+ ***************************************************************************************************
+ */
+
+struct system_information* br_fetch_system(struct br_context* context, unsigned int counter);
+struct base_board* br_fetch_base_board(struct br_context* context, unsigned int counter);
+struct chassis_information* br_fetch_chassis(struct br_context* context, unsigned int counter);
+struct port_connector* br_fetch_port_connector(struct br_context* context, unsigned int counter);
+struct system_slot* br_fetch_system_slot(struct br_context* context, unsigned int counter);
+struct management_probe* br_fetch_probe(struct br_context* context, u8 type, unsigned int counter);
+struct power_supply* br_fetch_power_supply(struct br_context* context, unsigned int counter);
+
+/*
+ ***************************************************************************************************
+ *
+ * Every string of a decode is kept once, however many records carry it (the manufacturer of 48
+ * DIMMs, "Not Specified" all over). Equal strings of a context are then the same pointer, and
+ * have the same id, so records can be grouped by one of their strings comparing integers only.
+ * Ids are 1 based and good till the context is reset.
+ *
+ * br_string_id()                                    Id of the string (or of the one equal to it),
+ *                                                   0 if no record of the context carries it
+ * br_string_of_id()                                 The string, NULL for an id that isn't one
+ *
+ ***************************************************************************************************
+ */
+
+unsigned int br_string_id(struct br_context* context, const char* string);
+const char* br_string_of_id(struct br_context* context, unsigned int id);
+
+/*
+ ***************************************************************************************************
+ *
+ * All of the above work on one process-wide (default) context, for the convenience of single
+ * minded applications. Those decoding many tables at once, on as many threads, get a context
+ * each instead. A context owns everything decoded into it, and shares nothing with the others.
+ *
+ * br_context_create()                               A fresh context, NULL if out of memory
+ * br_decode()                                       electronics_spit() for the context; the pointers
+ *                                                   point into the context
+ * br_fetch_memory_device(),
+ * br_fetch_graphics_processing_unit()               fetch_access_memory_members() and
+ *                                                   fetch_graphics_processing_unit_members() for it
+ * br_context_pin_table_buffer()                     br_pin_table_buffer() for it
+ * br_context_set_dump_file()                        Decode a dump (see write_dump()) instead of the
+ *                                                   table of the running machine
+ * br_context_use_cache()                            0 to keep the context off the on-disk cache of
+ *                                                   decoded inventories (see dmicache.h)
+ * br_context_set_output_sink()                      Display the decode, see dmioutput.h for the sinks.
+ *                                                   NULL (the default) for silence
+ * br_context_reset()                                reset_electronics_structures() for it
+ * br_context_destroy()                              Frees the context and all that was decoded into it
+ *
+ ***************************************************************************************************
+ */
+
+struct br_context;
+
+struct br_context* br_context_create();
+void* br_decode(struct br_context* context, enum bios_reader_information_classification informationCategory);
+struct random_access_memory* br_fetch_memory_device(struct br_context* context, unsigned int counter);
+struct graphics_processing_unit* br_fetch_graphics_processing_unit(struct br_context* context, unsigned int counter);
+void br_context_pin_table_buffer(struct br_context* context, void* buffer, size_t size);
+void br_context_set_dump_file(struct br_context* context, const char* dumpfile);
+void br_context_use_cache(struct br_context* context, int bUseCache);
+void br_context_set_output_sink(struct br_context* context, const struct br_output_sink* sink);
+void br_context_reset(struct br_context* context);
+void br_context_destroy(struct br_context* context);
 
 #ifdef BR_WINDOWS_PLATFORM
 
@@ -280,7 +759,7 @@ typedef struct _RawSMBIOSData
 } RawSMBIOSData, * PRawSMBIOSData;
 
 int get_windows_platform(void);
-RawSMBIOSData* get_raw_smbios_table(void);
+RawSMBIOSData* get_raw_smbios_table(struct br_context* context);
 int count_smbios_structures(const void* buff, u32 len);
 
 #endif // BR_WINDOWS_PLATFORM
@@ -291,6 +770,11 @@ struct dmi_header
 	u8 length;
 	u16 handle;
 	u8* data;
+
+	// Offsets (from data) of the strings, followed by one past the last string,
+	// see dmi_structure_index::strings. NULL when unknown, strings are then looked up linearly
+	const u32* strings;
+	u16 stringcount;
 };
 
 enum cpuid_type
@@ -306,47 +790,10 @@ enum cpuid_type
 
 // Forward declarations
 
-extern enum cpuid_type cpuid_type;
-struct u64;
-
 int is_printable(const u8* data, int len);
 const char* dmi_string(const struct dmi_header* dm, u8 s);
 void dmi_print_memory_size(const char* addr, u64 code, int shift);
-void dmi_print_cpuid(void (*print_cb)(const char* name, const char* format, ...),
+void dmi_print_cpuid(struct br_context* context, void (*print_cb)(const char* name, const char* format, ...),
 	const char* label, enum cpuid_type sig, const u8* p);
-static int smbios3_decode(u8* buf, const char* devmem, u32 flags);
-static void dmi_table_decode(u8* buf, u32 len, u16 num, u16 ver, u32 flags);
-static void ashwamegha_run();
-
-#ifdef BR_MAC_PLATFORM
-// Type to mean any instance of a property list type;
-// CFString, CFData, CFNumber, CFBoolean, CFDate, CFArray, and CFDictionary.
-// And if that is not enough, we may have to deal with NSString and whatnot
-enum MacPropertyDataTypes
-{
-	NumberType = 0,
-	StringType,
-	BooleanType,
-	DataType,
-	ArrayType,
-	NSStringType
-};
-
-static void mac_device_service_gauger();
-static mach_port_t macPort;
-#endif
-
-/////////////////////////////////////////////////////////////////////////////////////////////
-// Helpers!
-/////////////////////////////////////////////////////////////////////////////////////////////
-static void copy_to_structure_char(char** destinationPointer, const char* sourcePointer);
-static void generate_multiline_buffer(char* const bufferHandle, char* const lineTextToEmbed, const char junctionCondition);
-static void append_to_structure_char(char** destinationPointer, const char* sourcePointer, const char junctionCondition);
-static void copy_to_already_initialized_structure_char(char** destinationPointer, const char* sourcePointer);
-
-// Metric system for electronicssss
-static const char* memoUnit[8] = {
-		"bytes", "kB", "MB", "GB", "TB", "PB", "EB", "ZB"
-};
 
 #endif
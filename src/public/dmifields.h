@@ -0,0 +1,95 @@
+/*
+ *   ----------------------------
+ *  |  dmifields.h
+ *   ----------------------------
+ *   This file is part of BiosReader.
+ *
+ *   BiosReader is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   BiosReader is distributed in the hope and belief that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with BiosReader.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+/*
+ * Where the fields are in the formatted area of their structure, by the sections of the spec,
+ * and how wide the numbers are. Those both dmi_decode() and the projection (see dmiprojection.c)
+ * go by: the one decoding them and the other reading them raw, they have to agree.
+ */
+
+// Widths of the numbers, little endian all of them
+#define DMI_BYTE                            1
+#define DMI_WORD                            2
+#define DMI_DWORD                           4
+#define DMI_QWORD                           8
+
+// 7.1 BIOS Information
+#define DMI_BIOS_VENDOR                     0x04
+#define DMI_BIOS_VERSION                    0x05
+#define DMI_BIOS_RELEASE_DATE               0x08
+
+// 7.2 System Information
+#define DMI_SYSTEM_MANUFACTURER             0x04
+#define DMI_SYSTEM_PRODUCT_NAME             0x05
+#define DMI_SYSTEM_VERSION                  0x06
+#define DMI_SYSTEM_SERIAL_NUMBER            0x07
+#define DMI_SYSTEM_SKU_NUMBER               0x19
+#define DMI_SYSTEM_FAMILY                   0x1A
+
+// 7.3 Baseboard (or Module) Information
+#define DMI_BASE_BOARD_MANUFACTURER         0x04
+#define DMI_BASE_BOARD_PRODUCT_NAME         0x05
+#define DMI_BASE_BOARD_VERSION              0x06
+#define DMI_BASE_BOARD_SERIAL_NUMBER        0x07
+#define DMI_BASE_BOARD_ASSET_TAG            0x08
+
+// 7.4 System Enclosure or Chassis
+#define DMI_CHASSIS_MANUFACTURER            0x04
+#define DMI_CHASSIS_TYPE                    0x05
+#define DMI_CHASSIS_TYPE_WIDTH              DMI_BYTE
+#define DMI_CHASSIS_TYPE_MASK               0x7F // the top bit is the lock
+#define DMI_CHASSIS_VERSION                 0x06
+#define DMI_CHASSIS_SERIAL_NUMBER           0x07
+#define DMI_CHASSIS_ASSET_TAG               0x08
+
+// 7.5 Processor Information
+#define DMI_PROCESSOR_SOCKET_DESIGNATION    0x04
+#define DMI_PROCESSOR_FAMILY                0x06
+#define DMI_PROCESSOR_FAMILY_WIDTH          DMI_BYTE
+#define DMI_PROCESSOR_MANUFACTURER          0x07
+#define DMI_PROCESSOR_VERSION               0x10
+#define DMI_PROCESSOR_CURRENT_SPEED         0x16 // MHz
+#define DMI_PROCESSOR_CURRENT_SPEED_WIDTH   DMI_WORD
+#define DMI_PROCESSOR_SERIAL_NUMBER         0x20
+#define DMI_PROCESSOR_ASSET_TAG             0x21
+#define DMI_PROCESSOR_PART_NUMBER           0x22
+#define DMI_PROCESSOR_CORE_COUNT            0x23
+#define DMI_PROCESSOR_CORE_COUNT_WIDTH      DMI_BYTE
+#define DMI_PROCESSOR_THREAD_COUNT          0x25
+#define DMI_PROCESSOR_THREAD_COUNT_WIDTH    DMI_BYTE
+
+// 7.18 Memory Device
+#define DMI_MEMORY_DEVICE_SIZE              0x0C // MB, or kB with the top bit set
+#define DMI_MEMORY_DEVICE_SIZE_WIDTH        DMI_WORD
+#define DMI_MEMORY_DEVICE_LOCATOR           0x10
+#define DMI_MEMORY_DEVICE_BANK_LOCATOR      0x11
+#define DMI_MEMORY_DEVICE_SPEED             0x15 // MT/s
+#define DMI_MEMORY_DEVICE_SPEED_WIDTH       DMI_WORD
+#define DMI_MEMORY_DEVICE_MANUFACTURER      0x17
+#define DMI_MEMORY_DEVICE_SERIAL_NUMBER     0x18
+#define DMI_MEMORY_DEVICE_ASSET_TAG         0x19
+#define DMI_MEMORY_DEVICE_PART_NUMBER       0x1A
+#define DMI_MEMORY_DEVICE_EXTENDED_SIZE     0x1C // MB
+#define DMI_MEMORY_DEVICE_EXTENDED_SIZE_WIDTH DMI_DWORD
+#define DMI_MEMORY_DEVICE_EXTENDED_SIZE_MASK 0x7FFFFFFF // the top bit is reserved
+#define DMI_MEMORY_DEVICE_CONFIGURED_SPEED  0x20 // MT/s
+#define DMI_MEMORY_DEVICE_CONFIGURED_SPEED_WIDTH DMI_WORD
@@ -0,0 +1,85 @@
+/*
+ *   ----------------------------
+ *  |  dmiindex.h
+ *   ----------------------------
+ *   This file is part of BiosReader.
+ *
+ *   BiosReader is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   BiosReader is distributed in the hope and belief that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with BiosReader.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "types.h"
+
+/*
+ * One SMBIOS structure as found by the table walk. Offsets are relative to the
+ * start of the table buffer, so the index stays meaningful only as long as that
+ * buffer (or mapping) lives.
+ * https://github.com/ravimohan1991/BiosReader/wiki/Demystifying-the-RAW-BIOS-information
+ */
+struct dmi_structure_entry
+{
+	u8 type;
+	u8 length; // of the formatted area
+	u16 handle;
+	u32 offset; // formatted area, header included
+	u32 stringoffset; // string-set, right after the formatted area
+	u16 stringcount; // number of strings in the string-set
+	u32 firststring; // into dmi_structure_index::strings, DMI_NO_STRING_TABLE if unknown
+	u32 ordinal; // among the structures of its type, in table order
+};
+
+#define DMI_NO_STRING_TABLE 0xFFFFFFFF
+
+/*
+ * The whole table, walked once. Decoding passes and later queries iterate over
+ * the entries instead of hunting for the double-NUL terminators all over again.
+ */
+struct dmi_structure_index
+{
+	struct dmi_structure_entry* entries;
+	u32 count;
+	u32 capacity;
+
+	// Exact number of structures of each type, and the entries grouped by type
+	// (bytype[typefirst[t]] ... bytype[typefirst[t] + typecount[t] - 1])
+	u32 typecount[256];
+	u32 typefirst[256];
+	u32* bytype;
+
+	// Per structure, offset (from the start of the structure) of every string in the
+	// string-set followed by one past the terminating NUL of the last string. So string
+	// s (1 based) starts at strings[firststring + s - 1] and ends right before the next one
+	u32* strings;
+	u32 stringsused;
+	u32 stringscapacity;
+
+	// Handle to entry, open addressing with linear probing. A slot holds the position of the
+	// entry plus one, 0 being empty, and the table (1 << handlebits slots) is at most half full
+	u32* byhandle;
+	u32 handlebits;
+
+	u32 decoded; // structures walked, in the sense of the announced structure count
+	unsigned long consumed; // bytes the walk went through
+
+	int btruncated; // last entry doesn't fit in the table
+	int bbroken; // walk stopped at an entry shorter than a header
+	u8 brokenlength;
+};
+
+int dmi_index_build(struct dmi_structure_index* index, const u8* buf, u32 len, u16 num, int bStopAtEndOfTable);
+const u32* dmi_index_of_type(const struct dmi_structure_index* index, u8 type, u32* count);
+const struct dmi_structure_entry* dmi_index_of_handle(const struct dmi_structure_index* index, u16 handle);
+void dmi_index_clear(struct dmi_structure_index* index);
+void dmi_index_release(struct dmi_structure_index* index);
@@ -20,7 +20,31 @@
 
 #pragma once
 
+#include "dmidecode.h"
+
 struct dmi_header;
 
-void dmi_set_vendor(const char* s, const char* p);
-int dmi_decode_oem(const struct dmi_header* h);
+enum DMI_VENDORS
+{
+	VENDOR_UNKNOWN,
+	VENDOR_ACER,
+	VENDOR_HP,
+	VENDOR_HPE,
+	VENDOR_IBM,
+	VENDOR_LENOVO,
+};
+
+/*
+ * What vendor-specific decodes need to know, as remembered by the first pass
+ * over the table. One per decode context, see struct br_context.
+ */
+struct dmi_oem_state
+{
+	enum DMI_VENDORS vendor;
+	const char* product; // points into the table
+	enum cpuid_type cpuid_type; // for HPE type 199
+	u8 nic_ctr; // artificial NIC ids, see dmi_print_hp_net_iface_rec()
+};
+
+void dmi_set_vendor(struct dmi_oem_state* state, const char* s, const char* p);
+int dmi_decode_oem(struct dmi_oem_state* state, const struct dmi_header* h);
@@ -30,6 +30,10 @@ struct string_keyword
 	u8 offset;
 };
 
+// What can be set in opt.flags (same bits as dmidecode's, for those present)
+#define FLAG_QUIET              (1 << 3) // no "SMBIOS x.y present." and the like on stdout
+#define FLAG_FROM_DUMP          (1 << 5) // devmem is a file written by write_dump()
+
 struct opt
 {
 	const char *devmem;
@@ -38,5 +42,4 @@ struct opt
 	const struct string_keyword *string;
 	char *dumpfile;
 	u32 handle;
-};
-extern struct opt opt;
\ No newline at end of file
+};
\ No newline at end of file
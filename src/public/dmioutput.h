@@ -24,13 +24,124 @@
 #include "dmidecode.h"
 
 
+#include <stdarg.h>
+#include <stdio.h>
+
+#if defined(_MSC_VER)
+#define BR_THREAD_LOCAL __declspec(thread)
+#else
+#define BR_THREAD_LOCAL __thread
+#endif
+
+/**********************************************************
+ * Where the pr_* functions go: a sink, chosen per context
+ * at runtime (see br_context_set_output_sink()). No sink
+ * (NULL) is the default, and then the decoder doesn't so
+ * much as format an attribute.
+ *
+ * A sink is a table of handlers, one per pr_* function,
+ * with the va_list of the arguments. Handlers left NULL
+ * are skipped. Sinks are used by one decode at a time.
+ *
+ **********************************************************
+ */
+
+struct br_output_sink
+{
+	void (*document_start)(void *userdata);
+	void (*document_end)(void *userdata);
+	void (*comment)(void *userdata, const char *format, va_list args);
+	void (*info)(void *userdata, const char *format, va_list args);
+	void (*handle)(void *userdata, const struct dmi_header *h);
+	void (*handle_name)(void *userdata, const char *format, va_list args);
+	void (*attr)(void *userdata, const char *name, const char *format, va_list args);
+	void (*subattr)(void *userdata, const char *name, const char *format, va_list args);
+	void (*list_start)(void *userdata, const char *name, const char *format, va_list args); // format may be NULL
+	void (*list_item)(void *userdata, const char *format, va_list args);
+	void (*list_end)(void *userdata);
+	void (*sep)(void *userdata);
+	void (*struct_err)(void *userdata, const char *format, va_list args);
+
+	void (*release)(struct br_output_sink *sink); // see br_output_sink_destroy(), may be NULL
+	void *userdata;
+};
+
+/*
+ * dmidecode's tab indented listing, on stdout. Stateless, shared
+ * by everybody, and never to be destroyed.
+ */
+const struct br_output_sink *br_text_output_sink(void);
+
+/*
+ * A JSON document per decode run, of the form
+ *
+ * { "messages": [ "...", ... ],
+ *   "structures": [ { "handle": 4, "type": 0, "length": 26,
+ *       "name": "BIOS Information",
+ *       "attributes": { "Vendor": "...",
+ *           "Characteristics": [ "...", ... ],
+ *           "Installable Languages": { "value": "2",
+ *               "items": [ "...", ... ] } } },
+ *     ... ] }
+ *
+ * held back in memory and written to stream (stdout if NULL) in
+ * one go at the end of the run. NULL if out of memory.
+ */
+struct br_output_sink *br_json_output_sink_create(FILE *stream);
+
+/*
+ * Every pr_* call, formatted, handed to callback. name is that of
+ * the attribute or list (NULL otherwise), value the formatted rest
+ * (NULL if there is none), h is there for BR_OUTPUT_HANDLE only.
+ * NULL if out of memory.
+ */
+enum br_output_event
+{
+	BR_OUTPUT_DOCUMENT_START,
+	BR_OUTPUT_DOCUMENT_END,
+	BR_OUTPUT_COMMENT,
+	BR_OUTPUT_INFO,
+	BR_OUTPUT_HANDLE,
+	BR_OUTPUT_HANDLE_NAME,
+	BR_OUTPUT_ATTRIBUTE,
+	BR_OUTPUT_SUBATTRIBUTE,
+	BR_OUTPUT_LIST_START,
+	BR_OUTPUT_LIST_ITEM,
+	BR_OUTPUT_LIST_END,
+	BR_OUTPUT_SEPARATOR,
+	BR_OUTPUT_STRUCTURE_ERROR
+};
+
+typedef void (*br_output_callback)(enum br_output_event event, const char *name, const char *value,
+	const struct dmi_header *h, void *userdata);
+
+struct br_output_sink *br_callback_output_sink_create(br_output_callback callback, void *userdata);
+
+// Lets go of a sink made by one of the above, NULL and the text sink are fine
+void br_output_sink_destroy(struct br_output_sink *sink);
+
+/*
+ * The sink of the decode running on this thread, bound by br_decode()
+ * for the duration. pr_bind_sink() returns the one it replaces.
+ */
+extern BR_THREAD_LOCAL const struct br_output_sink *currentOutputSink;
+
+const struct br_output_sink *pr_bind_sink(const struct br_output_sink *sink);
+
+// Is anybody listening? Everything to be displayed is behind this
+#define bDisplayOutput (currentOutputSink != NULL)
+
 /**********************************************************
  * Generic output functions needing careful tending since
  * dealing with output messages on console or applications.
+ * pr_document_start() and pr_document_end() bracket a
+ * decode run.
  *
  **********************************************************
  */
 
+void pr_document_start(void);
+void pr_document_end(void);
 void pr_comment(const char *format, ...);
 void pr_info(const char *format, ...);
 void pr_handle(const struct dmi_header *h);
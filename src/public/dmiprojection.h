@@ -0,0 +1,91 @@
+/*
+ *   ----------------------------
+ *  |  dmiprojection.h
+ *   ----------------------------
+ *   This file is part of BiosReader.
+ *
+ *   BiosReader is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   BiosReader is distributed in the hope and belief that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with BiosReader.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "types.h"
+
+/*
+ * A field of an SMBIOS structure, shaped after dmiopt.h's string_keyword: the type of the
+ * structure and the offset of the field in its formatted area (those of the spec, which
+ * dmi_decode() goes by). Either a string, the byte at offset being its number in the
+ * string-set, or a little endian number of width bytes, of which only the bits of mask
+ * are the field when there are others (the lock of the chassis type, say).
+ */
+#define BR_FIELD_STRING 0
+
+struct br_projection_field
+{
+	const char* keyword;
+	u8 type;
+	u8 offset;
+	u8 width; // BR_FIELD_STRING, or DMI_BYTE to DMI_QWORD of dmifields.h
+	unsigned long long mask; // 0 for the whole number
+};
+
+/*
+ * The field out of one structure. bPresent is 0 when the structure is too short to have it
+ * (or the string number is 0, or past the string-set), string and number are then NULL and 0.
+ * Strings point into the table as the firmware has it, till the context is reset.
+ */
+struct br_projection_value
+{
+	const struct br_projection_field* field;
+	unsigned int handle;
+	int bPresent;
+	const char* string;
+	unsigned long long number;
+};
+
+struct br_context;
+
+/*
+ *************************************************************************************************
+ *
+ * Just the fields asked for, straight out of the table: the structures of each type are found
+ * through the index of the table walk, and nothing is decoded, formatted or allocated beyond
+ * the walk itself. The values come field by field, and for a field one per structure of its
+ * type, in table order.
+ *
+ * The table has to be at hand: a fresh context keeps off the on-disk cache (see
+ * br_context_use_cache()) for its first run, and one whose inventory came out of the cache
+ * has the table read and walked on the first projection, nothing being decoded either way.
+ *
+ * @param context           The context
+ * @param fields            What is wanted
+ * @param fieldCount        How many of them
+ * @param values            Filled up with as many values as fit
+ * @param capacity          Room in values
+ * @return unsigned int     How many values there are, like snprintf() does
+ *
+ *************************************************************************************************
+ */
+
+unsigned int br_project(struct br_context* context, const struct br_projection_field* fields, unsigned int fieldCount,
+	struct br_projection_value* values, unsigned int capacity);
+
+/*
+ * The fields dmidecode's -s knows (bios-vendor, system-serial-number and so on, same names, but
+ * for the revisions and the UUID which aren't a field each), plus a few more of the processors
+ * and those of the memory devices (memory-device-part-number and the like). NULL for a keyword
+ * of none.
+ */
+const struct br_projection_field* br_projection_field_of(const char* keyword);
+const struct br_projection_field* br_projection_keywords(unsigned int* count);
@@ -0,0 +1,35 @@
+/*
+ *   ----------------------------
+ *  |  dmiscan.h
+ *   ----------------------------
+ *   This file is part of BiosReader.
+ *
+ *   BiosReader is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   BiosReader is distributed in the hope and belief that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with BiosReader.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "types.h"
+
+/*
+ * Finds the double-NUL which terminates the string-set of an SMBIOS structure,
+ * searching [p, limit). Returns the position of the first of the two NULs, or
+ * limit - 1 (never less than p) when there is none, just like the byte at a
+ * time loop
+ *
+ *     while (p + 1 < limit && (p[0] != 0 || p[1] != 0)) p++;
+ *
+ * The search runs 16 (SSE2) or 32 (AVX2) bytes at a time where the processor allows.
+ */
+const u8* dmi_find_double_nul(const u8* p, const u8* limit);
@@ -0,0 +1,134 @@
+/*
+ *   ----------------------------
+ *  |  dmiwalk.h
+ *   ----------------------------
+ *   This file is part of BiosReader.
+ *
+ *   BiosReader is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   BiosReader is distributed in the hope and belief that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with BiosReader.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+#include "types.h"
+
+/*
+ * The SMBIOS types a walk stops at, a bit each. Start from BR_TYPE_MASK_NONE and add types
+ * with br_type_mask_add(), or start from BR_TYPE_MASK_ALL.
+ */
+struct br_type_mask
+{
+	u32 bits[8];
+};
+
+#define BR_TYPE_MASK_NONE { { 0, 0, 0, 0, 0, 0, 0, 0 } }
+#define BR_TYPE_MASK_ALL { { ~0u, ~0u, ~0u, ~0u, ~0u, ~0u, ~0u, ~0u } }
+
+static inline void br_type_mask_add(struct br_type_mask* mask, u8 type)
+{
+	mask->bits[type >> 5] |= 1u << (type & 31);
+}
+
+static inline int br_type_mask_has(const struct br_type_mask* mask, u8 type)
+{
+	return (mask->bits[type >> 5] >> (type & 31)) & 1;
+}
+
+struct dmi_header;
+struct br_context;
+
+/*
+ * Where a pull over the structures of a context is at, see br_cursor_next()
+ */
+struct br_cursor
+{
+	struct br_context* context;
+	u32 next; // into the index of the table walk
+};
+
+/*
+ *************************************************************************************************
+ *
+ * The structures of a context, one at a time, in table order, up to the end-of-table marker:
+ *
+ *   struct br_cursor cursor;
+ *   struct dmi_header h;
+ *
+ *   br_cursor_begin(context, &cursor);
+ *   while (br_cursor_next(&cursor, &h))
+ *   {
+ *       ...
+ *   }
+ *
+ * A header is a view of the structure where the table has it (type, handle, the formatted area
+ * as data and length, the string-set through br_walk_string_span()), nothing is copied, and it
+ * stays good till the context is reset. The formatted area of a structure running off the end
+ * of the table is cut short at the end. The table has to be at hand, as for br_project().
+ *
+ * br_cursor_begin()        0 if there is no table to be had (the cursor then yields nothing),
+ *                          1 otherwise
+ * br_cursor_next()         1 with h filled up, 0 past the last structure
+ *
+ *************************************************************************************************
+ */
+
+int br_cursor_begin(struct br_context* context, struct br_cursor* cursor);
+int br_cursor_next(struct br_cursor* cursor, struct dmi_header* h);
+
+/*
+ * Called for each structure of the walk, with the structure as the firmware has it (see
+ * to_dmi_header()): nothing is copied, and the header is good only for the call. Return 0 to
+ * go on with the walk, anything else to stop it there.
+ */
+typedef int (*br_walk_function)(const struct dmi_header* h, void* userdata);
+
+/*
+ *************************************************************************************************
+ *
+ * Hand the structures of the types in the mask to a callback, as br_cursor_next() yields
+ * them. The structures come out of the index of the table walk, so nothing is
+ * decoded, formatted or allocated beyond the walk itself, and the records of the context are
+ * left alone. The table has to be at hand, as for br_project().
+ *
+ * @param context           The context
+ * @param mask              The types wanted
+ * @param walk              Gets the structures
+ * @param userdata          Handed to walk
+ * @return unsigned int     How many structures walk was handed
+ *
+ *************************************************************************************************
+ */
+
+unsigned int br_walk(struct br_context* context, const struct br_type_mask* mask, br_walk_function walk, void* userdata);
+
+/*
+ *************************************************************************************************
+ *
+ * The fields of a structure handed to a walk, offsets being those of the spec.
+ *
+ * br_walk_string()             The string whose number is the byte at offset, NULL if the
+ *                              structure is too short to have it, or the number is 0 or past
+ *                              the string-set. Good till the context is reset
+ * br_walk_string_span()        Same, and its length (without the NUL) in length, 0 for none
+ * br_walk_number()             The little endian number of width (1, 2, 4 or 8) bytes at
+ *                              offset, 0 if the structure is too short to have it (and then
+ *                              bPresent, when asked for, is 0 too)
+ *
+ *************************************************************************************************
+ */
+
+const char* br_walk_string(const struct dmi_header* h, u8 offset);
+const char* br_walk_string_span(const struct dmi_header* h, u8 offset, size_t* length);
+unsigned long long br_walk_number(const struct dmi_header* h, u8 offset, u8 width, int* bPresent);
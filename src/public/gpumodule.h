@@ -0,0 +1,55 @@
+/*
+ *   ----------------------------
+ *  |  gpumodule.h
+ *   ----------------------------
+ *   This file is part of BiosReader.
+ *
+ *   BiosReader is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   BiosReader is distributed in the hope and belief that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with BiosReader.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+/*
+ * The contract between BiosReader (the core library) and the optional GL module
+ * (BiosReaderGL, see src/modules/gpugl.c). The core never links against OpenGL,
+ * the module is loaded the first time a graphics card is asked about (and the kernel
+ * can't tell), and only if it is around: in the directory of the binary holding
+ * BiosReader (libBiosReader, or the executable it is linked into), else wherever
+ * the dynamic loader looks.
+ */
+
+// File name of the module, as the build produced it (overridable by the build)
+#ifndef BR_GPU_MODULE_NAME
+#if defined(BR_WINDOWS_PLATFORM)
+#define BR_GPU_MODULE_NAME "BiosReaderGL.dll"
+#else
+#define BR_GPU_MODULE_NAME "libBiosReaderGL.so"
+#endif
+#endif
+
+// The one routine the module exports
+#define BR_GPU_MODULE_ENTRY "br_gpu_module_probe"
+
+struct gpu_module_device
+{
+	char vendor[64];
+	char renderer[64];
+	long long videomemorymb; // 0 when the driver doesn't say (NVX_gpu_memory_info is NVIDIA's)
+};
+
+/*
+ * Fills up the device with whatever the current GL context says.
+ * Returns 0 on success, non zero when there is no GL (or context) to speak of.
+ */
+typedef int (*gpu_module_probe_function)(struct gpu_module_device* device);
@@ -0,0 +1,43 @@
+/*
+ *   ----------------------------
+ *  |  gpuprovider.h
+ *   ----------------------------
+ *   This file is part of BiosReader.
+ *
+ *   BiosReader is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   BiosReader is distributed in the hope and belief that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with BiosReader.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// More than enough for any box I have seen
+#define BR_MAX_GPUS 16
+
+/*
+ * A display adapter as the kernel sees it. No GL context (or any library for that
+ * matter) is needed to find these.
+ */
+struct gpu_provider_device
+{
+	unsigned int vendorid; // PCI vendor ID, 0x10DE for NVIDIA and the like
+	unsigned int deviceid; // PCI device ID
+	unsigned long long vrambytes; // 0 when the driver doesn't say
+	char driver[32]; // kernel driver bound to the device, "amdgpu", "i915", ...
+	char slot[32]; // PCI slot, "0000:03:00.0"
+};
+
+struct gpu_module_device;
+
+int gpu_provider_enumerate(struct gpu_provider_device* devices, int maxDevices);
+const char* gpu_provider_vendor_name(unsigned int vendorid);
+int gpu_provider_probe_module(struct gpu_module_device* device);
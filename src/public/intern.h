@@ -0,0 +1,47 @@
+/*
+ *   ----------------------------
+ *  |  intern.h
+ *   ----------------------------
+ *   This file is part of BiosReader.
+ *
+ *   BiosReader is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   BiosReader is distributed in the hope and belief that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with BiosReader.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "arena.h"
+#include "types.h"
+
+/*
+ * Every distinct string of a decode, once. Equal strings come out as the same pointer and
+ * the same id (1 based, in order of first appearance, 0 meaning not interned), so that
+ * grouping records by one of their strings is a matter of comparing integers.
+ */
+struct br_intern_pool
+{
+	const char** strings; // by id - 1
+	u32 count;
+	u32 capacity;
+
+	// Open addressing with linear probing over the hash of the string. A slot holds the id,
+	// 0 being empty, and the table (1 << slotbits slots) is at most half full
+	u32* slots;
+	u32 slotbits;
+};
+
+const char* br_intern(struct br_intern_pool* pool, struct br_arena* arena, const char* string);
+u32 br_intern_id(const struct br_intern_pool* pool, const char* string);
+const char* br_intern_string(const struct br_intern_pool* pool, u32 id);
+void br_intern_clear(struct br_intern_pool* pool);
+void br_intern_release(struct br_intern_pool* pool);
@@ -23,6 +23,15 @@
 
 #include "config.h"
 
+// BiosReader's build (and whoever builds against BiosReader::core) says which, the compiler tells otherwise
+#if !defined(BR_BIG_ENDIAN) && !defined(BR_LITTLE_ENDIAN)
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define BR_BIG_ENDIAN
+#elif (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) || defined(_WIN32)
+#define BR_LITTLE_ENDIAN
+#endif
+#endif
+
 typedef unsigned char u8;
 typedef unsigned short u16;
 typedef signed short i16;
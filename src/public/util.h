@@ -26,8 +26,22 @@
 
 #define ARRAY_SIZE(x) (sizeof(x)/sizeof((x)[0]))
 
+/*
+ * A private, read-only in spirit, view of a file obtained with map_file()
+ */
+struct file_mapping
+{
+	void *base; // what mmap() handed out (page aligned)
+	size_t length; // bytes mapped from base
+};
+
 int checksum(const u8 *buf, size_t len);
 void *read_file(off_t base, size_t *len, const char *filename, int* file_access);
+void *read_file_into(off_t base, size_t *len, const char *filename, u8 *buffer, int* file_access);
+void *read_user_file(off_t base, size_t *len, const char *filename, u8 *buffer, int* file_access);
+u8 *map_file(off_t base, size_t *len, const char *filename, struct file_mapping *mapping);
+u8 *map_descriptor(int fd, off_t base, size_t *len, struct file_mapping *mapping);
+void unmap_file(struct file_mapping *mapping);
 void *mem_chunk(off_t base, size_t len, const char *devmem);
 int write_dump(size_t base, size_t len, const void *data, const char *dumpfile, int add);
 u64 u64_range(u64 start, u64 end);
@@ -0,0 +1,160 @@
+/*
+ *   ----------------------------
+ *  |  allocations.c
+ *   ----------------------------
+ *   This file is part of BiosReader.
+ *
+ *   BiosReader is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   BiosReader is distributed in the hope and belief that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with BiosReader.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * A context decodes a table, is reset and decodes it again: the second time round everything
+ * comes out of the arena and the index kept from the first (see arena.h), so the heap isn't
+ * touched at all. malloc(), calloc() and realloc() are counted by standing in for glibc's.
+ *
+ *   BiosReaderAllocations <scratch dump path>
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "dmidecode.h"
+#include "dmicolumns.h"
+
+#include "synthdump.h"
+
+extern void* __libc_malloc(size_t size);
+extern void* __libc_calloc(size_t count, size_t size);
+extern void* __libc_realloc(void* pointer, size_t size);
+
+static int bCounting;
+static unsigned long allocations;
+
+void* malloc(size_t size)
+{
+	allocations += bCounting;
+	return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size)
+{
+	allocations += bCounting;
+	return __libc_calloc(count, size);
+}
+
+void* realloc(void* pointer, size_t size)
+{
+	allocations += bCounting;
+	return __libc_realloc(pointer, size);
+}
+
+/*
+ * Everything out of the table (the graphics cards aren't), returns how many records came of it
+ */
+static unsigned int decode_everything(struct br_context* context)
+{
+	static const enum bios_reader_information_classification categories[] = {
+		ss_bios, ps_processor, pi_bioslanguages, pi_systemmemory, ps_systemmemory, pi_manufacturer, ps_motherboard, ps_chassis
+	};
+	unsigned int records = 0;
+
+	for (size_t c = 0; c < sizeof(categories) / sizeof(categories[0]); c++)
+	{
+		br_decode(context, categories[c]);
+	}
+
+	for (unsigned int i = 0; br_fetch_processor(context, i) != NULL; i++, records++);
+	for (unsigned int i = 0; br_fetch_memory_array(context, i) != NULL; i++, records++);
+	for (unsigned int i = 0; br_fetch_memory_device(context, i) != NULL; i++, records++);
+	for (unsigned int i = 0; br_fetch_system(context, i) != NULL; i++, records++);
+	for (unsigned int i = 0; br_fetch_base_board(context, i) != NULL; i++, records++);
+	for (unsigned int i = 0; br_fetch_chassis(context, i) != NULL; i++, records++);
+
+	if (br_memory_device_columns(context) == NULL)
+	{
+		return 0;
+	}
+
+	return records;
+}
+
+int main(int argc, char** argv)
+{
+	struct synthetic_dump dump;
+	struct br_context* context;
+	const struct bios_information* bios;
+	unsigned int firstRecords;
+	unsigned int secondRecords;
+	unsigned long firstAllocations;
+	unsigned long secondAllocations;
+
+	if (argc != 2)
+	{
+		fprintf(stderr, "Usage: %s <scratch dump path>\n", argv[0]);
+		return 2;
+	}
+
+	synthetic_dump_begin(&dump);
+	synthetic_dump_add_machine(&dump, 2, 8);
+	if (synthetic_dump_write(&dump, argv[1]) != 0)
+	{
+		fprintf(stderr, "%s: can't be written\n", argv[1]);
+		return 2;
+	}
+	synthetic_dump_release(&dump);
+
+	context = br_context_create();
+	br_context_use_cache(context, 0);
+	br_context_set_dump_file(context, argv[1]);
+
+	bCounting = 1;
+	firstRecords = decode_everything(context);
+	firstAllocations = allocations;
+
+	allocations = 0;
+	br_context_reset(context);
+	secondRecords = decode_everything(context);
+	bCounting = 0;
+	secondAllocations = allocations;
+
+	bios = br_decode(context, ss_bios);
+
+	printf("%u records with %lu allocations, then %u after the reset with %lu allocations\n",
+		firstRecords, firstAllocations, secondRecords, secondAllocations);
+
+	// Nothing counted at all would mean the allocator wasn't stood in for
+	if (firstAllocations == 0)
+	{
+		fprintf(stderr, "FAILED: no allocation counted for the first decode\n");
+		return 1;
+	}
+
+	if (firstRecords != 2 + 1 + 8 + 1 + 1 + 1 || secondRecords != firstRecords
+		|| bios->vendor == NULL || strcmp(bios->vendor, "American Megatrends Inc.") != 0)
+	{
+		fprintf(stderr, "FAILED: the second decode doesn't match the first\n");
+		return 1;
+	}
+
+	if (secondAllocations != 0)
+	{
+		fprintf(stderr, "FAILED: %lu heap allocations decoding after the reset\n", secondAllocations);
+		return 1;
+	}
+
+	br_context_destroy(context);
+
+	return 0;
+}
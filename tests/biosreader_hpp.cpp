@@ -0,0 +1,62 @@
+/*
+ *   ----------------------------
+ *  |  biosreader_hpp.cpp
+ *   ----------------------------
+ *   This file is part of BiosReader.
+ *
+ *   BiosReader is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   BiosReader is distributed in the hope and belief that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with BiosReader.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Compiled (and linked) only, never run: every part of biosreader.hpp put to use once, so that
+ * the header keeps building on its own, warning free, for the applications.
+ */
+
+#include "biosreader.hpp"
+
+#include <cstdio>
+
+int main(int argc, char** argv)
+{
+	bios::Table table;
+	unsigned long long installed = 0;
+
+	if (argc > 1)
+	{
+		table.set_dump_file(argv[1]);
+	}
+	table.use_cache(false);
+
+	for (const bios::Structure& device : table.structures() | bios::by_type(17))
+	{
+		std::string_view partNumber = device.string(0x1A);
+		std::optional<std::uint16_t> speed = device.number<std::uint16_t>(0x15);
+
+		std::printf("%04X %.*s %u\n", device.handle(), static_cast<int>(partNumber.size()), partNumber.data(),
+			speed.value_or(0));
+	}
+
+	for (const random_access_memory& device : table.memory_devices())
+	{
+		installed += device.ramsizebytes;
+	}
+
+	std::printf("%s, %zu processors, %zu memory arrays, %llu bytes\n", table.bios().vendor != nullptr ? table.bios().vendor : "",
+		table.processors().size(), table.memory_arrays().size(), installed);
+
+	bios::Table other = std::move(table);
+	other.reset();
+
+	return other.get() != nullptr ? 0 : 1;
+}
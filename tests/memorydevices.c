@@ -0,0 +1,206 @@
+/*
+ *   ----------------------------
+ *  |  memorydevices.c
+ *   ----------------------------
+ *   This file is part of BiosReader.
+ *
+ *   BiosReader is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   BiosReader is distributed in the hope and belief that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with BiosReader.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * One memory array and memory devices of every length the decode stops at (and of odd ones in
+ * between): each device has to get its own record, in table order, whatever its length, and the
+ * columns and the count of the array have to follow.
+ *
+ *   BiosReaderMemoryDevices <scratch dump path>
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "dmidecode.h"
+#include "dmicolumns.h"
+
+#include "synthdump.h"
+
+// Whole structure lengths, header included. Below 0x15 there is no more than the handle to it
+static const unsigned char deviceLengths[] = {
+	0x0F, 0x15, 0x17, 0x1B, 0x1C, 0x1D, 0x22, 0x28, 0x2D, 0x34, 0x3C, 0x40, 0x43, 0x44, 0x4C, 0x4F, 0x54, 0x5C
+};
+
+#define DEVICE_COUNT (sizeof(deviceLengths) / sizeof(deviceLengths[0]))
+
+static void put_word(unsigned char* p, unsigned int value)
+{
+	p[0] = (unsigned char)value;
+	p[1] = (unsigned char)(value >> 8);
+}
+
+static void write_dump(const char* path)
+{
+	static const char* const deviceStrings[] = { NULL, "BANK 0", "Samsung", "SERIAL", "ASSET", "M393A2K43DB3-CWE" };
+	struct synthetic_dump dump;
+	unsigned char formatted[0x60];
+	char locator[16];
+
+	synthetic_dump_begin(&dump);
+
+	memset(formatted, 0, sizeof(formatted));
+	formatted[0x00] = 0x03; // system board
+	formatted[0x01] = 0x03; // system memory
+	formatted[0x02] = 0x03; // none
+	put_word(formatted + 0x03, 0x0000);
+	put_word(formatted + 0x05, 0x0400); // 64 GB
+	put_word(formatted + 0x07, 0xFFFE);
+	put_word(formatted + 0x09, (unsigned int)DEVICE_COUNT);
+	synthetic_dump_add(&dump, 16, 0x1000, formatted, 0x0B, NULL, 0);
+
+	for (unsigned int d = 0; d < DEVICE_COUNT; d++)
+	{
+		const char* strings[6];
+
+		memcpy(strings, deviceStrings, sizeof(strings));
+		snprintf(locator, sizeof(locator), "DIMM%u", d);
+		strings[0] = locator;
+
+		// Offsets of the formatted area, 4 short of those of the spec
+		memset(formatted, 0, sizeof(formatted));
+		put_word(formatted + 0x00, 0x1000);
+		put_word(formatted + 0x02, 0xFFFE);
+		put_word(formatted + 0x04, 64);
+		put_word(formatted + 0x06, 64);
+		put_word(formatted + 0x08, 16384); // MB
+		formatted[0x0A] = 0x09; // DIMM
+		formatted[0x0C] = 1;
+		formatted[0x0D] = 2;
+		formatted[0x0E] = 0x1A; // DDR4
+		put_word(formatted + 0x0F, 0x0080);
+		put_word(formatted + 0x11, 2666);
+		formatted[0x13] = 3;
+		formatted[0x14] = 4;
+		formatted[0x15] = 5;
+		formatted[0x16] = 6;
+		formatted[0x17] = 2;
+		put_word(formatted + 0x1C, 2666);
+		put_word(formatted + 0x1E, 1200);
+		put_word(formatted + 0x20, 1200);
+		put_word(formatted + 0x22, 1200);
+		formatted[0x24] = 0x03; // DRAM
+
+		synthetic_dump_add(&dump, 17, (unsigned short)(0x1100 + d), formatted, deviceLengths[d] - 4u, strings, 6);
+	}
+
+	if (synthetic_dump_write(&dump, path) != 0)
+	{
+		fprintf(stderr, "%s: can't be written\n", path);
+		synthetic_dump_release(&dump);
+		exit(2);
+	}
+
+	synthetic_dump_release(&dump);
+}
+
+int main(int argc, char** argv)
+{
+	struct br_context* context;
+	const struct br_memory_device_columns* columns;
+	const struct turing_machine_system_memory* array;
+	unsigned int located = 0;
+	int failures = 0;
+
+	if (argc != 2)
+	{
+		fprintf(stderr, "Usage: %s <scratch dump path>\n", argv[0]);
+		return 2;
+	}
+
+	write_dump(argv[1]);
+
+	context = br_context_create();
+	br_context_use_cache(context, 0);
+	br_context_set_dump_file(context, argv[1]);
+
+	for (unsigned int d = 0; d < DEVICE_COUNT; d++)
+	{
+		const struct random_access_memory* device = br_fetch_memory_device(context, d);
+		char locator[16];
+
+		snprintf(locator, sizeof(locator), "DIMM%u", d);
+
+		if (device == NULL || device->handle != 0x1100 + d)
+		{
+			fprintf(stderr, "FAILED: device %u (%u bytes) isn't the structure of handle 0x%04X\n", d, deviceLengths[d], 0x1100 + d);
+			failures++;
+			continue;
+		}
+
+		if (deviceLengths[d] < 0x15)
+		{
+			if (device->arrayhandle != 0xFFFF || device->locator != NULL)
+			{
+				fprintf(stderr, "FAILED: device %u (%u bytes) has fields it is too short for\n", d, deviceLengths[d]);
+				failures++;
+			}
+			continue;
+		}
+
+		located++;
+
+		if (device->arrayhandle != 0x1000 || device->locator == NULL || strcmp(device->locator, locator) != 0)
+		{
+			fprintf(stderr, "FAILED: device %u (%u bytes) has locator %s, array 0x%04X\n", d, deviceLengths[d],
+				device->locator != NULL ? device->locator : "(none)", device->arrayhandle);
+			failures++;
+		}
+	}
+
+	if (br_fetch_memory_device(context, DEVICE_COUNT) != NULL)
+	{
+		fprintf(stderr, "FAILED: more devices than structures\n");
+		failures++;
+	}
+
+	columns = br_memory_device_columns(context);
+	if (columns == NULL || columns->count != DEVICE_COUNT)
+	{
+		fprintf(stderr, "FAILED: %u device columns for %u structures\n", columns != NULL ? columns->count : 0, (unsigned int)DEVICE_COUNT);
+		failures++;
+	}
+	else
+	{
+		for (unsigned int d = 0; d < DEVICE_COUNT; d++)
+		{
+			if (columns->handles[d] != 0x1100 + d)
+			{
+				fprintf(stderr, "FAILED: device column %u has handle 0x%04X\n", d, columns->handles[d]);
+				failures++;
+			}
+		}
+	}
+
+	array = br_fetch_memory_array(context, 0);
+	if (array == NULL || array->number_of_ram_or_system_memory_devices != located)
+	{
+		fprintf(stderr, "FAILED: the array has %u devices, %u of them point to it\n",
+			array != NULL ? array->number_of_ram_or_system_memory_devices : 0, located);
+		failures++;
+	}
+
+	printf("%u memory devices, %u of them in the array, %d failures\n", (unsigned int)DEVICE_COUNT, located, failures);
+
+	br_context_destroy(context);
+
+	return failures != 0;
+}
@@ -0,0 +1,193 @@
+/*
+ *   ----------------------------
+ *  |  stringbench.c
+ *   ----------------------------
+ *   This file is part of BiosReader.
+ *
+ *   BiosReader is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   BiosReader is distributed in the hope and belief that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with BiosReader.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * The string lookup, adversarially: memory devices with up to 255 long strings each, every string
+ * field of them referring to the last ones of the string-set (a linear lookup's worst). Decode time
+ * is reported per byte of table for tables of growing size and structures of growing string count,
+ * so that it shows whether it stays flat (linear in the table) or not.
+ *
+ *   BiosReaderStringBench [scratch directory]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(BR_WINDOWS_PLATFORM)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#include "dmidecode.h"
+
+#include "synthdump.h"
+
+#define STRING_LENGTH 48
+#define REPETITIONS 5
+
+static double now_seconds()
+{
+#if defined(BR_WINDOWS_PLATFORM)
+	LARGE_INTEGER frequency;
+	LARGE_INTEGER counter;
+
+	QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&counter);
+
+	return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return now.tv_sec + now.tv_nsec / 1e9;
+#endif
+}
+
+/*
+ * A table of structureCount memory devices of stringCount strings each, returns its length
+ */
+static size_t write_dump(const char* path, unsigned int structureCount, unsigned int stringCount)
+{
+	static char strings[255][STRING_LENGTH + 1];
+	const char* stringPointers[255];
+	unsigned char formatted[0x24];
+	struct synthetic_dump dump;
+	size_t length;
+
+	for (unsigned int s = 0; s < stringCount; s++)
+	{
+		memset(strings[s], 'A' + s % 26, STRING_LENGTH);
+		snprintf(strings[s], STRING_LENGTH + 1, "String %u of the set", s + 1);
+		strings[s][strlen(strings[s])] = '-';
+		strings[s][STRING_LENGTH] = '\0';
+		stringPointers[s] = strings[s];
+	}
+
+	memset(formatted, 0, sizeof(formatted));
+	formatted[0x00] = 0x00; // array handle 0x1000
+	formatted[0x01] = 0x10;
+	formatted[0x02] = 0xFE;
+	formatted[0x03] = 0xFF;
+	formatted[0x08] = 0x00; // 16 GB
+	formatted[0x09] = 0x40;
+	formatted[0x0A] = 0x09; // DIMM
+	formatted[0x0E] = 0x1A; // DDR4
+
+	// Locator, bank locator, manufacturer, serial number, asset tag and part number, the last strings
+	formatted[0x0C] = (unsigned char)stringCount;
+	formatted[0x0D] = (unsigned char)(stringCount > 1 ? stringCount - 1 : 1);
+	formatted[0x13] = (unsigned char)(stringCount > 2 ? stringCount - 2 : 1);
+	formatted[0x14] = (unsigned char)(stringCount > 3 ? stringCount - 3 : 1);
+	formatted[0x15] = (unsigned char)(stringCount > 4 ? stringCount - 4 : 1);
+	formatted[0x16] = (unsigned char)(stringCount > 5 ? stringCount - 5 : 1);
+
+	synthetic_dump_begin(&dump);
+	for (unsigned int i = 0; i < structureCount; i++)
+	{
+		synthetic_dump_add(&dump, 17, (unsigned short)(0x1100 + i), formatted, sizeof(formatted), stringPointers, stringCount);
+	}
+
+	if (synthetic_dump_write(&dump, path) != 0)
+	{
+		fprintf(stderr, "%s: can't be written\n", path);
+		exit(2);
+	}
+
+	length = dump.length;
+	synthetic_dump_release(&dump);
+
+	return length;
+}
+
+/*
+ * Best of a few decodes of the memory devices, in seconds
+ */
+static double time_decode(struct br_context* context, const char* path, unsigned int structureCount)
+{
+	double best = 0;
+
+	br_context_set_dump_file(context, path);
+
+	for (int r = 0; r < REPETITIONS; r++)
+	{
+		double start;
+		double seconds;
+		const struct random_access_memory* device;
+
+		br_context_reset(context);
+
+		start = now_seconds();
+		br_decode(context, ps_systemmemory);
+		device = br_fetch_memory_device(context, structureCount - 1);
+		seconds = now_seconds() - start;
+
+		if (device == NULL || device->partnumber == NULL)
+		{
+			fprintf(stderr, "%s: the memory devices didn't decode\n", path);
+			exit(1);
+		}
+
+		if (r == 0 || seconds < best)
+		{
+			best = seconds;
+		}
+	}
+
+	return best;
+}
+
+int main(int argc, char** argv)
+{
+	static const unsigned int stringCounts[] = { 7, 63, 255 };
+	static const unsigned int structureCounts[] = { 64, 256, 1024 };
+	const char* directory = argc > 1 ? argv[1] : ".";
+	struct br_context* context = br_context_create();
+	char path[4096];
+
+	if (context == NULL)
+	{
+		fprintf(stderr, "Out of memory\n");
+		return 2;
+	}
+
+	snprintf(path, sizeof(path), "%s/stringbench.bin", directory);
+
+	printf("%8s %11s %12s %12s %9s %14s\n", "strings", "structures", "table bytes", "seconds", "ns/byte", "ns/structure");
+
+	for (size_t s = 0; s < sizeof(stringCounts) / sizeof(stringCounts[0]); s++)
+	{
+		for (size_t n = 0; n < sizeof(structureCounts) / sizeof(structureCounts[0]); n++)
+		{
+			size_t length = write_dump(path, structureCounts[n], stringCounts[s]);
+			double seconds = time_decode(context, path, structureCounts[n]);
+
+			printf("%8u %11u %12zu %12.6f %9.2f %14.1f\n", stringCounts[s], structureCounts[n], length, seconds,
+				seconds * 1e9 / length, seconds * 1e9 / structureCounts[n]);
+		}
+	}
+
+	br_context_destroy(context);
+	remove(path);
+
+	return 0;
+}
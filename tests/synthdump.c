@@ -0,0 +1,282 @@
+/*
+ *   ----------------------------
+ *  |  synthdump.c
+ *   ----------------------------
+ *   This file is part of BiosReader.
+ *
+ *   BiosReader is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   BiosReader is distributed in the hope and belief that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with BiosReader.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "synthdump.h"
+
+static void reserve(struct synthetic_dump* dump, size_t length)
+{
+	if (dump->length + length <= dump->capacity)
+	{
+		return;
+	}
+
+	while (dump->length + length > dump->capacity)
+	{
+		dump->capacity = dump->capacity ? dump->capacity * 2 : 4096;
+	}
+
+	dump->table = realloc(dump->table, dump->capacity);
+	if (dump->table == NULL)
+	{
+		fprintf(stderr, "Out of memory\n");
+		exit(2);
+	}
+}
+
+static void append(struct synthetic_dump* dump, const void* data, size_t length)
+{
+	reserve(dump, length);
+	memcpy(dump->table + dump->length, data, length);
+	dump->length += length;
+}
+
+static void put_word(unsigned char* p, unsigned int value)
+{
+	p[0] = value & 0xFF;
+	p[1] = (value >> 8) & 0xFF;
+}
+
+static void put_dword(unsigned char* p, unsigned int value)
+{
+	put_word(p, value & 0xFFFF);
+	put_word(p + 2, value >> 16);
+}
+
+void synthetic_dump_begin(struct synthetic_dump* dump)
+{
+	dump->table = NULL;
+	dump->length = 0;
+	dump->capacity = 0;
+}
+
+void synthetic_dump_add(struct synthetic_dump* dump, unsigned char type, unsigned short handle,
+	const unsigned char* formatted, size_t formattedLength, const char* const* strings, unsigned int stringCount)
+{
+	unsigned char header[4];
+
+	header[0] = type;
+	header[1] = (unsigned char)(formattedLength + 4);
+	put_word(header + 2, handle);
+
+	append(dump, header, sizeof(header));
+	append(dump, formatted, formattedLength);
+
+	for (unsigned int s = 0; s < stringCount; s++)
+	{
+		append(dump, strings[s], strlen(strings[s]) + 1);
+	}
+
+	// The string-set ends with a double NUL, an empty one is two NULs
+	append(dump, "\0", stringCount ? 1 : 2);
+}
+
+void synthetic_dump_add_machine(struct synthetic_dump* dump, unsigned int processors, unsigned int memoryDevices)
+{
+	static const char* const biosStrings[] = { "American Megatrends Inc.", "F.42", "03/14/2022" };
+	static const char* const systemStrings[] = { "Gigabyte", "Z390 AORUS", "1.0", "SN0001", "SKU", "Desktop" };
+	static const char* const boardStrings[] = { "Gigabyte", "Z390 AORUS PRO", "x.x", "BSN0001", "Default string", "Default string" };
+	static const char* const chassisStrings[] = { "Gigabyte", "1.0", "CSN0001", "Default string" };
+	static const char* const processorStrings[] = { "CPU0", "Intel(R) Corporation", "Intel(R) Core(TM) i9-9900K CPU @ 3.60GHz",
+		"To Be Filled By O.E.M.", "To Be Filled By O.E.M.", "To Be Filled By O.E.M." };
+	static const char* const cacheStrings[] = { "L1 Cache" };
+	static const char* const deviceStrings[] = { "DIMM 0", "BANK 0", "Samsung", "00000000", "Not Specified", "M378A2K43CB1-CTD" };
+	unsigned char formatted[0x60];
+	unsigned short handle = 0x0100;
+
+	memset(formatted, 0, sizeof(formatted));
+	formatted[0x00] = 1; // vendor
+	formatted[0x01] = 2; // version
+	put_word(formatted + 0x02, 0xF000);
+	formatted[0x04] = 3; // release date
+	formatted[0x05] = 0xFF; // 16 MB
+	put_dword(formatted + 0x06, 0x4BF99880);
+	formatted[0x0E] = 5;
+	formatted[0x0F] = 12;
+	synthetic_dump_add(dump, 0, 0x0000, formatted, 0x14, biosStrings, 3);
+
+	memset(formatted, 0, sizeof(formatted));
+	for (unsigned int s = 0; s < 4; s++)
+	{
+		formatted[s] = (unsigned char)(s + 1);
+	}
+	for (unsigned int b = 0; b < 16; b++)
+	{
+		formatted[0x04 + b] = (unsigned char)(b * 17);
+	}
+	formatted[0x14] = 6; // power switch
+	formatted[0x15] = 5;
+	formatted[0x16] = 6;
+	synthetic_dump_add(dump, 1, 0x0001, formatted, 0x17, systemStrings, 6);
+
+	memset(formatted, 0, sizeof(formatted));
+	for (unsigned int s = 0; s < 5; s++)
+	{
+		formatted[s] = (unsigned char)(s + 1);
+	}
+	formatted[0x05] = 0x09;
+	formatted[0x06] = 6;
+	put_word(formatted + 0x07, 0x0003);
+	formatted[0x09] = 0x0A;
+	synthetic_dump_add(dump, 2, 0x0002, formatted, 0x0B, boardStrings, 6);
+
+	memset(formatted, 0, sizeof(formatted));
+	formatted[0x00] = 1;
+	formatted[0x01] = 0x03; // desktop
+	formatted[0x02] = 2;
+	formatted[0x03] = 3;
+	formatted[0x04] = 4;
+	formatted[0x05] = 3;
+	formatted[0x06] = 3;
+	formatted[0x07] = 3;
+	formatted[0x08] = 3;
+	synthetic_dump_add(dump, 3, 0x0003, formatted, 0x11, chassisStrings, 4);
+
+	for (unsigned int p = 0; p < processors; p++)
+	{
+		unsigned short firstCache = handle;
+
+		memset(formatted, 0, sizeof(formatted));
+		formatted[0x00] = 1; // designation
+		put_word(formatted + 0x01, 0x0180); // enabled, level 1, internal
+		put_word(formatted + 0x03, 256); // KB
+		put_word(formatted + 0x05, 256);
+		put_word(formatted + 0x07, 0x0020);
+		put_word(formatted + 0x09, 0x0020);
+		formatted[0x0C] = 0x06; // single-bit ECC
+		formatted[0x0D] = 0x04; // data
+		formatted[0x0E] = 0x07; // 8-way
+		synthetic_dump_add(dump, 7, handle++, formatted, 0x0F, cacheStrings, 1);
+
+		memset(formatted, 0, sizeof(formatted));
+		formatted[0x00] = 1; // socket
+		formatted[0x01] = 0x03; // central processor
+		formatted[0x02] = 0xC6; // Core i7
+		formatted[0x03] = 2; // manufacturer
+		put_dword(formatted + 0x04, 0x000906EC);
+		put_dword(formatted + 0x08, 0xBFEBFBFF);
+		formatted[0x0C] = 3; // version
+		formatted[0x0D] = 0x8A; // 1.0 V
+		put_word(formatted + 0x0E, 100);
+		put_word(formatted + 0x10, 5000);
+		put_word(formatted + 0x12, 3600);
+		formatted[0x14] = 0x41;
+		formatted[0x15] = 0x0F;
+		put_word(formatted + 0x16, firstCache);
+		put_word(formatted + 0x18, 0xFFFF);
+		put_word(formatted + 0x1A, 0xFFFF);
+		formatted[0x1C] = 4;
+		formatted[0x1D] = 5;
+		formatted[0x1E] = 6;
+		formatted[0x1F] = 8;
+		formatted[0x20] = 8;
+		formatted[0x21] = 16;
+		put_word(formatted + 0x22, 0x00FC);
+		put_word(formatted + 0x24, 0x00C6);
+		synthetic_dump_add(dump, 4, handle++, formatted, 0x26, processorStrings, 6);
+	}
+
+	memset(formatted, 0, sizeof(formatted));
+	formatted[0x00] = 0x03; // system board
+	formatted[0x01] = 0x03; // system memory
+	formatted[0x02] = 0x03; // none
+	put_dword(formatted + 0x03, 0x04000000); // 64 GB
+	put_word(formatted + 0x07, 0xFFFE);
+	put_word(formatted + 0x09, (unsigned int)memoryDevices);
+	synthetic_dump_add(dump, 16, 0x1000, formatted, 0x0B, NULL, 0);
+
+	for (unsigned int d = 0; d < memoryDevices; d++)
+	{
+		memset(formatted, 0, sizeof(formatted));
+		put_word(formatted + 0x00, 0x1000);
+		put_word(formatted + 0x02, 0xFFFE);
+		put_word(formatted + 0x04, 64);
+		put_word(formatted + 0x06, 64);
+		put_word(formatted + 0x08, 16384); // MB
+		formatted[0x0A] = 0x09; // DIMM
+		formatted[0x0C] = 1;
+		formatted[0x0D] = 2;
+		formatted[0x0E] = 0x1A; // DDR4
+		put_word(formatted + 0x0F, 0x0080);
+		put_word(formatted + 0x11, 2666);
+		formatted[0x13] = 3;
+		formatted[0x14] = 4;
+		formatted[0x15] = 5;
+		formatted[0x16] = 6;
+		formatted[0x17] = 2;
+		put_word(formatted + 0x1C, 2666);
+		put_word(formatted + 0x1E, 1200);
+		put_word(formatted + 0x20, 1200);
+		put_word(formatted + 0x22, 1200);
+		synthetic_dump_add(dump, 17, (unsigned short)(0x1100 + d), formatted, 0x24, deviceStrings, 6);
+	}
+}
+
+int synthetic_dump_write(struct synthetic_dump* dump, const char* path)
+{
+	unsigned char entryPoint[32];
+	unsigned char checksum = 0;
+	FILE* stream;
+	int status = 0;
+
+	synthetic_dump_add(dump, 127, 0xFFFF, NULL, 0, NULL, 0);
+
+	memset(entryPoint, 0, sizeof(entryPoint));
+	memcpy(entryPoint, "_SM3_", 5);
+	entryPoint[0x06] = 0x18;
+	entryPoint[0x07] = 3;
+	entryPoint[0x08] = 3;
+	entryPoint[0x0A] = 1;
+	put_dword(entryPoint + 0x0C, (unsigned int)dump->length);
+	entryPoint[0x10] = 32;
+	for (unsigned int i = 0; i < 0x18; i++)
+	{
+		checksum += entryPoint[i];
+	}
+	entryPoint[0x05] = (unsigned char)(0x100 - checksum);
+
+	stream = fopen(path, "wb");
+	if (stream == NULL)
+	{
+		return -1;
+	}
+
+	if (fwrite(entryPoint, 1, sizeof(entryPoint), stream) != sizeof(entryPoint)
+		|| fwrite(dump->table, 1, dump->length, stream) != dump->length)
+	{
+		status = -1;
+	}
+
+	if (fclose(stream) != 0)
+	{
+		status = -1;
+	}
+
+	return status;
+}
+
+void synthetic_dump_release(struct synthetic_dump* dump)
+{
+	free(dump->table);
+	synthetic_dump_begin(dump);
+}
@@ -0,0 +1,52 @@
+/*
+ *   ----------------------------
+ *  |  synthdump.h
+ *   ----------------------------
+ *   This file is part of BiosReader.
+ *
+ *   BiosReader is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Affero General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   BiosReader is distributed in the hope and belief that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Affero General Public License
+ *   along with BiosReader.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+/*
+ * SMBIOS dumps made up on the spot, in the shape write_dump() gives them (an SMBIOS 3 entry point
+ * patched to 32, the table right after it), for the tests and benchmarks to decode with
+ * br_context_set_dump_file(). Out of memory is fatal, these are tests.
+ */
+struct synthetic_dump
+{
+	unsigned char* table;
+	size_t length;
+	size_t capacity;
+};
+
+void synthetic_dump_begin(struct synthetic_dump* dump);
+
+/*
+ * A structure: formatted is the formatted area past the 4 byte header (formattedLength bytes,
+ * so that the structure is formattedLength + 4 long), followed by the strings, in order
+ */
+void synthetic_dump_add(struct synthetic_dump* dump, unsigned char type, unsigned short handle,
+	const unsigned char* formatted, size_t formattedLength, const char* const* strings, unsigned int stringCount);
+
+// A machine of a kind: BIOS, system, baseboard, chassis, processors with their caches, a memory array and its devices
+void synthetic_dump_add_machine(struct synthetic_dump* dump, unsigned int processors, unsigned int memoryDevices);
+
+// Closes the table (end-of-table structure) and writes the dump. 0 on success
+int synthetic_dump_write(struct synthetic_dump* dump, const char* path);
+
+void synthetic_dump_release(struct synthetic_dump* dump);